@@ -9,8 +9,41 @@
  * - Extraction : key path, value name, data, timestamp, transaction ID
  * - Comparaison avant/après pour détecter modifications malveillantes
  * - Export CSV UTF-8 avec logging complet
+ * - Export Parquet (row groups avec statistiques min/max, dictionnaires, chunks encodés en parallèle)
+ * - Mode E/S directes (FILE_FLAG_NO_BUFFERING) avec file de lecture anticipée
+ * - Triage rapide par échantillonnage stratifié (totaux estimés + intervalle de confiance)
+ * - Requêtes à arrêt anticipé (N premières correspondances) sur fichier ou dossier de logs
+ * - Rareté sur la flotte (comptage de piles) : count-min sketch et HyperLogLog des n-uplets
+ *   clé/valeur/données par hôte, persistés (rarity.rtlr) et fusionnables (--merge-rarity)
+ * - Valeurs similaires : signature MinHash des données de valeur de chaque entrée,
+ *   index LSH par bandes sur la session active (configurations voisines, C2 différent)
+ * - Histogrammes d'activité par hive (par seconde et par minute) tenus à jour pendant le
+ *   parsing, détection de rafales de modifications (installations, rançongiciels, altérations)
+ * - Filtre interactif des résultats (termes combinés par & | !) : bitmaps compressés façon
+ *   Roaring par terme, raffinement à chaque frappe sur les seuls enregistrements déjà retenus
+ * - Diff de deux exports CSV par identité d'enregistrement (fichier, offset, séquence, hash)
+ * - Parsing distribué coordinateur/workers sur TCP (heartbeats, relance des jobs orphelins)
+ *   Worker : RegistryTransactionLogParser.exe --worker <hôte> <port>
+ * - Auto-contrôle différentiel du moteur contre un parcours de référence séquentiel
+ *   (logs synthétiques et altérés) : RegistryTransactionLogParser.exe --selfcheck [logs] [graine]
+ * - Banc d'essai sur logs corrompus à taux contrôlés (débit, entrées récupérées, blocages) :
+ *   RegistryTransactionLogParser.exe --torture [Mo] [graine] [rapport.csv]
+ * - Conservation des pages complètes dans un store mémoire compressé (LZ4, cache LRU)
+ * - Métriques mémoire par sous-système (allocateurs comptés, pic RSS échantillonné)
+ * - Resynchronisation rapide sur frontières de 512 octets dans les logs corrompus
+ * - Publication d'instantanés immuables des résultats (lecture sans verrou)
+ * - Espace de travail multi-sessions (pool de threads, entrées décodées, pages et index partagés)
+ * - Entrées compressées .gz/.zst décompressées en parallèle (BGZF, trames zstd via libzstd.dll)
+ * - Identité du hive (nom, type, profil) lue dans le base block, indépendante du nom de fichier
+ * - Décodage des emplacements de persistance (Run, services, IFEO, AppInit, Winlogon, tâches)
+ * - ShimCache (AppCompatCache Windows 7 à 11) reconstitué depuis les pages du log et le hive primaire
+ * - Énumération complète d'un hive primaire (toutes clés et valeurs, même modèle d'enregistrement) :
+ *   hbins répartis en plages sur le pool, arbre recousu par les offsets parents
+ * - Greffons de décodage en DLL (ABI C par lots en colonnes, RegistryTransactionLogParserPlugin.h)
+ * - Bibliothèque (RTLP_LIBRARY) : API C (RegistryTransactionLogParserApi.h), curseurs, sinks,
+ *   annulation, sessions enregistrées, colonnes exportées sans copie (Arrow), liaisons python/rtlp.py
  *
- * APIs : File I/O, advapi32.lib, comctl32.lib
+ * APIs : File I/O, Winsock, advapi32.lib, comctl32.lib
  * Auteur : WinToolsSuite
  * License : MIT
  */
@@ -20,22 +53,45 @@
 #define _UNICODE
 #define NOMINMAX
 
+#include <winsock2.h>
+#include <ws2tcpip.h>
 #include <windows.h>
 #include <commctrl.h>
 #include <commdlg.h>
 #include <shlwapi.h>
+#include <shellapi.h>
+#include <psapi.h>
 #include <vector>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <array>
 #include <memory>
+#include <deque>
+#include <functional>
 #include <ctime>
 #include <iomanip>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <iterator>
+#include <random>
+#include <cmath>
+#include <atomic>
+#include <exception>
+#include <cwctype>
+
+#include "RegistryTransactionLogParserPlugin.h"
+#ifdef RTLP_LIBRARY
+#include "RegistryTransactionLogParserApi.h"
+#endif
 
 #pragma comment(lib, "comctl32.lib")
 #pragma comment(lib, "shlwapi.lib")
 #pragma comment(lib, "advapi32.lib")
+#pragma comment(lib, "ws2_32.lib")
+#pragma comment(lib, "psapi.lib")
 #pragma comment(linker,"\"/manifestdependency:type='win32' name='Microsoft.Windows.Common-Controls' version='6.0.0.0' processorArchitecture='*' publicKeyToken='6595b64144ccf1df' language='*'\"")
 
 // Constantes UI
@@ -54,6 +110,173 @@ constexpr int IDC_BTN_EXPORT = 1005;
 constexpr int IDC_STATUS = 1006;
 constexpr int IDC_EDIT_PATH = 1007;
 constexpr int IDC_BTN_BROWSE = 1008;
+constexpr int IDC_CHK_DIRECTIO = 1009;
+constexpr int IDC_BTN_SAMPLE = 1010;
+constexpr int IDC_EDIT_QUERY = 1011;
+constexpr int IDC_EDIT_MAXMATCH = 1012;
+constexpr int IDC_CHK_STOPBATCH = 1013;
+constexpr int IDC_BTN_DIFF = 1014;
+constexpr int IDC_BTN_DISTRIBUTE = 1015;
+constexpr int IDC_CHK_KEEPPAGES = 1016;
+constexpr int IDC_COMBO_SESSION = 1017;
+constexpr int IDC_BTN_ADDSESSION = 1018;
+constexpr int IDC_BTN_SIMILAR = 1019;
+constexpr int IDC_EDIT_FILTER = 1020;
+
+// Constantes E/S directes
+constexpr DWORD DIRECT_IO_CHUNK_SIZE = 1024 * 1024;  // Taille d'une requête de lecture
+constexpr int DIRECT_IO_QUEUE_DEPTH = 4;              // Lectures anticipées en vol
+constexpr DWORD DEFAULT_SECTOR_SIZE = 4096;
+
+// Constantes échantillonnage (triage rapide)
+constexpr DWORD MAX_ENTRY_SIZE = 65536;               // Taille max acceptée pour une entrée
+constexpr int SAMPLE_STRATA = 64;                     // Régions du fichier
+constexpr int SAMPLE_WINDOWS_PER_STRATUM = 2;         // Fenêtres tirées par région
+constexpr DWORD SAMPLE_WINDOW_SIZE = 64 * 1024;
+constexpr DWORD SAMPLE_ALIGNMENT = 512;
+constexpr size_t SAMPLE_TOP_PATHS = 10;
+constexpr double SAMPLE_Z_95 = 1.96;
+
+// Constantes resynchronisation
+constexpr DWORD ENTRY_ALIGNMENT = 512;                // Les entrées HvLE débutent sur ces frontières
+constexpr size_t RESYNC_REPORT_RANGES = 10;           // Plages ignorées détaillées dans le log
+
+// Constantes parsing parallèle
+constexpr size_t MIN_PARTITION_SIZE = 1024 * 1024;    // En dessous, pas de découpage
+constexpr size_t MAX_SCAN_PARTITIONS = 64;            // Limite de WaitForMultipleObjects
+
+// Constantes mode distribué
+constexpr USHORT DIST_DEFAULT_PORT = 47020;
+constexpr DWORD DIST_HEARTBEAT_INTERVAL_MS = 1000;
+constexpr DWORD DIST_HEARTBEAT_TIMEOUT_MS = 5000;     // Au-delà, le worker est déclaré mort
+constexpr DWORD DIST_IDLE_TIMEOUT_MS = 30000;         // Aucun worker connecté
+constexpr int DIST_MAX_ATTEMPTS = 3;                  // Tentatives par job
+constexpr size_t DIST_RESULT_BATCH = 256;             // Enregistrements par trame
+constexpr DWORD DIST_MAX_FRAME_SIZE = 64 * 1024 * 1024;
+constexpr int DIST_MAX_LOCAL_WORKERS = 16;
+
+// Constantes store de pages compressé
+constexpr DWORD PAGE_STORE_BLOCK_SIZE = 256 * 1024;   // Unité de compression
+constexpr size_t PAGE_STORE_HOT_BLOCKS = 8;           // Blocs décompressés gardés en cache
+constexpr ULONGLONG PAGE_NONE = ~0ULL;
+
+// Constantes espace de travail
+constexpr size_t INTERN_POOL_SHARDS = 16;             // Verrous indépendants du pool d'entrées décodées
+constexpr size_t INTERN_POOL_MAX_ENTRIES = 1 << 20;   // Au-delà, les nouvelles entrées ne sont plus retenues
+
+// Constantes entrées compressées
+constexpr ULONGLONG DECOMPRESS_MAX_SIZE = 4ULL * 1024 * 1024 * 1024;
+constexpr size_t DECOMPRESS_TASK_SIZE = 4 * 1024 * 1024;  // Sortie visée par tâche du pool
+constexpr size_t GZIP_MIN_MEMBER = 18;                     // En-tête (10) + flux vide (2) + pied (8) - 2
+constexpr size_t BGZF_MAX_BLOCK = 65536;                   // Sortie maximale d'un bloc BGZF
+constexpr BYTE GZIP_FHCRC = 0x02;
+constexpr BYTE GZIP_FEXTRA = 0x04;
+constexpr BYTE GZIP_FNAME = 0x08;
+constexpr BYTE GZIP_FCOMMENT = 0x10;
+constexpr DWORD ZSTD_MAGIC = 0xFD2FB528;
+constexpr ULONGLONG ZSTD_CONTENTSIZE_UNKNOWN = ~0ULL;
+constexpr ULONGLONG ZSTD_CONTENTSIZE_ERROR = ~0ULL - 1;
+constexpr unsigned ZSTD_ERROR_DST_SIZE_TOO_SMALL = 70;     // ZSTD_error_dstSize_tooSmall
+
+// Constantes artefacts de persistance
+constexpr size_t VK_FIXED_SIZE = 20;                  // Cellule "vk" hors taille et nom
+constexpr WORD VK_FLAG_ASCII_NAME = 0x0001;
+constexpr ULONGLONG HBIN_BASE_OFFSET = 4096;          // Début des hbins dans le hive primaire
+constexpr size_t BIG_DATA_SEGMENT_SIZE = 16344;       // Données par segment d'une cellule "db"
+constexpr size_t HIVE_MAX_CELL_SIZE = 1024 * 1024;
+
+// Constantes ShimCache (AppCompatCache)
+constexpr DWORD SHIMCACHE_WIN7_MAGIC = 0xBADC0FEE;
+constexpr size_t SHIMCACHE_WIN7_HEADER = 0x80;
+constexpr DWORD SHIMCACHE_WIN8_HEADER = 0x80;
+constexpr DWORD SHIMCACHE_WIN10_HEADER = 0x30;
+constexpr DWORD SHIMCACHE_WIN10_CREATORS_HEADER = 0x34;
+constexpr DWORD SHIMCACHE_SIG_WIN8 = 0x73743030;      // "00ts"
+constexpr DWORD SHIMCACHE_SIG_WIN81 = 0x73743031;     // "10ts" (8.1, 10, 11)
+constexpr DWORD SHIMCACHE_MAX_ENTRIES = 65536;
+constexpr DWORD SHIMCACHE_FLAG_EXECUTED = 0x00000002; // Drapeau d'insertion 7/8
+
+// Constantes greffons
+constexpr size_t PLUGIN_BATCH_ROWS = 4096;            // Lignes par appel de greffon
+
+// Constantes bibliothèque
+constexpr size_t SINK_BATCH_RECORDS = 256;            // Enregistrements par appel de sink
+
+// Constantes sessions enregistrées
+constexpr DWORD SESSION_FILE_MAGIC = 0x534C5452;      // "RTLS"
+constexpr DWORD SESSION_FILE_VERSION = 2;                // 2 : signatures MinHash
+constexpr DWORD SESSION_FILE_BLOCK = 4096;            // Enregistrements par bloc
+
+// Constantes export Parquet
+constexpr char PARQUET_MAGIC[] = "PAR1";
+constexpr ULONGLONG PARQUET_ROW_GROUP_BYTES = 128 * 1024 * 1024;  // Volume visé par row group (avant encodage)
+constexpr size_t PARQUET_PAGE_ROWS = 64 * 1024;                   // Lignes par page de données
+constexpr size_t PARQUET_MAX_DICTIONARY_BYTES = 1024 * 1024;      // Au-delà, le chunk repasse en PLAIN
+constexpr size_t PARQUET_MAX_STAT_BYTES = 256;                    // min/max plus longs non publiés
+
+// Constantes rareté (comptage de piles sur la flotte)
+constexpr DWORD RARITY_FILE_MAGIC = 0x524C5452;             // "RTLR"
+constexpr DWORD RARITY_FILE_VERSION = 2;                  // 2 : hives comptés par hôte
+constexpr size_t RARITY_CMS_WIDTH = 1 << 20;                // Compteurs par ligne du count-min sketch
+constexpr size_t RARITY_CMS_DEPTH = 4;
+constexpr DWORD RARITY_HLL_PRECISION = 14;                  // 2^14 registres, erreur type ~0,8 %
+
+// Constantes similarité (MinHash, LSH)
+constexpr size_t SIMILARITY_SLOTS = 64;                     // Minima de 16 bits par signature
+constexpr int SIMILARITY_SLOT_BITS = 6;                     // log2(SIMILARITY_SLOTS)
+constexpr size_t SIMILARITY_SHINGLE = sizeof(ULONGLONG);    // Fragments de 8 octets (4 caractères UTF-16)
+constexpr size_t SIMILARITY_MIN_SHINGLES = 8;               // En dessous, pas de signature
+constexpr size_t SIMILARITY_BANDS = 16;                     // Bandes LSH de SIMILARITY_ROWS slots
+constexpr size_t SIMILARITY_ROWS = SIMILARITY_SLOTS / SIMILARITY_BANDS;
+constexpr double SIMILARITY_DEFAULT_THRESHOLD = 0.5;        // Jaccard estimé minimal
+constexpr size_t SIMILARITY_SHOWN_MATCHES = 20;             // Correspondances affichées dans l'interface
+
+// Constantes histogrammes d'activité et détection de rafales
+constexpr int64_t ACTIVITY_MINUTE = 60;
+constexpr double BURST_EWMA_ALPHA = 0.05;                   // Lissage de la base (enregistrements par seconde)
+constexpr double BURST_SIGMAS = 4.0;                        // Écarts-types au-dessus de la base
+constexpr DWORD BURST_MIN_RECORDS = 50;                     // Par seconde, en dessous jamais une rafale
+constexpr size_t BURST_WARMUP_SECONDS = 30;                 // Secondes actives avant toute détection
+constexpr int64_t BURST_MERGE_GAP = 5;                      // Secondes séparant deux rafales fusionnées
+constexpr int64_t BURST_DECAY_LIMIT = 600;                  // Au-delà d'un tel silence, la base retombe à zéro
+constexpr size_t BURST_REPORTED = 10;                       // Rafales détaillées dans le log
+
+// Constantes filtrage interactif (bitmaps compressés)
+constexpr size_t ROARING_BLOCK = 65536;                     // Indices par bloc (16 bits de poids faible)
+constexpr size_t ROARING_ARRAY_MAX = 4096;                  // Au-delà, un bloc passe en bitset de 8 Ko
+constexpr size_t ROARING_BITSET_WORDS = ROARING_BLOCK / 64;
+constexpr size_t FILTER_CACHE_TERMS = 32;                   // Termes gardés pour les raffinements
+
+// Constantes énumération de hive primaire
+constexpr DWORD HBIN_SIGNATURE = 0x6E696268;                // "hbin"
+constexpr size_t HBIN_HEADER_SIZE = 32;
+constexpr size_t HBIN_ALIGNMENT = 4096;                     // Taille et position des hbins
+constexpr size_t NK_FIXED_SIZE = 0x4C;                      // Cellule "nk" hors taille et nom
+constexpr WORD NK_FLAG_HIVE_ENTRY = 0x0004;                 // Clé racine
+constexpr WORD NK_FLAG_ASCII_NAME = 0x0020;
+constexpr size_t HIVE_MAX_KEY_DEPTH = 512;                  // Profondeur maximale d'une clé (Windows)
+constexpr size_t HIVE_TASKS_PER_THREAD = 4;                 // Plages de hbins par thread (équilibrage)
+constexpr size_t HIVE_KEYS_PER_TASK = 4096;                 // Clés par tâche de production des enregistrements
+constexpr size_t HIVE_VALUE_TEXT_MAX = 1024;                // Caractères d'une chaîne repris dans dataAfter
+
+// Constantes auto-contrôle différentiel
+constexpr size_t SELFCHECK_DEFAULT_ITERATIONS = 20;
+constexpr size_t SELFCHECK_MIN_SIZE = 256 * 1024;
+constexpr size_t SELFCHECK_MAX_SIZE = 6 * 1024 * 1024;      // Plusieurs partitions de parsing
+constexpr size_t SELFCHECK_REPORT_MISMATCHES = 10;          // Écarts détaillés dans le log
+
+// Constantes banc d'essai logs corrompus
+constexpr size_t TORTURE_DEFAULT_SIZE_MB = 64;              // Volume généré par scénario
+constexpr size_t TORTURE_FILES = 4;                         // Logs par scénario
+
+// Constantes instrumentation
+constexpr DWORD RSS_SAMPLE_INTERVAL_MS = 50;
+
+// Signature MinHash des données de valeur d'un enregistrement (MinHash)
+struct MinHashSignature {
+    std::array<WORD, SIMILARITY_SLOTS> slots;
+    bool valid = false;
+};
 
 // Structures Registry Transaction Log (simplifiées)
 #pragma pack(push, 1)
@@ -68,7 +291,9 @@ struct REGF_HEADER {
     DWORD format;
     DWORD rootCellOffset;
     DWORD hiveSize;
-    BYTE reserved[476];
+    DWORD clusteringFactor;
+    WCHAR fileName[32];   // Fin du chemin du hive (UTF-16, 31 caractères + 0)
+    BYTE reserved[396];
     DWORD checksum;
 };
 
@@ -81,6 +306,8 @@ struct LOG_ENTRY_HEADER {
 };
 #pragma pack(pop)
 
+static_assert(sizeof(REGF_HEADER) == 512, "Le base block regf fait 512 octets");
+
 // Structure pour une transaction
 struct TransactionEntry {
     std::wstring timestamp;
@@ -91,6 +318,242 @@ struct TransactionEntry {
     std::wstring dataAfter;
     std::wstring txID;
     DWORD offset;
+
+    // Identité de l'enregistrement (diff entre deux exécutions)
+    std::wstring logFile;       // Nom du fichier LOG source
+    size_t fileOffset;          // Position de l'entrée dans le fichier LOG
+    DWORD sequence;
+    ULONGLONG contentHash;      // FNV-1a 64 des octets de l'entrée
+
+    ULONGLONG pageId;           // Page complète dans le store compressé (PAGE_NONE sinon)
+
+    // Artefact de persistance reconnu par un décodeur dédié (vide sinon)
+    std::wstring artifact;
+    std::wstring details;
+
+    std::vector<std::wstring> derived;  // Colonnes dérivées des greffons (PluginHost)
+
+    // Rareté sur la flotte (RarityModel) : hôtes portant le même n-uplet clé/valeur/données
+    // parmi fleetHosts hôtes comptés ; 0/0 tant que l'enregistrement n'est pas noté
+    DWORD prevalence = 0;
+    DWORD fleetHosts = 0;
+
+    MinHashSignature signature;         // Recherche de valeurs similaires (SimilarityIndex)
+};
+
+// FNV-1a 64 bits (identité et empreinte des enregistrements)
+constexpr ULONGLONG FNV_OFFSET_BASIS = 0xCBF29CE484222325ULL;
+constexpr ULONGLONG FNV_PRIME = 0x100000001B3ULL;
+
+inline ULONGLONG Fnv1a64(const void* data, size_t len, ULONGLONG hash = FNV_OFFSET_BASIS) {
+    const BYTE* p = static_cast<const BYTE*>(data);
+    for (size_t i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+inline ULONGLONG Fnv1a64(const std::wstring& text, ULONGLONG hash = FNV_OFFSET_BASIS) {
+    return Fnv1a64(text.data(), text.size() * sizeof(wchar_t), hash);
+}
+
+// Les entrées de log n'ont pas d'heure propre : leur Timestamp est l'heure de
+// décodage suivie de LOG_SEQUENCE_TAG, de la séquence et d'une parenthèse
+constexpr wchar_t LOG_SEQUENCE_TAG[] = L" (Seq: ";
+
+// LOG_SEQUENCE_TAG présent dans un Timestamp UTF-8 ou UTF-16
+template<typename Char>
+bool HasLogSequenceTag(const Char* text, size_t size) {
+    const size_t tagLength = sizeof(LOG_SEQUENCE_TAG) / sizeof(LOG_SEQUENCE_TAG[0]) - 1;
+    for (size_t at = 0; at + tagLength <= size; at++) {
+        size_t i = 0;
+        while (i < tagLength && static_cast<wchar_t>(text[at + i]) == LOG_SEQUENCE_TAG[i]) i++;
+        if (i == tagLength) return true;
+    }
+    return false;
+}
+
+// Colonne Timestamp "JJ/MM/AAAA hh:mm:ss" (UTC) en secondes depuis 1970 ; texte
+// UTF-8 ou UTF-16. L'heure de décodage d'une entrée de log (LOG_SEQUENCE_TAG)
+// n'est pas une heure d'événement : refusée.
+template<typename Char>
+bool ParseEventTime(const Char* text, size_t size, int64_t& seconds) {
+    if (HasLogSequenceTag(text, size)) return false;
+    if (size < 19 || text[2] != '/' || text[5] != '/' || text[10] != ' ' || text[13] != ':' || text[16] != ':') {
+        return false;
+    }
+    auto number = [text](size_t at, size_t digits, int& value) {
+        value = 0;
+        for (size_t i = at; i < at + digits; i++) {
+            if (text[i] < '0' || text[i] > '9') return false;
+            value = value * 10 + static_cast<int>(text[i] - '0');
+        }
+        return true;
+    };
+    int day, month, year, hour, minute, second;
+    if (!number(0, 2, day) || !number(3, 2, month) || !number(6, 4, year) || !number(11, 2, hour) ||
+        !number(14, 2, minute) || !number(17, 2, second) || month < 1 || month > 12 || day < 1) {
+        return false;
+    }
+
+    // Jours depuis 1970 (calendrier grégorien proleptique)
+    const int64_t y = year - (month <= 2 ? 1 : 0);
+    const int64_t era = y / 400;
+    const int64_t yearOfEra = y - era * 400;
+    const int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    const int64_t days = era * 146097 + dayOfEra - 719468;
+    seconds = ((days * 24 + hour) * 60 + minute) * 60 + second;
+    return true;
+}
+
+// Champ CSV entre guillemets (les guillemets internes sont doublés)
+inline std::wstring CsvQuote(const std::wstring& field) {
+    std::wstring out = L"\"";
+    for (wchar_t c : field) {
+        if (c == L'"') out += L'"';
+        out += c;
+    }
+    out += L'"';
+    return out;
+}
+
+// Sous-chaîne (déjà en minuscules) présente, sans tenir compte de la casse, dans
+// la clé, la valeur, les données ou l'artefact (requête et filtre interactif)
+inline bool RecordContains(const TransactionEntry& tx, const std::wstring& lowered) {
+    auto contains = [&lowered](const std::wstring& field) {
+        return std::search(field.begin(), field.end(), lowered.begin(), lowered.end(),
+                           [](wchar_t a, wchar_t b) { return static_cast<wchar_t>(std::towlower(a)) == b; }) != field.end();
+    };
+    return contains(tx.keyPath) || contains(tx.valueName) || contains(tx.dataAfter) ||
+           contains(tx.artifact) || contains(tx.details);
+}
+
+// Instrumentation mémoire : chaque sous-système a ses compteurs (octets vivants,
+// pic, nombre d'allocations depuis le début de la mesure).
+enum MemSubsystem {
+    MEM_IO_BUFFERS,     // Buffers de lecture des LOG
+    MEM_RECORDS,        // Vecteurs d'enregistrements
+    MEM_STRINGS,        // Chaînes des enregistrements (mesurées par parcours)
+    MEM_INDEXES,        // Cache d'échantillon, spans de partition
+    MEM_PAGES,          // Store de pages compressé
+    MEM_SUBSYSTEM_COUNT
+};
+
+struct MemCounter {
+    std::atomic<LONGLONG> bytes;
+    std::atomic<LONGLONG> peakBytes;
+    std::atomic<ULONGLONG> allocations;
+
+    MemCounter() : bytes(0), peakBytes(0), allocations(0) {}
+
+    void OnAlloc(size_t n) {
+        allocations++;
+        const LONGLONG now = bytes += static_cast<LONGLONG>(n);
+        LONGLONG peak = peakBytes.load();
+        while (now > peak && !peakBytes.compare_exchange_weak(peak, now)) {}
+    }
+    void OnFree(size_t n) { bytes -= static_cast<LONGLONG>(n); }
+
+    // Début d'une mesure : le pic repart des octets vivants
+    void Reset() {
+        allocations = 0;
+        peakBytes = bytes.load();
+    }
+};
+
+inline MemCounter* MemCounters() {
+    static MemCounter counters[MEM_SUBSYSTEM_COUNT];
+    return counters;
+}
+
+inline const wchar_t* MemSubsystemName(int subsystem) {
+    static const wchar_t* names[MEM_SUBSYSTEM_COUNT] = { L"Buffers E/S", L"Enregistrements", L"Chaînes", L"Index", L"Pages" };
+    return names[subsystem];
+}
+
+// Allocateur STL comptant les allocations d'un sous-système
+template<typename T, MemSubsystem S>
+struct CountingAllocator {
+    using value_type = T;
+    template<typename U> struct rebind { using other = CountingAllocator<U, S>; };
+
+    CountingAllocator() noexcept {}
+    template<typename U> CountingAllocator(const CountingAllocator<U, S>&) noexcept {}
+
+    T* allocate(size_t n) {
+        T* p = static_cast<T*>(::operator new(n * sizeof(T)));
+        MemCounters()[S].OnAlloc(n * sizeof(T));
+        return p;
+    }
+    void deallocate(T* p, size_t n) noexcept {
+        MemCounters()[S].OnFree(n * sizeof(T));
+        ::operator delete(p);
+    }
+};
+
+template<typename T, typename U, MemSubsystem S>
+bool operator==(const CountingAllocator<T, S>&, const CountingAllocator<U, S>&) { return true; }
+template<typename T, typename U, MemSubsystem S>
+bool operator!=(const CountingAllocator<T, S>&, const CountingAllocator<U, S>&) { return false; }
+
+using RecordVector = std::vector<TransactionEntry, CountingAllocator<TransactionEntry, MEM_RECORDS>>;
+using PageBytes = std::vector<BYTE, CountingAllocator<BYTE, MEM_PAGES>>;
+using ByteRange = std::pair<size_t, size_t>;          // [début, fin)
+using ByteRanges = std::vector<ByteRange, CountingAllocator<ByteRange, MEM_INDEXES>>;
+
+// Échantillonnage du working set pendant un parsing (pic RSS)
+class RssSampler {
+    HANDLE hThread;
+    HANDLE hStop;
+    std::atomic<SIZE_T> peak;
+
+    static SIZE_T CurrentRss() {
+        PROCESS_MEMORY_COUNTERS pmc = {};
+        pmc.cb = sizeof(pmc);
+        return GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)) ? pmc.WorkingSetSize : 0;
+    }
+
+    void Sample() {
+        const SIZE_T now = CurrentRss();
+        SIZE_T prev = peak.load();
+        while (now > prev && !peak.compare_exchange_weak(prev, now)) {}
+    }
+
+    static DWORD WINAPI SamplerThreadProc(LPVOID param) {
+        auto* self = static_cast<RssSampler*>(param);
+        while (WaitForSingleObject(self->hStop, RSS_SAMPLE_INTERVAL_MS) == WAIT_TIMEOUT) {
+            self->Sample();
+        }
+        return 0;
+    }
+
+public:
+    RssSampler() : hThread(nullptr), hStop(nullptr), peak(0) {}
+    ~RssSampler() { Stop(); }
+
+    void Start() {
+        Stop();
+        peak = CurrentRss();
+        hStop = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (hStop) hThread = CreateThread(nullptr, 0, SamplerThreadProc, this, 0, nullptr);
+    }
+
+    SIZE_T Stop() {
+        if (hThread) {
+            SetEvent(hStop);
+            WaitForSingleObject(hThread, INFINITE);
+            CloseHandle(hThread);
+            hThread = nullptr;
+        }
+        if (hStop) {
+            CloseHandle(hStop);
+            hStop = nullptr;
+        }
+        Sample();
+        return peak;
+    }
 };
 
 // RAII pour fichier
@@ -103,197 +566,7538 @@ public:
     bool valid() const { return h != INVALID_HANDLE_VALUE; }
 };
 
-// Classe principale
-class RegistryTransactionLogParser {
-private:
-    HWND hwndMain, hwndList, hwndStatus, hwndEditPath;
-    std::vector<TransactionEntry> transactions;
-    std::wstring currentLogPath;
-    std::wofstream logFile;
-    HANDLE hWorkerThread;
-    volatile bool stopProcessing;
+// Buffer aligné sur la page (requis par FILE_FLAG_NO_BUFFERING)
+class AlignedBuffer {
+    BYTE* p;
+    size_t capacity;
+public:
+    AlignedBuffer() : p(nullptr), capacity(0) {}
+    ~AlignedBuffer() { reset(); }
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
 
-    void Log(const std::wstring& message) {
-        if (logFile.is_open()) {
-            SYSTEMTIME st;
-            GetLocalTime(&st);
-            wchar_t timeStr[64];
-            swprintf_s(timeStr, L"[%02d/%02d/%04d %02d:%02d:%02d] ",
-                      st.wDay, st.wMonth, st.wYear, st.wHour, st.wMinute, st.wSecond);
-            logFile << timeStr << message << std::endl;
-            logFile.flush();
+    bool allocate(size_t size) {
+        reset();
+        p = static_cast<BYTE*>(VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+        capacity = p ? size : 0;
+        if (p) MemCounters()[MEM_IO_BUFFERS].OnAlloc(capacity);
+        return p != nullptr;
+    }
+    void reset() {
+        if (p) {
+            VirtualFree(p, 0, MEM_RELEASE);
+            MemCounters()[MEM_IO_BUFFERS].OnFree(capacity);
         }
+        p = nullptr;
+        capacity = 0;
     }
+    BYTE* data() const { return p; }
+    size_t size() const { return capacity; }
 
-    void UpdateStatus(const std::wstring& text) {
-        SetWindowTextW(hwndStatus, text.c_str());
-        Log(text);
+    void swap(AlignedBuffer& other) {
+        std::swap(p, other.p);
+        std::swap(capacity, other.capacity);
     }
+};
 
-    std::wstring FileTimeToString(FILETIME ft) {
-        SYSTEMTIME st;
-        if (FileTimeToSystemTime(&ft, &st)) {
-            wchar_t buf[128];
-            swprintf_s(buf, L"%02d/%02d/%04d %02d:%02d:%02d",
-                      st.wDay, st.wMonth, st.wYear, st.wHour, st.wMinute, st.wSecond);
-            return buf;
+// Lecture complète d'un fichier LOG, bufferisée ou en E/S directes.
+// En mode direct, le cache système n'est pas sollicité : les lectures sont
+// alignées sur le secteur et DIRECT_IO_QUEUE_DEPTH requêtes restent en vol.
+class LogFileReader {
+    static DWORD QuerySectorSize(const std::wstring& path) {
+        wchar_t volume[MAX_PATH] = {};
+        DWORD sectorsPerCluster = 0, bytesPerSector = 0, freeClusters = 0, totalClusters = 0;
+        if (GetVolumePathNameW(path.c_str(), volume, MAX_PATH) &&
+            GetDiskFreeSpaceW(volume, &sectorsPerCluster, &bytesPerSector, &freeClusters, &totalClusters) &&
+            bytesPerSector != 0 && DIRECT_IO_CHUNK_SIZE % bytesPerSector == 0) {
+            return bytesPerSector;
         }
-        return L"N/A";
+        return DEFAULT_SECTOR_SIZE;
     }
 
-    std::wstring DwordToHex(DWORD value) {
-        wchar_t buf[32];
-        swprintf_s(buf, L"0x%08X", value);
-        return buf;
-    }
+    static bool ReadBuffered(const std::wstring& path, AlignedBuffer& buffer, size_t& fileSize, std::wstring& error) {
+        FileHandle hFile(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                     nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr));
+        if (!hFile.valid()) {
+            error = L"Erreur : Impossible d'ouvrir le fichier LOG";
+            return false;
+        }
 
-    std::wstring BytesToHex(const BYTE* data, size_t len) {
-        if (len > 64) len = 64; // Limite pour affichage
-        std::wstringstream ss;
-        for (size_t i = 0; i < len; i++) {
-            wchar_t buf[4];
-            swprintf_s(buf, L"%02X", data[i]);
-            ss << buf;
-            if (i < len - 1) ss << L" ";
+        LARGE_INTEGER size = {};
+        if (!GetFileSizeEx(hFile, &size) || size.QuadPart == 0 || size.QuadPart > 0xFFFFFFFFLL) {
+            error = L"Erreur : Fichier LOG vide ou invalide";
+            return false;
         }
-        return ss.str();
-    }
+        fileSize = static_cast<size_t>(size.QuadPart);
 
-    bool ParseLogFile(const std::wstring& path) {
-        FileHandle hFile(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
-                                     nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+        if (!buffer.allocate(fileSize)) {
+            error = L"Erreur : Mémoire insuffisante pour le fichier LOG";
+            return false;
+        }
+
+        DWORD bytesRead = 0;
+        if (!ReadFile(hFile, buffer.data(), static_cast<DWORD>(fileSize), &bytesRead, nullptr) || bytesRead != fileSize) {
+            error = L"Erreur : Lecture du fichier LOG échouée";
+            return false;
+        }
+        return true;
+    }
 
+    static bool ReadDirect(const std::wstring& path, AlignedBuffer& buffer, size_t& fileSize, std::wstring& error) {
+        FileHandle hFile(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                     FILE_FLAG_NO_BUFFERING | FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, nullptr));
         if (!hFile.valid()) {
-            UpdateStatus(L"Erreur : Impossible d'ouvrir le fichier LOG");
+            error = L"Erreur : Impossible d'ouvrir le fichier LOG (E/S directes)";
             return false;
         }
 
-        DWORD fileSize = GetFileSize(hFile, nullptr);
-        if (fileSize == 0 || fileSize == INVALID_FILE_SIZE) {
-            UpdateStatus(L"Erreur : Fichier LOG vide ou invalide");
+        LARGE_INTEGER size = {};
+        if (!GetFileSizeEx(hFile, &size) || size.QuadPart == 0 || size.QuadPart > 0xFFFFFFFFLL) {
+            error = L"Erreur : Fichier LOG vide ou invalide";
             return false;
         }
+        fileSize = static_cast<size_t>(size.QuadPart);
 
-        std::vector<BYTE> buffer(fileSize);
-        DWORD bytesRead = 0;
-        if (!ReadFile(hFile, buffer.data(), fileSize, &bytesRead, nullptr)) {
-            UpdateStatus(L"Erreur : Lecture du fichier LOG échouée");
+        // Le buffer couvre un nombre entier de blocs : la dernière lecture
+        // dépasse la fin du fichier mais reste alignée sur le secteur.
+        const DWORD sectorSize = QuerySectorSize(path);
+        const size_t chunkCount = (fileSize + DIRECT_IO_CHUNK_SIZE - 1) / DIRECT_IO_CHUNK_SIZE;
+        if (!buffer.allocate(chunkCount * DIRECT_IO_CHUNK_SIZE)) {
+            error = L"Erreur : Mémoire insuffisante pour le fichier LOG";
             return false;
         }
 
-        // Parse header (si format REGF header existe dans les logs)
-        if (fileSize < sizeof(REGF_HEADER)) {
-            UpdateStatus(L"Attention : Fichier trop petit pour contenir un header complet");
+        struct PendingRead {
+            OVERLAPPED ov;
+            size_t chunk;
+            bool active;
+        };
+        PendingRead queue[DIRECT_IO_QUEUE_DEPTH] = {};
+        for (auto& slot : queue) {
+            slot.ov.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+            if (!slot.ov.hEvent) {
+                for (auto& s : queue) if (s.ov.hEvent) CloseHandle(s.ov.hEvent);
+                error = L"Erreur : Création des événements de lecture échouée";
+                return false;
+            }
         }
 
-        // Extraction du nom du hive depuis le chemin
-        std::wstring hiveName = PathFindFileNameW(path.c_str());
-        if (hiveName.size() > 4 && hiveName.substr(hiveName.size() - 4) == L".LOG") {
-            hiveName = hiveName.substr(0, hiveName.size() - 4);
-        } else if (hiveName.size() > 5 && hiveName.substr(hiveName.size() - 5) == L".LOG1") {
-            hiveName = hiveName.substr(0, hiveName.size() - 5);
-        } else if (hiveName.size() > 5 && hiveName.substr(hiveName.size() - 5) == L".LOG2") {
-            hiveName = hiveName.substr(0, hiveName.size() - 5);
+        auto issue = [&](PendingRead& slot, size_t chunk) -> bool {
+            const ULONGLONG chunkOffset = static_cast<ULONGLONG>(chunk) * DIRECT_IO_CHUNK_SIZE;
+            const size_t remaining = fileSize - static_cast<size_t>(chunkOffset);
+            size_t request = std::min<size_t>(remaining, DIRECT_IO_CHUNK_SIZE);
+            request = (request + sectorSize - 1) / sectorSize * sectorSize;
+
+            ResetEvent(slot.ov.hEvent);
+            slot.ov.Offset = static_cast<DWORD>(chunkOffset & 0xFFFFFFFF);
+            slot.ov.OffsetHigh = static_cast<DWORD>(chunkOffset >> 32);
+            slot.chunk = chunk;
+            slot.active = true;
+            if (!ReadFile(hFile, buffer.data() + chunkOffset, static_cast<DWORD>(request), nullptr, &slot.ov) &&
+                GetLastError() != ERROR_IO_PENDING) {
+                slot.active = false;
+                return GetLastError() == ERROR_HANDLE_EOF;
+            }
+            return true;
+        };
+
+        // Amorçage de la file, puis recyclage du slot le plus ancien
+        bool ok = true;
+        size_t nextChunk = 0;
+        for (int i = 0; i < DIRECT_IO_QUEUE_DEPTH && nextChunk < chunkCount && ok; i++) {
+            ok = issue(queue[i], nextChunk++);
         }
 
-        // Parse des dirty pages et transactions
-        // Format simplifié : recherche de patterns caractéristiques
-        size_t offset = 0;
-        DWORD txCounter = 0;
-
-        while (offset + sizeof(LOG_ENTRY_HEADER) < fileSize && !stopProcessing) {
-            // Recherche de signatures potentielles
-            DWORD* sig = reinterpret_cast<DWORD*>(buffer.data() + offset);
-
-            // Signature "HvLE" (0x456C7648) pour dirty page
-            if (*sig == 0x656C7648 || *sig == 0x486B6E68) { // "HvLE" ou "hknh" (hive node header)
-                LOG_ENTRY_HEADER* entry = reinterpret_cast<LOG_ENTRY_HEADER*>(buffer.data() + offset);
-
-                if (entry->size > 0 && entry->size < 65536 && offset + entry->size <= fileSize) {
-                    TransactionEntry tx;
-
-                    // Timestamp : utiliser la séquence comme approximation temporelle
-                    FILETIME ft;
-                    GetSystemTimeAsFileTime(&ft);
-                    tx.timestamp = FileTimeToString(ft) + L" (Seq: " + std::to_wstring(entry->sequenceNumber) + L")";
-
-                    tx.hiveFile = hiveName;
-                    tx.offset = entry->offset;
-                    tx.txID = DwordToHex(entry->sequenceNumber);
-
-                    // Tentative d'extraction de key path (heuristique)
-                    // Recherche de strings Unicode dans les données
-                    std::wstring extractedPath;
-                    for (DWORD i = 0; i < std::min(entry->size, 512u); i += 2) {
-                        if (i + 2 <= entry->size) {
-                            wchar_t ch = *reinterpret_cast<wchar_t*>(&entry->data[i]);
-                            if (ch >= 32 && ch < 127) {
-                                extractedPath += ch;
-                            } else if (extractedPath.length() > 0) {
-                                break;
-                            }
-                        }
-                    }
+        size_t completed = 0;
+        for (int head = 0; ok && completed < chunkCount; head = (head + 1) % DIRECT_IO_QUEUE_DEPTH) {
+            PendingRead& slot = queue[head];
+            if (!slot.active) break;
 
-                    if (extractedPath.length() > 3) {
-                        tx.keyPath = extractedPath;
-                    } else {
-                        tx.keyPath = L"<Key @ offset " + DwordToHex(entry->offset) + L">";
-                    }
+            DWORD transferred = 0;
+            if (!GetOverlappedResult(hFile, &slot.ov, &transferred, TRUE) && GetLastError() != ERROR_HANDLE_EOF) {
+                ok = false;
+                break;
+            }
+            slot.active = false;
+            completed++;
+
+            const size_t expected = std::min<size_t>(fileSize - slot.chunk * DIRECT_IO_CHUNK_SIZE, DIRECT_IO_CHUNK_SIZE);
+            if (transferred < expected) {
+                ok = false;
+                break;
+            }
+
+            if (nextChunk < chunkCount) {
+                ok = issue(slot, nextChunk++);
+            }
+        }
+
+        if (!ok) {
+            CancelIo(hFile);
+            for (auto& slot : queue) {
+                DWORD ignored = 0;
+                if (slot.active) GetOverlappedResult(hFile, &slot.ov, &ignored, TRUE);
+            }
+        }
+        for (auto& slot : queue) CloseHandle(slot.ov.hEvent);
+
+        if (!ok || completed != chunkCount) {
+            error = L"Erreur : Lecture directe du fichier LOG échouée";
+            return false;
+        }
+        return true;
+    }
+
+public:
+    static bool Read(const std::wstring& path, bool directIO, AlignedBuffer& buffer, size_t& fileSize, std::wstring& error) {
+        fileSize = 0;
+        return directIO ? ReadDirect(path, buffer, fileSize, error)
+                        : ReadBuffered(path, buffer, fileSize, error);
+    }
+};
+
+// Codec de blocs au format LZ4 (séquences token / littéraux / offset 16 bits / match).
+// Compression gloutonne par table de hachage, décompression avec contrôle des bornes.
+class Lz4Codec {
+    static constexpr int HASH_BITS = 12;
+    static constexpr size_t MIN_MATCH = 4;
+    static constexpr size_t LAST_LITERALS = 5;    // Les 5 derniers octets sont toujours des littéraux
+    static constexpr size_t MF_LIMIT = 12;        // Pas de match commençant dans les 12 derniers octets
+    static constexpr size_t MAX_DISTANCE = 65535;
+
+    static DWORD Read32(const BYTE* p) {
+        DWORD v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static DWORD Hash(DWORD sequence) {
+        return (sequence * 2654435761U) >> (32 - HASH_BITS);
+    }
+
+    template<typename ByteVector>
+    static void WriteLength(ByteVector& out, size_t len) {
+        while (len >= 255) {
+            out.push_back(255);
+            len -= 255;
+        }
+        out.push_back(static_cast<BYTE>(len));
+    }
+
+    template<typename ByteVector>
+    static void EmitSequence(ByteVector& out, const BYTE* literals, size_t literalLen,
+                             size_t offset, size_t matchLen) {
+        const size_t matchCode = matchLen ? matchLen - MIN_MATCH : 0;
+        BYTE token = static_cast<BYTE>((std::min<size_t>(literalLen, 15) << 4) | std::min<size_t>(matchCode, 15));
+        out.push_back(token);
+        if (literalLen >= 15) WriteLength(out, literalLen - 15);
+        out.insert(out.end(), literals, literals + literalLen);
+        if (!matchLen) return; // Dernière séquence : littéraux seuls
+
+        out.push_back(static_cast<BYTE>(offset & 0xFF));
+        out.push_back(static_cast<BYTE>(offset >> 8));
+        if (matchCode >= 15) WriteLength(out, matchCode - 15);
+    }
+
+public:
+    template<typename ByteVector>
+    static void Compress(const BYTE* src, size_t len, ByteVector& out) {
+        out.clear();
+        out.reserve(len + len / 255 + 16);
+
+        size_t anchor = 0;
+        if (len > MF_LIMIT) {
+            std::vector<DWORD> table(static_cast<size_t>(1) << HASH_BITS, 0);
+            const size_t matchLimit = len - LAST_LITERALS;
+            size_t ip = 1;
+            table[Hash(Read32(src))] = 0;
 
-                    tx.valueName = L"<Dirty Page>";
-                    tx.dataBefore = L"<Uncommitted>";
-                    tx.dataAfter = BytesToHex(entry->data, std::min((DWORD)entry->size, 32u));
+            while (ip < len - MF_LIMIT) {
+                const DWORD sequence = Read32(src + ip);
+                const DWORD h = Hash(sequence);
+                const size_t ref = table[h];
+                table[h] = static_cast<DWORD>(ip);
 
-                    transactions.push_back(tx);
-                    txCounter++;
+                if (ip - ref > MAX_DISTANCE || Read32(src + ref) != sequence) {
+                    ip++;
+                    continue;
                 }
 
-                offset += entry->size;
+                size_t matchLen = MIN_MATCH;
+                while (ip + matchLen < matchLimit && src[ref + matchLen] == src[ip + matchLen]) matchLen++;
+
+                EmitSequence(out, src + anchor, ip - anchor, ip - ref, matchLen);
+                ip += matchLen;
+                anchor = ip;
+            }
+        }
+
+        EmitSequence(out, src + anchor, len - anchor, 0, 0);
+    }
+
+    static bool Decompress(const BYTE* src, size_t srcLen, BYTE* dst, size_t dstLen) {
+        size_t ip = 0, op = 0;
+
+        auto readLength = [&](size_t& len) -> bool {
+            BYTE b;
+            do {
+                if (ip >= srcLen) return false;
+                b = src[ip++];
+                len += b;
+            } while (b == 255);
+            return true;
+        };
+
+        while (ip < srcLen) {
+            const BYTE token = src[ip++];
+
+            size_t literalLen = token >> 4;
+            if (literalLen == 15 && !readLength(literalLen)) return false;
+            if (literalLen > srcLen - ip || literalLen > dstLen - op) return false;
+            memcpy(dst + op, src + ip, literalLen);
+            ip += literalLen;
+            op += literalLen;
+
+            if (ip == srcLen) break; // Dernière séquence
+
+            if (srcLen - ip < 2) return false;
+            const size_t offset = src[ip] | (static_cast<size_t>(src[ip + 1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > op) return false;
+
+            size_t matchLen = token & 0x0F;
+            if (matchLen == 15 && !readLength(matchLen)) return false;
+            matchLen += MIN_MATCH;
+            if (matchLen > dstLen - op) return false;
+
+            // Copie octet par octet : le match peut chevaucher la sortie
+            const BYTE* match = dst + op - offset;
+            for (size_t i = 0; i < matchLen; i++) dst[op + i] = match[i];
+            op += matchLen;
+        }
+
+        return op == dstLen;
+    }
+};
+
+// Décodeur DEFLATE (RFC 1951) et CRC-32 pour les entrées gzip. Huffman canonique
+// décodé bit à bit : simple et sans table, suffisant face au coût du parsing.
+class DeflateDecoder {
+    struct Huffman {
+        short count[16];        // Nombre de codes par longueur
+        short symbol[288];      // Symboles triés par code
+    };
+
+    struct State {
+        const BYTE* src;
+        size_t len;
+        size_t pos;
+        DWORD bits;
+        int bitCount;
+        bool overrun;
+        bool exceeded;          // La sortie dépasserait limit
+        std::vector<BYTE>* out;
+        size_t outStart;        // Les distances ne remontent pas avant ce point
+        size_t limit;           // Taille maximale de out
+    };
+
+    static bool Fits(State& s, size_t len) {
+        if (len <= s.limit - s.out->size()) return true;
+        s.exceeded = true;
+        return false;
+    }
+
+    static int Bits(State& s, int need) {
+        DWORD value = s.bits;
+        while (s.bitCount < need) {
+            if (s.pos >= s.len) {
+                s.overrun = true;
+                return 0;
+            }
+            value |= static_cast<DWORD>(s.src[s.pos++]) << s.bitCount;
+            s.bitCount += 8;
+        }
+        s.bits = value >> need;
+        s.bitCount -= need;
+        return static_cast<int>(value & ((1UL << need) - 1));
+    }
+
+    static int Decode(State& s, const Huffman& h) {
+        int code = 0, first = 0, index = 0;
+        for (int len = 1; len < 16; len++) {
+            code |= Bits(s, 1);
+            if (s.overrun) return -1;
+            const int count = h.count[len];
+            if (code - count < first) return h.symbol[index + (code - first)];
+            index += count;
+            first = (first + count) << 1;
+            code <<= 1;
+        }
+        return -1;
+    }
+
+    // Retourne 0 si le code est complet, > 0 s'il est incomplet, < 0 s'il est sur-souscrit
+    static int Build(Huffman& h, const short* lengths, int n) {
+        for (int len = 0; len < 16; len++) h.count[len] = 0;
+        for (int sym = 0; sym < n; sym++) h.count[lengths[sym]]++;
+        if (h.count[0] == n) return 0;
+
+        int left = 1;
+        for (int len = 1; len < 16; len++) {
+            left <<= 1;
+            left -= h.count[len];
+            if (left < 0) return left;
+        }
+
+        short offsets[16];
+        offsets[1] = 0;
+        for (int len = 1; len < 15; len++) offsets[len + 1] = offsets[len] + h.count[len];
+        for (int sym = 0; sym < n; sym++) {
+            if (lengths[sym] != 0) h.symbol[offsets[lengths[sym]]++] = static_cast<short>(sym);
+        }
+        return left;
+    }
+
+    static bool Stored(State& s) {
+        s.bits = 0;
+        s.bitCount = 0; // Reste de l'octet courant ignoré
+        if (s.len - s.pos < 4) return false;
+        const unsigned len = s.src[s.pos] | (s.src[s.pos + 1] << 8);
+        const unsigned nlen = s.src[s.pos + 2] | (s.src[s.pos + 3] << 8);
+        if (len != (~nlen & 0xFFFF)) return false;
+        s.pos += 4;
+        if (s.len - s.pos < len || !Fits(s, len)) return false;
+        s.out->insert(s.out->end(), s.src + s.pos, s.src + s.pos + len);
+        s.pos += len;
+        return true;
+    }
+
+    static bool Codes(State& s, const Huffman& lencode, const Huffman& distcode) {
+        static const short lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                              35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        static const short lengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                               3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        static const int distBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                          257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                          8193, 12289, 16385, 24577 };
+        static const short distExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                             7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+        std::vector<BYTE>& out = *s.out;
+        for (;;) {
+            int symbol = Decode(s, lencode);
+            if (symbol < 0) return false;
+            if (symbol < 256) {
+                if (!Fits(s, 1)) return false;
+                out.push_back(static_cast<BYTE>(symbol));
+            } else if (symbol == 256) {
+                return true;
             } else {
-                offset += 4; // Avancer de 4 bytes pour chercher la prochaine signature
+                symbol -= 257;
+                if (symbol >= 29) return false;
+                const size_t len = lengthBase[symbol] + Bits(s, lengthExtra[symbol]);
+
+                symbol = Decode(s, distcode);
+                if (symbol < 0 || symbol >= 30) return false;
+                const size_t dist = distBase[symbol] + Bits(s, distExtra[symbol]);
+                if (s.overrun || dist > out.size() - s.outStart || !Fits(s, len)) return false;
+
+                // Copie octet par octet : la référence peut chevaucher la sortie
+                size_t from = out.size() - dist;
+                for (size_t i = 0; i < len; i++) out.push_back(out[from + i]);
             }
         }
+    }
 
-        UpdateStatus(L"Parsing terminé : " + std::to_wstring(txCounter) + L" transactions trouvées");
-        return txCounter > 0;
+    static bool Fixed(State& s) {
+        struct FixedTables {
+            Huffman lencode, distcode;
+            FixedTables() {
+                short lengths[288];
+                int sym = 0;
+                for (; sym < 144; sym++) lengths[sym] = 8;
+                for (; sym < 256; sym++) lengths[sym] = 9;
+                for (; sym < 280; sym++) lengths[sym] = 7;
+                for (; sym < 288; sym++) lengths[sym] = 8;
+                Build(lencode, lengths, 288);
+                for (sym = 0; sym < 30; sym++) lengths[sym] = 5;
+                Build(distcode, lengths, 30);
+            }
+        };
+        static const FixedTables tables;
+        return Codes(s, tables.lencode, tables.distcode);
     }
 
-    void PopulateListView() {
-        ListView_DeleteAllItems(hwndList);
+    static bool Dynamic(State& s) {
+        static const short order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+        const int nlen = Bits(s, 5) + 257;
+        const int ndist = Bits(s, 5) + 1;
+        const int ncode = Bits(s, 4) + 4;
+        if (s.overrun || nlen > 286 || ndist > 30) return false;
+
+        short lengths[320] = {};
+        for (int i = 0; i < ncode; i++) lengths[order[i]] = static_cast<short>(Bits(s, 3));
 
-        for (size_t i = 0; i < transactions.size(); i++) {
-            LVITEMW lvi = {};
-            lvi.mask = LVIF_TEXT;
-            lvi.iItem = static_cast<int>(i);
+        Huffman lencode, distcode;
+        if (Build(lencode, lengths, 19) != 0) return false;
 
-            lvi.iSubItem = 0;
-            lvi.pszText = const_cast<LPWSTR>(transactions[i].timestamp.c_str());
-            ListView_InsertItem(hwndList, &lvi);
+        int index = 0;
+        while (index < nlen + ndist) {
+            int symbol = Decode(s, lencode);
+            if (symbol < 0) return false;
+            if (symbol < 16) {
+                lengths[index++] = static_cast<short>(symbol);
+                continue;
+            }
+
+            short len = 0;
+            if (symbol == 16) {
+                if (index == 0) return false;
+                len = lengths[index - 1];
+                symbol = 3 + Bits(s, 2);
+            } else if (symbol == 17) {
+                symbol = 3 + Bits(s, 3);
+            } else {
+                symbol = 11 + Bits(s, 7);
+            }
+            if (s.overrun || index + symbol > nlen + ndist) return false;
+            while (symbol--) lengths[index++] = len;
+        }
+        if (lengths[256] == 0) return false;
+
+        // Un code incomplet n'est admis que s'il ne contient qu'un symbole
+        int err = Build(lencode, lengths, nlen);
+        if (err < 0 || (err > 0 && nlen - lencode.count[0] != 1)) return false;
+        err = Build(distcode, lengths + nlen, ndist);
+        if (err < 0 || (err > 0 && ndist - distcode.count[0] != 1)) return false;
+
+        return Codes(s, lencode, distcode);
+    }
 
-            ListView_SetItemText(hwndList, i, 1, const_cast<LPWSTR>(transactions[i].hiveFile.c_str()));
-            ListView_SetItemText(hwndList, i, 2, const_cast<LPWSTR>(transactions[i].keyPath.c_str()));
-            ListView_SetItemText(hwndList, i, 3, const_cast<LPWSTR>(transactions[i].valueName.c_str()));
-            ListView_SetItemText(hwndList, i, 4, const_cast<LPWSTR>(transactions[i].dataBefore.c_str()));
-            ListView_SetItemText(hwndList, i, 5, const_cast<LPWSTR>(transactions[i].dataAfter.c_str()));
-            ListView_SetItemText(hwndList, i, 6, const_cast<LPWSTR>(transactions[i].txID.c_str()));
+public:
+    // Décompresse un flux DEFLATE brut à la suite de out ; consumed reçoit
+    // le nombre d'octets du flux (jusqu'à l'octet contenant le dernier bit).
+    // Le décodage échoue dès que out dépasserait limit octets (exceeded levé).
+    static bool Inflate(const BYTE* src, size_t len, std::vector<BYTE>& out, size_t& consumed, size_t limit,
+                        bool& exceeded) {
+        State s = { src, len, 0, 0, 0, false, false, &out, out.size(), limit };
+        exceeded = false;
+        int last;
+        do {
+            last = Bits(s, 1);
+            const int type = Bits(s, 2);
+            if (s.overrun) return false;
+
+            bool ok = false;
+            switch (type) {
+                case 0: ok = Stored(s); break;
+                case 1: ok = Fixed(s); break;
+                case 2: ok = Dynamic(s); break;
+                default: ok = false; break;
+            }
+            if (!ok || s.overrun) {
+                exceeded = s.exceeded;
+                return false;
+            }
+        } while (!last);
+
+        consumed = s.pos;
+        return true;
+    }
+
+    static DWORD Crc32(const BYTE* data, size_t len, DWORD crc = 0) {
+        struct Table {
+            DWORD entries[256];
+            Table() {
+                for (DWORD i = 0; i < 256; i++) {
+                    DWORD c = i;
+                    for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+                    entries[i] = c;
+                }
+            }
+        };
+        static const Table table;
+
+        crc = ~crc;
+        for (size_t i = 0; i < len; i++) crc = table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+};
+
+// Store mémoire des pages complètes. Les pages sont concaténées dans des blocs
+// de PAGE_STORE_BLOCK_SIZE octets compressés dès qu'ils sont pleins ; la lecture
+// décompresse le bloc concerné dans un petit cache LRU de blocs chauds.
+class CompressedPageStore {
+    struct Block {
+        PageBytes bytes;            // Compressés, ou bruts si le bloc est ouvert / incompressible
+        DWORD rawSize = 0;
+        bool compressed = false;
+    };
+    struct PageLocation {
+        DWORD block;
+        DWORD offset;
+        DWORD length;
+    };
+    struct HotBlock {
+        DWORD block;
+        ULONGLONG lastUse;
+        std::vector<BYTE> bytes;
+    };
+
+    std::vector<Block> blocks;
+    std::vector<PageLocation> pages;
+    std::unordered_map<ULONGLONG, ULONGLONG> byContent;     // Hash du contenu -> page
+    std::vector<HotBlock> hot;
+    ULONGLONG useClock = 0;
+    size_t rawBytes = 0, storedBytes = 0;
+    mutable CRITICAL_SECTION lock;
+
+    void SealOpenBlock() {
+        if (blocks.empty() || blocks.back().compressed || blocks.back().bytes.empty()) return;
+
+        Block& block = blocks.back();
+        PageBytes packed;
+        Lz4Codec::Compress(block.bytes.data(), block.bytes.size(), packed);
+        if (packed.size() < block.bytes.size()) {
+            block.bytes.swap(packed);
+            block.compressed = true;
+        }
+        block.bytes.shrink_to_fit();
+        storedBytes += block.bytes.size();
+    }
+
+public:
+    CompressedPageStore() { InitializeCriticalSection(&lock); }
+    ~CompressedPageStore() { DeleteCriticalSection(&lock); }
+    CompressedPageStore(const CompressedPageStore&) = delete;
+    CompressedPageStore& operator=(const CompressedPageStore&) = delete;
+
+    // Une page déjà conservée (même hash, même taille) n'est pas dupliquée
+    ULONGLONG Append(const BYTE* data, DWORD length, ULONGLONG contentHash) {
+        if (length > PAGE_STORE_BLOCK_SIZE) return PAGE_NONE;
+
+        EnterCriticalSection(&lock);
+        auto known = byContent.find(contentHash);
+        if (known != byContent.end() && pages[known->second].length == length) {
+            ULONGLONG id = known->second;
+            LeaveCriticalSection(&lock);
+            return id;
+        }
+
+        if (blocks.empty() || blocks.back().compressed ||
+            blocks.back().bytes.size() + length > PAGE_STORE_BLOCK_SIZE) {
+            SealOpenBlock();
+            blocks.emplace_back();
+            blocks.back().bytes.reserve(PAGE_STORE_BLOCK_SIZE);
+        }
+
+        Block& block = blocks.back();
+        PageLocation loc = { static_cast<DWORD>(blocks.size() - 1), static_cast<DWORD>(block.bytes.size()), length };
+        block.bytes.insert(block.bytes.end(), data, data + length);
+        block.rawSize = static_cast<DWORD>(block.bytes.size());
+        pages.push_back(loc);
+        rawBytes += length;
+
+        ULONGLONG id = pages.size() - 1;
+        byContent[contentHash] = id;
+        LeaveCriticalSection(&lock);
+        return id;
+    }
+
+    // Compresse le bloc ouvert (fin de parsing)
+    void Seal() {
+        EnterCriticalSection(&lock);
+        SealOpenBlock();
+        LeaveCriticalSection(&lock);
+    }
+
+    bool Get(ULONGLONG id, std::vector<BYTE>& out) {
+        EnterCriticalSection(&lock);
+        bool ok = id < pages.size();
+        if (ok) {
+            const PageLocation loc = pages[static_cast<size_t>(id)];
+            const Block& block = blocks[loc.block];
+            const BYTE* raw = nullptr;
+
+            if (!block.compressed) {
+                raw = block.bytes.data();
+            } else {
+                auto it = std::find_if(hot.begin(), hot.end(), [&](const HotBlock& h) { return h.block == loc.block; });
+                if (it == hot.end()) {
+                    if (hot.size() < PAGE_STORE_HOT_BLOCKS) {
+                        hot.emplace_back();
+                        it = hot.end() - 1;
+                    } else {
+                        it = std::min_element(hot.begin(), hot.end(),
+                                              [](const HotBlock& a, const HotBlock& b) { return a.lastUse < b.lastUse; });
+                    }
+                    it->block = loc.block;
+                    it->bytes.resize(block.rawSize);
+                    if (!Lz4Codec::Decompress(block.bytes.data(), block.bytes.size(), it->bytes.data(), block.rawSize)) {
+                        hot.erase(it);
+                        ok = false;
+                    }
+                }
+                if (ok) {
+                    it->lastUse = ++useClock;
+                    raw = it->bytes.data();
+                }
+            }
+
+            if (ok) out.assign(raw + loc.offset, raw + loc.offset + loc.length);
+        }
+        LeaveCriticalSection(&lock);
+        return ok;
+    }
+
+    void Clear() {
+        EnterCriticalSection(&lock);
+        blocks.clear();
+        pages.clear();
+        byContent.clear();
+        hot.clear();
+        rawBytes = storedBytes = 0;
+        LeaveCriticalSection(&lock);
+    }
+
+    size_t RawBytes() const { return rawBytes; }
+    size_t StoredBytes() const { return storedBytes; }
+    size_t PageCount() const { return pages.size(); }
+};
+
+// Cellule de valeur ("vk") trouvée dans une page de hive
+struct ValueCell {
+    std::wstring name;
+    DWORD type;
+    DWORD dataSize;
+    bool inlineData;        // Données de 4 octets au plus, stockées à la place de l'offset
+    DWORD dataOffset;       // Offset de cellule relatif au début des hbins
+    DWORD cellOffset;       // Cellule "vk" elle-même
+};
+
+// Vue sur la page sale portée par une entrée de log. Les cellules sont alignées
+// sur 8 octets et débutent par leur taille (négative si allouée) ; une donnée de
+// valeur n'est lisible que si sa cellule se trouve dans la même page.
+class HivePage {
+    const BYTE* data;
+    size_t size;
+    DWORD hiveOffset;
+
+    DWORD Read32(size_t pos) const {
+        DWORD v;
+        memcpy(&v, data + pos, sizeof(v));
+        return v;
+    }
+    WORD Read16(size_t pos) const { return static_cast<WORD>(data[pos] | (data[pos + 1] << 8)); }
+
+    // Contenu de la cellule à l'offset hive donné, borné à la page
+    bool Cell(DWORD cellOffset, size_t& pos, size_t& len) const {
+        if (cellOffset < hiveOffset || cellOffset - hiveOffset + 4 > size) return false;
+        pos = cellOffset - hiveOffset;
+        const LONG cellSize = static_cast<LONG>(Read32(pos));
+        if (cellSize >= 0 || static_cast<size_t>(-static_cast<LONGLONG>(cellSize)) > size - pos) return false;
+        len = static_cast<size_t>(-static_cast<LONGLONG>(cellSize)) - 4;
+        pos += 4;
+        return true;
+    }
+
+public:
+    explicit HivePage(const LOG_ENTRY_HEADER* entry)
+        : data(entry->data), size(entry->size > offsetof(LOG_ENTRY_HEADER, data) ? entry->size - offsetof(LOG_ENTRY_HEADER, data) : 0),
+          hiveOffset(entry->offset) {}
+
+    template<typename Fn>
+    void ForEachValue(Fn fn) const {
+        for (size_t pos = (8 - hiveOffset % 8) % 8; pos + 4 + VK_FIXED_SIZE <= size; pos += 8) {
+            if (data[pos + 4] != 'v' || data[pos + 5] != 'k') continue;
+            const LONG cellSize = static_cast<LONG>(Read32(pos));
+            const size_t nameLen = Read16(pos + 6);
+            if (cellSize >= 0 || static_cast<size_t>(-static_cast<LONGLONG>(cellSize)) < 4 + VK_FIXED_SIZE + nameLen ||
+                pos + 4 + VK_FIXED_SIZE + nameLen > size) {
+                continue;
+            }
+
+            ValueCell cell;
+            cell.cellOffset = static_cast<DWORD>(hiveOffset + pos);
+            const DWORD rawSize = Read32(pos + 8);
+            cell.inlineData = (rawSize & 0x80000000) != 0;
+            cell.dataSize = rawSize & 0x7FFFFFFF;
+            cell.dataOffset = Read32(pos + 12);
+            cell.type = Read32(pos + 16);
+
+            const BYTE* name = data + pos + 4 + VK_FIXED_SIZE;
+            if (Read16(pos + 20) & VK_FLAG_ASCII_NAME) {
+                cell.name.assign(name, name + nameLen);
+            } else {
+                for (size_t i = 0; i + 1 < nameLen; i += 2) cell.name += static_cast<wchar_t>(name[i] | (name[i + 1] << 8));
+            }
+            if (cell.name.empty()) cell.name = L"(par défaut)";
+            fn(cell);
+        }
+    }
+
+    // fn(offset) pour chaque cellule "nk" allouée de la page (offset relatif aux hbins)
+    template<typename Fn>
+    void ForEachKey(Fn fn) const {
+        for (size_t pos = (8 - hiveOffset % 8) % 8; pos + 4 + NK_FIXED_SIZE <= size; pos += 8) {
+            if (data[pos + 4] != 'n' || data[pos + 5] != 'k') continue;
+            const LONG cellSize = static_cast<LONG>(Read32(pos));
+            if (cellSize >= 0 || static_cast<size_t>(-static_cast<LONGLONG>(cellSize)) < 4 + NK_FIXED_SIZE) continue;
+            fn(static_cast<DWORD>(hiveOffset + pos));
+        }
+    }
+
+    // Octets bruts d'une donnée non inline dont la cellule est dans la page
+    bool ValueBytes(const ValueCell& cell, const BYTE*& bytes, size_t& length) const {
+        size_t pos = 0, len = 0;
+        if (cell.inlineData || !Cell(cell.dataOffset, pos, len)) return false;
+        bytes = data + pos;
+        length = std::min<size_t>(cell.dataSize, len);
+        return true;
+    }
+
+    bool ValueDword(const ValueCell& cell, DWORD& value) const {
+        if (cell.type != REG_DWORD || cell.dataSize != sizeof(DWORD) || !cell.inlineData) return false;
+        value = cell.dataOffset;
+        return true;
+    }
+
+    // REG_SZ / REG_EXPAND_SZ / REG_MULTI_SZ (chaînes jointes par "; ")
+    bool ValueString(const ValueCell& cell, std::wstring& value) const {
+        if (cell.type != REG_SZ && cell.type != REG_EXPAND_SZ && cell.type != REG_MULTI_SZ) return false;
+
+        size_t pos = 0, len = 0;
+        if (cell.inlineData) return false;
+        if (!Cell(cell.dataOffset, pos, len) || cell.dataSize > len) return false;
+
+        value.clear();
+        for (size_t i = 0; i + 1 < cell.dataSize; i += 2) {
+            const wchar_t ch = static_cast<wchar_t>(data[pos + i] | (data[pos + i + 1] << 8));
+            if (ch == 0) {
+                if (cell.type != REG_MULTI_SZ) break;
+                if (!value.empty() && value.back() != L' ') value += L"; ";
+                continue;
+            }
+            value += ch;
+        }
+        while (!value.empty() && (value.back() == L' ' || value.back() == L';')) value.pop_back();
+        return true;
+    }
+};
+
+// Décodeur d'artefact de persistance : motifs de chemins de clé ("*" = un
+// composant quelconque, "**" = un ou plusieurs, comparaison insensible à la
+// casse, ancrés en fin de chemin) et valeurs à extraire de la page.
+struct ArtifactDecoder {
+    const wchar_t* name;                    // "Run", "Service"...
+    std::vector<const wchar_t*> patterns;
+    const wchar_t* keyLabel;                // Libellé d'un composant du chemin (nom du service...), nullptr sinon
+    size_t labelComponent;                  // Rang de ce composant depuis la fin (0 = clé elle-même)
+    std::vector<const wchar_t*> values;     // Vide : toutes les valeurs de la clé
+
+    std::wstring Decode(const HivePage& page, const std::wstring& keyPath) const {
+        std::wstring details;
+        auto add = [&details](const std::wstring& field) {
+            if (!details.empty()) details += L"; ";
+            details += field;
+        };
+        if (keyLabel) add(std::wstring(keyLabel) + L"=" + Component(keyPath, labelComponent));
+
+        bool found = false;
+        page.ForEachValue([&](const ValueCell& cell) {
+            if (!Selects(cell.name)) return;
+            found = true;
+
+            std::wstring text;
+            DWORD dword = 0;
+            if (page.ValueString(cell, text)) {
+                add(cell.name + L"=" + text);
+            } else if (page.ValueDword(cell, dword)) {
+                add(cell.name + L"=" + FormatDword(cell.name, dword));
+            } else if (cell.type == REG_BINARY) {
+                add(cell.name + L"=<" + std::to_wstring(cell.dataSize) + L" octets>");
+            } else {
+                add(cell.name + L"=<hors page>");
+            }
+        });
+        if (!found) add(L"<valeurs hors page>");
+        return details;
+    }
+
+    bool Selects(const std::wstring& valueName) const {
+        return values.empty() || std::any_of(values.begin(), values.end(),
+                                             [&valueName](const wchar_t* v) { return _wcsicmp(v, valueName.c_str()) == 0; });
+    }
+
+    // Valeur lue en entier dans le hive primaire (text : données déjà mises en forme)
+    std::wstring DecodeValue(const std::wstring& keyPath, const std::wstring& valueName, const std::wstring& text) const {
+        std::wstring details;
+        if (keyLabel) details = std::wstring(keyLabel) + L"=" + Component(keyPath, labelComponent) + L"; ";
+        return details + valueName + L"=" + text;
+    }
+
+    static std::wstring Component(const std::wstring& keyPath, size_t fromEnd) {
+        size_t end = keyPath.size();
+        while (end > 0 && keyPath[end - 1] == L'\\') end--;
+        while (end > 0) {
+            const size_t sep = keyPath.rfind(L'\\', end - 1);
+            const size_t begin = sep == std::wstring::npos ? 0 : sep + 1;
+            if (fromEnd-- == 0 || sep == std::wstring::npos) return keyPath.substr(begin, end - begin);
+            end = sep;
+        }
+        return std::wstring();
+    }
+
+    static std::wstring FormatDword(const std::wstring& valueName, DWORD value) {
+        static const wchar_t* startTypes[] = { L"Boot", L"System", L"Automatique", L"Manuel", L"Désactivé" };
+        if (_wcsicmp(valueName.c_str(), L"Start") == 0 && value < _countof(startTypes)) {
+            return std::to_wstring(value) + L" (" + startTypes[value] + L")";
+        }
+        wchar_t hex[16];
+        swprintf_s(hex, L"0x%X", value);
+        return hex;
+    }
+};
+
+// Table de dispatch : les motifs sont compilés dans un trie sur les composants
+// du chemin, pris à rebours et hachés (FNV-1a, minuscules). Un enregistrement
+// sans correspondance coûte le hachage de ses composants et une recherche.
+class ArtifactDispatch {
+    struct Node {
+        std::unordered_map<ULONGLONG, int> children;
+        int wildcard = -1;
+        int deep = -1;          // "**"
+        int decoder = -1;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<ArtifactDecoder> decoders;
+
+    static ULONGLONG ComponentHash(const wchar_t* begin, const wchar_t* end) {
+        ULONGLONG hash = FNV_OFFSET_BASIS;
+        for (const wchar_t* p = begin; p < end; p++) {
+            const wchar_t ch = static_cast<wchar_t>(std::towlower(*p));
+            hash = Fnv1a64(&ch, sizeof(ch), hash);
+        }
+        return hash;
+    }
+
+    static std::vector<std::pair<const wchar_t*, const wchar_t*>> Split(const wchar_t* path, size_t len) {
+        std::vector<std::pair<const wchar_t*, const wchar_t*>> parts;
+        const wchar_t* start = path;
+        for (const wchar_t* p = path; p <= path + len; p++) {
+            if (p == path + len || *p == L'\\') {
+                if (p > start) parts.emplace_back(start, p);
+                start = p + 1;
+            }
+        }
+        return parts;
+    }
+
+    int Child(int node, const std::pair<const wchar_t*, const wchar_t*>& part) {
+        const bool wildcard = part.second - part.first == 1 && *part.first == L'*';
+        const bool deep = part.second - part.first == 2 && part.first[0] == L'*' && part.first[1] == L'*';
+        int next = wildcard ? nodes[node].wildcard : deep ? nodes[node].deep : -1;
+        if (!wildcard && !deep) {
+            auto it = nodes[node].children.find(ComponentHash(part.first, part.second));
+            if (it != nodes[node].children.end()) next = it->second;
+        }
+        if (next >= 0) return next;
+
+        nodes.emplace_back();
+        next = static_cast<int>(nodes.size() - 1);
+        if (wildcard) {
+            nodes[node].wildcard = next;
+        } else if (deep) {
+            nodes[node].deep = next;
+        } else {
+            nodes[node].children[ComponentHash(part.first, part.second)] = next;
+        }
+        return next;
+    }
+
+    // Le motif le plus profond l'emporte (Services\*\Parameters avant Services\*)
+    void Walk(int node, const std::vector<ULONGLONG>& hashes, size_t depth, int& best, size_t& bestDepth) const {
+        const Node& n = nodes[node];
+        if (n.decoder >= 0 && depth > bestDepth) {
+            best = n.decoder;
+            bestDepth = depth;
+        }
+        if (depth == hashes.size()) return;
+
+        auto it = n.children.find(hashes[hashes.size() - 1 - depth]);
+        if (it != n.children.end()) Walk(it->second, hashes, depth + 1, best, bestDepth);
+        if (n.wildcard >= 0) Walk(n.wildcard, hashes, depth + 1, best, bestDepth);
+        for (size_t end = depth + 1; n.deep >= 0 && end <= hashes.size(); end++) Walk(n.deep, hashes, end, best, bestDepth);
+    }
+
+public:
+    ArtifactDispatch() : nodes(1) {
+        const wchar_t* controlSets[] = { L"CurrentControlSet", L"ControlSet001", L"ControlSet002", L"ControlSet003" };
+        std::vector<std::wstring> services, serviceParameters;
+        for (const wchar_t* set : controlSets) {
+            services.push_back(std::wstring(set) + L"\\Services\\*");
+            serviceParameters.push_back(std::wstring(set) + L"\\Services\\*\\Parameters");
+        }
+
+        Register({ L"Run", { L"Microsoft\\Windows\\CurrentVersion\\Run", L"Microsoft\\Windows\\CurrentVersion\\RunOnce",
+                             L"Microsoft\\Windows\\CurrentVersion\\RunOnceEx", L"Microsoft\\Windows\\CurrentVersion\\RunServices",
+                             L"Microsoft\\Windows\\CurrentVersion\\RunServicesOnce",
+                             L"Microsoft\\Windows\\CurrentVersion\\Policies\\Explorer\\Run" },
+                   nullptr, 0, {} });
+        Register({ L"IFEO", { L"Microsoft\\Windows NT\\CurrentVersion\\Image File Execution Options\\*" },
+                   L"Image", 0, { L"Debugger", L"GlobalFlag", L"VerifierDlls" } });
+        Register({ L"AppInit_DLLs", { L"Microsoft\\Windows NT\\CurrentVersion\\Windows" },
+                   nullptr, 0, { L"AppInit_DLLs", L"LoadAppInit_DLLs", L"RequireSignedAppInit_DLLs" } });
+        Register({ L"Winlogon", { L"Microsoft\\Windows NT\\CurrentVersion\\Winlogon" },
+                   nullptr, 0, { L"Shell", L"Userinit", L"Taskman", L"AppSetup", L"GinaDLL" } });
+        Register({ L"ShimCache", { L"Control\\Session Manager\\AppCompatCache" },
+                   nullptr, 0, { L"AppCompatCache" } });
+        Register({ L"Tâche planifiée", { L"Microsoft\\Windows NT\\CurrentVersion\\Schedule\\TaskCache\\Tasks\\*" },
+                   L"Tâche", 0, { L"Path", L"URI", L"Author", L"Actions" } });
+        Register({ L"Tâche planifiée", { L"Microsoft\\Windows NT\\CurrentVersion\\Schedule\\TaskCache\\Tree\\**" },
+                   L"Tâche", 0, { L"Id", L"Index", L"SD" } });
+
+        ArtifactDecoder service = { L"Service", {}, L"Service", 0, { L"ImagePath", L"Start", L"Type", L"ObjectName", L"DisplayName" } };
+        ArtifactDecoder serviceDll = { L"Service", {}, L"Service", 1, { L"ServiceDll", L"ServiceMain" } };
+        for (const auto& p : services) service.patterns.push_back(p.c_str());
+        for (const auto& p : serviceParameters) serviceDll.patterns.push_back(p.c_str());
+        Register(service);
+        Register(serviceDll);
+    }
+
+    void Register(ArtifactDecoder decoder) {
+        const int index = static_cast<int>(decoders.size());
+        for (const wchar_t* pattern : decoder.patterns) {
+            auto parts = Split(pattern, wcslen(pattern));
+            int node = 0;
+            for (auto it = parts.rbegin(); it != parts.rend(); ++it) node = Child(node, *it);
+            nodes[node].decoder = index;
+        }
+        decoder.patterns.clear(); // Compilés dans le trie ; les chaînes source peuvent disparaître
+        decoders.push_back(std::move(decoder));
+    }
+
+    static const ArtifactDispatch& Instance() {
+        static const ArtifactDispatch dispatch;
+        return dispatch;
+    }
+
+    // Décodeur du chemin de clé, nullptr si aucun motif ne correspond
+    const ArtifactDecoder* Match(const std::wstring& keyPath) const {
+        if (keyPath.find(L'\\') == std::wstring::npos) return nullptr;
+
+        auto parts = Split(keyPath.c_str(), keyPath.size());
+        std::vector<ULONGLONG> hashes;
+        hashes.reserve(parts.size());
+        for (const auto& part : parts) hashes.push_back(ComponentHash(part.first, part.second));
+
+        int best = -1;
+        size_t bestDepth = 0;
+        Walk(0, hashes, 0, best, bestDepth);
+        return best < 0 ? nullptr : &decoders[best];
+    }
+};
+
+// Image clairsemée d'un hive reconstituée depuis les pages sales d'un log. Les
+// pages sont référencées en place et la plus récente (séquence) l'emporte ; les
+// octets absents du log sont lus à la demande dans le hive primaire voisin
+// (SYSTEM pour SYSTEM.LOG1). Les offsets sont relatifs au début des hbins.
+class HiveImage {
+public:
+    using Span = std::pair<const BYTE*, size_t>;
+
+private:
+    struct Piece {
+        const BYTE* data;
+        size_t size;
+        DWORD sequence;
+    };
+
+    std::vector<std::pair<DWORD, Piece>> pending;
+    std::map<ULONGLONG, Piece> pieces;              // Plages disjointes, par offset
+    std::unique_ptr<FileHandle> primary;
+    std::deque<std::vector<BYTE>> fetched;          // Plages lues dans le hive primaire
+    size_t fetchedBytes = 0;
+
+    void Overwrite(ULONGLONG offset, const Piece& piece) {
+        const ULONGLONG end = offset + piece.size;
+        auto it = pieces.lower_bound(offset);
+        if (it != pieces.begin() && std::prev(it)->first + std::prev(it)->second.size > offset) --it;
+
+        while (it != pieces.end() && it->first < end) {
+            const ULONGLONG oldOffset = it->first;
+            const Piece old = it->second;
+            it = pieces.erase(it);
+            if (oldOffset < offset) {
+                pieces.emplace(oldOffset, Piece{ old.data, static_cast<size_t>(offset - oldOffset), old.sequence });
+            }
+            if (oldOffset + old.size > end) {
+                pieces.emplace(end, Piece{ old.data + (end - oldOffset), static_cast<size_t>(oldOffset + old.size - end),
+                                           old.sequence });
+            }
+        }
+        pieces.emplace(offset, piece);
+    }
+
+    bool Fetch(ULONGLONG offset, size_t length, std::vector<Span>& out) {
+        if (!primary) return false;
+
+        std::vector<BYTE> bytes(length);
+        OVERLAPPED ov = {};
+        const ULONGLONG fileOffset = HBIN_BASE_OFFSET + offset;
+        ov.Offset = static_cast<DWORD>(fileOffset);
+        ov.OffsetHigh = static_cast<DWORD>(fileOffset >> 32);
+        DWORD read = 0;
+        if (!ReadFile(*primary, bytes.data(), static_cast<DWORD>(length), &read, &ov) || read != length) return false;
+
+        fetchedBytes += length;
+        fetched.push_back(std::move(bytes));
+        out.emplace_back(fetched.back().data(), length);
+        return true;
+    }
+
+public:
+    void Add(DWORD offset, const BYTE* data, size_t size, DWORD sequence) {
+        if (size) pending.emplace_back(offset, Piece{ data, size, sequence });
+    }
+
+    // Superpose les pages par séquence croissante
+    void Seal() {
+        std::stable_sort(pending.begin(), pending.end(),
+                         [](const auto& a, const auto& b) { return a.second.sequence < b.second.sequence; });
+        for (const auto& p : pending) Overwrite(p.first, p.second);
+        pending.clear();
+    }
+
+    // Hive primaire de repli (signature "regf" requise)
+    bool OpenPrimary(const std::wstring& path) {
+        auto file = std::make_unique<FileHandle>(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                                             nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+        DWORD signature = 0, read = 0;
+        if (!file->valid() || !ReadFile(*file, &signature, sizeof(signature), &read, nullptr) ||
+            read != sizeof(signature) || signature != 0x66676572) { // "regf"
+            return false;
+        }
+        primary = std::move(file);
+        return true;
+    }
+
+    bool Empty() const { return pieces.empty(); }
+    size_t FetchedBytes() const { return fetchedBytes; }
+
+    // Plages mémoire couvrant [offset, offset + length), sans copie des pages du log
+    bool Gather(ULONGLONG offset, size_t length, std::vector<Span>& out) {
+        const ULONGLONG end = offset + length;
+        ULONGLONG pos = offset;
+        while (pos < end) {
+            auto it = pieces.upper_bound(pos);
+            const ULONGLONG next = it == pieces.end() ? end : std::min<ULONGLONG>(end, it->first);
+            if (it != pieces.begin() && std::prev(it)->first + std::prev(it)->second.size > pos) {
+                --it;
+                const size_t take = static_cast<size_t>(std::min<ULONGLONG>(end, it->first + it->second.size) - pos);
+                out.emplace_back(it->second.data + (pos - it->first), take);
+                pos += take;
+            } else if (Fetch(pos, static_cast<size_t>(next - pos), out)) {
+                pos = next;
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Read(ULONGLONG offset, void* dst, size_t length) {
+        std::vector<Span> spans;
+        if (!Gather(offset, length, spans)) return false;
+        BYTE* out = static_cast<BYTE*>(dst);
+        for (const Span& span : spans) {
+            memcpy(out, span.first, span.second);
+            out += span.second;
+        }
+        return true;
+    }
+
+    // Contenu d'une cellule allouée (taille négative)
+    bool Cell(DWORD offset, std::vector<Span>& out, size_t& length) {
+        LONG cellSize = 0;
+        if (!Read(offset, &cellSize, sizeof(cellSize)) || cellSize >= -4) return false;
+        length = static_cast<size_t>(-static_cast<LONGLONG>(cellSize)) - 4;
+        if (length > HIVE_MAX_CELL_SIZE) return false;
+        return Gather(static_cast<ULONGLONG>(offset) + 4, length, out);
+    }
+
+    // Données d'une valeur : cellule directe ou "db" (big data, segments de
+    // BIG_DATA_SEGMENT_SIZE octets listés dans une cellule d'offsets)
+    bool ValueData(DWORD dataOffset, DWORD dataSize, std::vector<Span>& out, std::wstring& error) {
+        BYTE db[8];
+        if (!Read(static_cast<ULONGLONG>(dataOffset) + 4, db, sizeof(db))) {
+            error = L"cellule de données absente du log et du hive primaire";
+            return false;
+        }
+
+        if (dataSize <= BIG_DATA_SEGMENT_SIZE || db[0] != 'd' || db[1] != 'b') {
+            size_t length = 0;
+            if (!Cell(dataOffset, out, length) || length < dataSize) {
+                error = L"cellule de données incomplète";
+                return false;
+            }
+            TrimSpans(out, dataSize);
+            return true;
+        }
+
+        const WORD segments = static_cast<WORD>(db[2] | (db[3] << 8));
+        DWORD listOffset;
+        memcpy(&listOffset, db + 4, sizeof(listOffset));
+        if (static_cast<ULONGLONG>(segments) * BIG_DATA_SEGMENT_SIZE < dataSize) {
+            error = L"liste de segments trop courte";
+            return false;
+        }
+
+        std::vector<DWORD> list(segments);
+        if (!Read(static_cast<ULONGLONG>(listOffset) + 4, list.data(), segments * sizeof(DWORD))) {
+            error = L"liste de segments illisible";
+            return false;
+        }
+
+        size_t remaining = dataSize;
+        for (size_t i = 0; i < list.size() && remaining; i++) {
+            std::vector<Span> cell;
+            size_t length = 0;
+            if (!Cell(list[i], cell, length)) {
+                error = L"segment " + std::to_wstring(i) + L" illisible";
+                return false;
+            }
+            const size_t take = std::min(remaining, std::min(length, BIG_DATA_SEGMENT_SIZE));
+            TrimSpans(cell, take);
+            out.insert(out.end(), cell.begin(), cell.end());
+            remaining -= take;
+        }
+        if (remaining) {
+            error = L"segments incomplets";
+            return false;
+        }
+        return true;
+    }
+
+    static void TrimSpans(std::vector<Span>& spans, size_t length) {
+        for (size_t i = 0; i < spans.size(); i++) {
+            if (spans[i].second >= length) {
+                spans[i].second = length;
+                spans.resize(i + (length ? 1 : 0));
+                return;
+            }
+            length -= spans[i].second;
+        }
+    }
+};
+
+// Chemins des clés modifiées dans un log : chaque cellule "nk" des pages est
+// remontée de parent en parent dans l'image du hive (pages du log, puis hive
+// primaire voisin), et sa liste de valeurs rattache ses cellules "vk" à la clé.
+// Tout est résolu à la construction ; les lectures concurrentes sont sûres.
+class KeyPathResolver {
+    struct KeyCell {
+        WORD flags;
+        DWORD parent;
+        DWORD valueCount;
+        DWORD valueList;
+        std::wstring name;
+    };
+
+    std::unordered_map<DWORD, std::wstring> paths;  // "nk" -> chemin depuis la racine (vide : racine)
+    std::unordered_map<DWORD, DWORD> owners;        // "vk" -> "nk" propriétaire
+
+    static bool ReadKey(HiveImage& image, DWORD offset, KeyCell& key) {
+        LONG cellSize = 0;
+        BYTE nk[NK_FIXED_SIZE];
+        if (!image.Read(offset, &cellSize, sizeof(cellSize)) || cellSize >= 0 ||
+            static_cast<size_t>(-static_cast<LONGLONG>(cellSize)) < 4 + NK_FIXED_SIZE ||
+            !image.Read(static_cast<ULONGLONG>(offset) + 4, nk, sizeof(nk)) || nk[0] != 'n' || nk[1] != 'k') {
+            return false;
+        }
+        const WORD nameLength = static_cast<WORD>(nk[0x48] | (nk[0x49] << 8));
+        if (4 + NK_FIXED_SIZE + nameLength > static_cast<size_t>(-static_cast<LONGLONG>(cellSize))) return false;
+
+        key.flags = static_cast<WORD>(nk[0x02] | (nk[0x03] << 8));
+        memcpy(&key.parent, nk + 0x10, sizeof(DWORD));
+        memcpy(&key.valueCount, nk + 0x24, sizeof(DWORD));
+        memcpy(&key.valueList, nk + 0x28, sizeof(DWORD));
+
+        std::vector<BYTE> name(nameLength);
+        if (!image.Read(static_cast<ULONGLONG>(offset) + 4 + NK_FIXED_SIZE, name.data(), name.size())) return false;
+        key.name.clear();
+        if (key.flags & NK_FLAG_ASCII_NAME) {
+            key.name.assign(name.begin(), name.end());
+        } else {
+            for (size_t i = 0; i + 1 < name.size(); i += 2) key.name += static_cast<wchar_t>(name[i] | (name[i + 1] << 8));
+        }
+        return true;
+    }
+
+    // Remonte jusqu'à la racine ou à un chemin connu, puis redescend en
+    // mémorisant chaque ancêtre ; échoue sur parent illisible, cycle ou profondeur
+    bool Resolve(HiveImage& image, DWORD offset, std::unordered_map<DWORD, std::wstring>& known) {
+        std::vector<std::pair<DWORD, std::wstring>> chain;
+        std::wstring path;
+        for (DWORD at = offset;;) {
+            auto it = known.find(at);
+            if (it != known.end()) {
+                path = it->second;
+                break;
+            }
+            KeyCell key;
+            if (chain.size() >= HIVE_MAX_KEY_DEPTH || !ReadKey(image, at, key)) return false;
+            if (key.flags & NK_FLAG_HIVE_ENTRY) {
+                known.emplace(at, std::wstring());
+                break;
+            }
+            chain.emplace_back(at, std::move(key.name));
+            at = key.parent;
+        }
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            path = path.empty() ? it->second : path + L"\\" + it->second;
+            known.emplace(it->first, path);
+        }
+        return true;
+    }
+
+public:
+    // spans : (offset, taille) des entrées du log dans data ; primaryPath vide
+    // si aucun hive primaire n'accompagne le log
+    template<typename Spans>
+    KeyPathResolver(const BYTE* data, const Spans& spans, const std::wstring& primaryPath) {
+        HiveImage image;
+        std::vector<DWORD> keys;
+        for (const auto& span : spans) {
+            const LOG_ENTRY_HEADER* entry = reinterpret_cast<const LOG_ENTRY_HEADER*>(data + span.first);
+            image.Add(entry->offset, entry->data, span.second - offsetof(LOG_ENTRY_HEADER, data), entry->sequenceNumber);
+            HivePage(entry).ForEachKey([&keys](DWORD offset) { keys.push_back(offset); });
+        }
+        image.Seal();
+        if (!primaryPath.empty()) image.OpenPrimary(primaryPath);
+
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        std::unordered_map<DWORD, std::wstring> known;
+        for (DWORD offset : keys) {
+            KeyCell key;
+            if (!Resolve(image, offset, known) || !ReadKey(image, offset, key)) continue;
+            paths[offset] = known[offset];
+
+            const size_t count = std::min<size_t>(key.valueCount, HIVE_MAX_CELL_SIZE / sizeof(DWORD));
+            std::vector<DWORD> list(count);
+            if (!count || !image.Read(static_cast<ULONGLONG>(key.valueList) + 4, list.data(), count * sizeof(DWORD))) continue;
+            for (DWORD value : list) owners.emplace(value, offset);
+        }
+    }
+
+    size_t Size() const { return paths.size(); }
+
+    // Chemin de la première clé de la page, à défaut de la clé propriétaire de
+    // sa première valeur rattachée
+    bool PagePath(const LOG_ENTRY_HEADER* entry, std::wstring& path) const {
+        const HivePage page(entry);
+        bool found = false;
+        page.ForEachKey([&](DWORD offset) {
+            auto it = found ? paths.end() : paths.find(offset);
+            if (it == paths.end() || it->second.empty()) return;
+            path = it->second;
+            found = true;
+        });
+        page.ForEachValue([&](const ValueCell& cell) {
+            auto owner = found ? owners.end() : owners.find(cell.cellOffset);
+            auto it = owner == owners.end() ? paths.end() : paths.find(owner->second);
+            if (it == paths.end() || it->second.empty()) return;
+            path = it->second;
+            found = true;
+        });
+        return found;
+    }
+};
+
+// Flux en lecture sur une suite de plages mémoire (valeur big data non recopiée)
+class BlobStream {
+    std::vector<HiveImage::Span> chunks;
+    std::vector<size_t> starts;
+    size_t total = 0;
+
+public:
+    explicit BlobStream(std::vector<HiveImage::Span> spans) : chunks(std::move(spans)) {
+        starts.reserve(chunks.size());
+        for (const auto& chunk : chunks) {
+            starts.push_back(total);
+            total += chunk.second;
+        }
+    }
+
+    size_t Size() const { return total; }
+    size_t ChunkCount() const { return chunks.size(); }
+
+    bool Read(size_t pos, void* dst, size_t length) const {
+        if (pos > total || length > total - pos) return false;
+        size_t i = static_cast<size_t>(std::upper_bound(starts.begin(), starts.end(), pos) - starts.begin()) - 1;
+        BYTE* out = static_cast<BYTE*>(dst);
+        while (length) {
+            const size_t inChunk = pos - starts[i];
+            const size_t take = std::min(length, chunks[i].second - inChunk);
+            memcpy(out, chunks[i].first + inChunk, take);
+            out += take;
+            pos += take;
+            length -= take;
+            i++;
+        }
+        return true;
+    }
+
+    template<typename T>
+    bool Get(size_t pos, T& value) const { return Read(pos, &value, sizeof(T)); }
+
+    bool Utf16(size_t pos, size_t bytes, std::wstring& out) const {
+        out.resize(bytes / 2);
+        std::vector<WORD> units(bytes / 2);
+        if (!Read(pos, units.data(), units.size() * sizeof(WORD))) return false;
+        std::copy(units.begin(), units.end(), out.begin());
+        return true;
+    }
+};
+
+// Entrée du cache de compatibilité applicative (ShimCache)
+struct ShimCacheEntry {
+    DWORD position;             // Rang dans le cache (0 = plus récent)
+    std::wstring path;
+    FILETIME lastModified;
+    DWORD insertFlags;
+    bool hasInsertFlags;        // Windows 7/8 uniquement
+};
+
+// Décodage en un passage des formats Windows 7 (x86/x64), 8.0, 8.1 et 10/11
+class ShimCache {
+public:
+    enum class Layout { Unknown, Win7x86, Win7x64, Win8, Win81, Win10 };
+
+    static const wchar_t* LayoutName(Layout layout) {
+        switch (layout) {
+        case Layout::Win7x86: return L"Windows 7 x86";
+        case Layout::Win7x64: return L"Windows 7 x64";
+        case Layout::Win8: return L"Windows 8.0";
+        case Layout::Win81: return L"Windows 8.1";
+        case Layout::Win10: return L"Windows 10/11";
+        default: return L"inconnu";
+        }
+    }
+
+    static Layout Detect(const BlobStream& blob) {
+        DWORD magic = 0, padding = 0;
+        if (!blob.Get(0, magic)) return Layout::Unknown;
+        if (magic == SHIMCACHE_WIN7_MAGIC) {
+            // x64 : offset du chemin sur 8 octets précédé de 4 octets de bourrage nuls
+            if (!blob.Get(SHIMCACHE_WIN7_HEADER + 4, padding)) return Layout::Win7x64;
+            return padding == 0 ? Layout::Win7x64 : Layout::Win7x86;
+        }
+
+        DWORD signature = 0;
+        if (!blob.Get(magic, signature)) return Layout::Unknown;
+        if (magic == SHIMCACHE_WIN8_HEADER) {
+            if (signature == SHIMCACHE_SIG_WIN8) return Layout::Win8;
+            if (signature == SHIMCACHE_SIG_WIN81) return Layout::Win81;
+        }
+        if ((magic == SHIMCACHE_WIN10_HEADER || magic == SHIMCACHE_WIN10_CREATORS_HEADER) && signature == SHIMCACHE_SIG_WIN81) {
+            return Layout::Win10;
+        }
+        return Layout::Unknown;
+    }
+
+    // onEntry(const ShimCacheEntry&) pour chaque entrée ; renvoie le nombre d'entrées
+    template<typename OnEntry>
+    static size_t Parse(const BlobStream& blob, Layout layout, OnEntry onEntry) {
+        ShimCacheEntry entry = {};
+        DWORD count = 0;
+
+        if (layout == Layout::Win7x64 || layout == Layout::Win7x86) {
+            const bool x64 = layout == Layout::Win7x64;
+            const size_t stride = x64 ? 48 : 32;
+            if (!blob.Get(4, count)) return 0;
+
+            for (DWORD i = 0; i < count && i < SHIMCACHE_MAX_ENTRIES; i++) {
+                const size_t pos = SHIMCACHE_WIN7_HEADER + i * stride;
+                WORD length = 0;
+                DWORD pathOffset = 0;
+                if (!blob.Get(pos, length) || !blob.Get(pos + (x64 ? 8 : 4), pathOffset) ||
+                    !blob.Get(pos + (x64 ? 16 : 8), entry.lastModified) ||
+                    !blob.Get(pos + (x64 ? 24 : 16), entry.insertFlags) ||
+                    !blob.Utf16(pathOffset, length, entry.path)) {
+                    return i;
+                }
+                entry.position = i;
+                entry.hasInsertFlags = true;
+                onEntry(entry);
+            }
+            return std::min<size_t>(count, SHIMCACHE_MAX_ENTRIES);
+        }
+
+        if (layout == Layout::Unknown) return 0;
+        const DWORD signature = layout == Layout::Win8 ? SHIMCACHE_SIG_WIN8 : SHIMCACHE_SIG_WIN81;
+        DWORD headerSize = 0;
+        blob.Get(0, headerSize);
+        size_t pos = headerSize;
+
+        DWORD sig = 0, entrySize = 0;
+        while (count < SHIMCACHE_MAX_ENTRIES && blob.Get(pos, sig) && sig == signature && blob.Get(pos + 8, entrySize) &&
+               entrySize <= blob.Size()) {
+            size_t field = pos + 12;
+            WORD length = 0;
+            if (!blob.Get(field, length) || !blob.Utf16(field + 2, length, entry.path)) break;
+            field += 2 + length;
+
+            if (layout == Layout::Win81) {
+                WORD packageLength = 0;
+                if (!blob.Get(field, packageLength)) break;
+                field += 2 + packageLength;
+            }
+            entry.hasInsertFlags = layout != Layout::Win10;
+            if (entry.hasInsertFlags) {
+                if (!blob.Get(field, entry.insertFlags)) break;
+                field += 8; // Drapeaux d'insertion et de shim
+            }
+            if (!blob.Get(field, entry.lastModified)) break;
+
+            entry.position = count++;
+            onEntry(entry);
+            pos += 12 + entrySize;
+        }
+        return count;
+    }
+};
+
+// Instantané immuable du jeu de résultats : une suite de segments figés, partagés
+// entre versions successives. Un instantané publié n'est plus jamais modifié.
+class ResultSnapshot {
+public:
+    using Segment = std::shared_ptr<const RecordVector>;
+
+    ULONGLONG version = 0;      // Incrémentée à chaque publication
+    ULONGLONG generation = 0;   // Incrémentée quand le contenu est remplacé plutôt que prolongé
+
+    size_t size() const { return total; }
+    bool empty() const { return total == 0; }
+
+    const TransactionEntry& operator[](size_t index) const {
+        const size_t s = static_cast<size_t>(std::upper_bound(starts.begin(), starts.end(), index) - starts.begin()) - 1;
+        return (*segments[s])[index - starts[s]];
+    }
+
+    template<typename Fn>
+    void ForEach(Fn fn) const {
+        for (const auto& segment : segments) {
+            for (const auto& tx : *segment) fn(tx);
+        }
+    }
+
+private:
+    friend class SnapshotPublisher;
+
+    void Add(Segment segment) {
+        starts.push_back(total);
+        total += segment->size();
+        segments.push_back(std::move(segment));
+    }
+
+    std::vector<Segment> segments;
+    std::vector<size_t> starts;     // Index global du premier enregistrement de chaque segment
+    size_t total = 0;
+};
+
+// Publication de type RCU : l'écrivain construit la version suivante à côté de la
+// courante puis l'installe par échange atomique. Les lecteurs ne prennent aucun
+// verrou ; une version remplacée est libérée à la prochaine publication survenant
+// sans lecteur actif. Seuls les écrivains (parser, comparaison) se sérialisent.
+class SnapshotPublisher {
+    std::atomic<const ResultSnapshot*> current;
+    std::atomic<LONG> readers;
+    std::vector<const ResultSnapshot*> retired;     // Protégé par writeLock
+    CRITICAL_SECTION writeLock;
+
+    void Install(ResultSnapshot* next) {
+        next->version = current.load()->version + 1;
+        retired.push_back(current.exchange(next));
+
+        // Un lecteur arrivé après ce test lit forcément la nouvelle version
+        if (readers.load() == 0) {
+            for (const ResultSnapshot* snapshot : retired) delete snapshot;
+            retired.clear();
+        }
+    }
+
+public:
+    // Accès en lecture : l'instantané reste valide tant que le Reader existe
+    class Reader {
+        SnapshotPublisher& owner;
+        const ResultSnapshot* snapshot;
+    public:
+        explicit Reader(SnapshotPublisher& publisher) : owner(publisher) {
+            owner.readers++;
+            snapshot = owner.current.load();
+        }
+        ~Reader() { owner.readers--; }
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        const ResultSnapshot& operator*() const { return *snapshot; }
+        const ResultSnapshot* operator->() const { return snapshot; }
+    };
+
+    SnapshotPublisher() : current(new ResultSnapshot()), readers(0) { InitializeCriticalSection(&writeLock); }
+    ~SnapshotPublisher() {
+        for (const ResultSnapshot* snapshot : retired) delete snapshot;
+        delete current.load();
+        DeleteCriticalSection(&writeLock);
+    }
+
+    // Fige les enregistrements en un segment ajouté à la version courante
+    void Append(RecordVector& records) {
+        if (records.empty()) return;
+        ResultSnapshot::Segment segment = std::make_shared<const RecordVector>(std::move(records));
+        records.clear();
+
+        EnterCriticalSection(&writeLock);
+        ResultSnapshot* next = new ResultSnapshot(*current.load());
+        next->Add(std::move(segment));
+        Install(next);
+        LeaveCriticalSection(&writeLock);
+    }
+
+    // Remplace tout le contenu (nouvelle génération)
+    void Replace(RecordVector& records) {
+        ResultSnapshot::Segment segment = std::make_shared<const RecordVector>(std::move(records));
+        records.clear();
+
+        EnterCriticalSection(&writeLock);
+        ResultSnapshot* next = new ResultSnapshot();
+        next->generation = current.load()->generation + 1;
+        if (!segment->empty()) next->Add(std::move(segment));
+        Install(next);
+        LeaveCriticalSection(&writeLock);
+    }
+
+    void Reset() {
+        RecordVector none;
+        Replace(none);
+    }
+};
+
+// Pool de threads partagé par toutes les sessions. Run() soumet un lot de tâches
+// et attend sa fin ; le thread appelant exécute lui aussi des tâches du lot, ce
+// qui évite tout blocage si le pool est déjà occupé par un autre lot. Il ne prend
+// que des tâches de son propre lot : le thread de l'interface (filtre) ne se
+// retrouve pas à exécuter une partition d'un parsing en cours.
+// L'exception d'une tâche est relancée par Run dans le thread appelant.
+class WorkerPool {
+    struct Batch {
+        std::atomic<LONG> remaining;
+        HANDLE hDone;
+        std::exception_ptr error;   // Première exception d'une tâche (protégée par lock), relancée par Run
+    };
+    struct Item {
+        std::function<void()>* task;
+        Batch* batch;
+    };
+
+    std::deque<Item> queue;
+    std::vector<HANDLE> threads;
+    CRITICAL_SECTION lock;
+    HANDLE hWork;                   // Sémaphore : une unité par tâche soumise
+    std::atomic<bool> shutdown;
+
+    // only : lot dont la tâche doit provenir (thread appelant de Run), nullptr pour
+    // les threads du pool
+    bool RunOne(const Batch* only = nullptr) {
+        EnterCriticalSection(&lock);
+        auto it = queue.begin();
+        if (only) it = std::find_if(queue.begin(), queue.end(), [only](const Item& item) { return item.batch == only; });
+        if (it == queue.end()) {
+            LeaveCriticalSection(&lock);
+            return false;
+        }
+        Item item = *it;
+        queue.erase(it);
+        LeaveCriticalSection(&lock);
+
+        try {
+            (*item.task)();
+        } catch (...) {
+            EnterCriticalSection(&lock);
+            if (!item.batch->error) item.batch->error = std::current_exception();
+            LeaveCriticalSection(&lock);
+        }
+        if (--item.batch->remaining == 0) SetEvent(item.batch->hDone);
+        return true;
+    }
+
+    static DWORD WINAPI PoolThreadProc(LPVOID param) {
+        auto* pool = static_cast<WorkerPool*>(param);
+        while (WaitForSingleObject(pool->hWork, INFINITE) == WAIT_OBJECT_0 && !pool->shutdown) {
+            pool->RunOne();
+        }
+        return 0;
+    }
+
+    // Démarrage paresseux : un processus worker n'en a pas forcément besoin
+    void EnsureStarted() {
+        EnterCriticalSection(&lock);
+        if (threads.empty() && hWork) {
+            SYSTEM_INFO si = {};
+            GetSystemInfo(&si);
+            const size_t count = std::max<size_t>(1, std::min<size_t>(si.dwNumberOfProcessors, MAX_SCAN_PARTITIONS));
+            for (size_t i = 0; i < count; i++) {
+                HANDLE hThread = CreateThread(nullptr, 0, PoolThreadProc, this, 0, nullptr);
+                if (hThread) threads.push_back(hThread);
+            }
+        }
+        LeaveCriticalSection(&lock);
+    }
+
+public:
+    WorkerPool() : hWork(CreateSemaphoreW(nullptr, 0, MAXLONG, nullptr)), shutdown(false) {
+        InitializeCriticalSection(&lock);
+    }
+    ~WorkerPool() {
+        shutdown = true;
+        if (!threads.empty()) {
+            ReleaseSemaphore(hWork, static_cast<LONG>(threads.size()), nullptr);
+            WaitForMultipleObjects(static_cast<DWORD>(threads.size()), threads.data(), TRUE, INFINITE);
+            for (HANDLE hThread : threads) CloseHandle(hThread);
+        }
+        if (hWork) CloseHandle(hWork);
+        DeleteCriticalSection(&lock);
+    }
+
+    void Run(std::vector<std::function<void()>>& tasks) {
+        if (tasks.empty()) return;
+        EnsureStarted();
+
+        Batch batch;
+        batch.remaining = static_cast<LONG>(tasks.size());
+        batch.hDone = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (!batch.hDone || threads.empty()) {
+            if (batch.hDone) CloseHandle(batch.hDone);
+            for (auto& task : tasks) task(); // Repli sur le thread courant
+            return;
+        }
+
+        EnterCriticalSection(&lock);
+        for (auto& task : tasks) queue.push_back({ &task, &batch });
+        LeaveCriticalSection(&lock);
+        ReleaseSemaphore(hWork, static_cast<LONG>(tasks.size()), nullptr);
+
+        while (batch.remaining > 0 && RunOne(&batch)) {}
+        WaitForSingleObject(batch.hDone, INFINITE);
+        CloseHandle(batch.hDone);
+        if (batch.error) std::rethrow_exception(batch.error);
+    }
+
+    size_t ThreadCount() const { return threads.size(); }
+};
+
+// Énumération complète d'un hive primaire chargé en mémoire. Les hbins sont
+// localisés par leurs en-têtes puis répartis en plages contiguës, équilibrées en
+// octets, entre les tâches du pool ; chaque tâche relève les cellules "nk"
+// allouées de sa plage. Les plages étant prises dans l'ordre, les clés
+// concaténées restent triées par offset : l'arbre est recousu par recherche
+// dichotomique des offsets parents, puis chaque chemin complet est calculé une
+// seule fois à partir de celui de son parent. Les valeurs sont lues ensuite, clé
+// par clé, directement dans le tampon.
+class HiveWalker {
+public:
+    struct Key {
+        DWORD offset;               // Cellule "nk", relative au début des hbins
+        DWORD parent;
+        WORD flags;
+        FILETIME lastWritten;
+        DWORD subkeyCount;
+        DWORD valueCount;
+        DWORD valueList;
+        std::wstring name;
+        std::wstring path;          // Depuis la racine (vide pour la racine elle-même)
+        bool orphan;                // Parent introuvable : chemin préfixé de <Orphelin>
+    };
+    using KeyVector = std::vector<Key, CountingAllocator<Key, MEM_INDEXES>>;
+
+    struct Stats {
+        size_t hbins = 0;
+        size_t skippedBlocks = 0;   // Blocs sans en-tête "hbin" valide, sondés un à un
+        size_t brokenBins = 0;      // Chaîne de cellules interrompue avant la fin du hbin
+        size_t cells = 0;           // Cellules allouées parcourues
+        size_t orphans = 0;
+        size_t tasks = 0;
+    };
+
+private:
+    const BYTE* hbins;
+    size_t size;
+    DWORD rootOffset;
+    HiveImage image;                // Hbins référencés en place, sans hive de repli
+    KeyVector keys;
+    Stats stats;
+
+    static DWORD Read32(const BYTE* p) {
+        DWORD v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    static WORD Read16(const BYTE* p) { return static_cast<WORD>(p[0] | (p[1] << 8)); }
+
+    static std::wstring Name(const BYTE* name, size_t length, bool ascii) {
+        std::wstring text;
+        if (ascii) {
+            text.assign(name, name + length);
+        } else {
+            text.reserve(length / 2);
+            for (size_t i = 0; i + 1 < length; i += 2) text += static_cast<wchar_t>(name[i] | (name[i + 1] << 8));
+        }
+        return text;
+    }
+
+    bool IsRoot(const Key& key) const { return key.offset == rootOffset || (key.flags & NK_FLAG_HIVE_ENTRY); }
+
+    size_t Find(DWORD offset) const {
+        auto it = std::lower_bound(keys.begin(), keys.end(), offset,
+                                   [](const Key& key, DWORD value) { return key.offset < value; });
+        return it != keys.end() && it->offset == offset ? static_cast<size_t>(it - keys.begin()) : keys.size();
+    }
+
+    // Hbins [début, fin) ; après un en-tête invalide, le bloc suivant est sondé
+    std::vector<ByteRange> LocateBins() {
+        std::vector<ByteRange> bins;
+        size_t pos = 0;
+        while (pos + HBIN_HEADER_SIZE <= size) {
+            const size_t binSize = Read32(hbins + pos + 8);
+            if (Read32(hbins + pos) != HBIN_SIGNATURE || binSize < HBIN_ALIGNMENT || binSize % HBIN_ALIGNMENT ||
+                binSize > size - pos) {
+                stats.skippedBlocks++;
+                pos += HBIN_ALIGNMENT;
+                continue;
+            }
+            bins.emplace_back(pos, pos + binSize);
+            pos += binSize;
+        }
+        stats.hbins = bins.size();
+        return bins;
+    }
+
+    void ScanBins(const ByteRange* first, const ByteRange* last, KeyVector& out, size_t& cells, size_t& broken) const {
+        for (const ByteRange* bin = first; bin != last; ++bin) {
+            for (size_t pos = bin->first + HBIN_HEADER_SIZE; pos + 4 <= bin->second;) {
+                const LONG cellSize = static_cast<LONG>(Read32(hbins + pos));
+                const size_t length = static_cast<size_t>(cellSize < 0 ? -static_cast<LONGLONG>(cellSize) : cellSize);
+                if (length < 8 || length % 8 || length > bin->second - pos) {
+                    broken++;
+                    break;
+                }
+
+                const BYTE* cell = hbins + pos + 4;
+                if (cellSize < 0) {
+                    cells++;
+                    const size_t nameLength = length >= 4 + NK_FIXED_SIZE ? Read16(cell + 0x48) : 0;
+                    if (cell[0] == 'n' && cell[1] == 'k' && length >= 4 + NK_FIXED_SIZE &&
+                        4 + NK_FIXED_SIZE + nameLength <= length) {
+                        Key key;
+                        key.offset = static_cast<DWORD>(pos);
+                        key.flags = Read16(cell + 0x02);
+                        memcpy(&key.lastWritten, cell + 0x04, sizeof(FILETIME));
+                        key.parent = Read32(cell + 0x10);
+                        key.subkeyCount = Read32(cell + 0x14);
+                        key.valueCount = Read32(cell + 0x24);
+                        key.valueList = Read32(cell + 0x28);
+                        key.name = Name(cell + NK_FIXED_SIZE, nameLength, (key.flags & NK_FLAG_ASCII_NAME) != 0);
+                        key.orphan = false;
+                        out.push_back(std::move(key));
+                    }
+                }
+                pos += length;
+            }
+        }
+    }
+
+    // Parents recherchés en parallèle, chemins calculés parent d'abord (une
+    // chaîne de clés non résolues est remontée puis redescendue)
+    void Stitch(WorkerPool& pool) {
+        std::vector<size_t> parents(keys.size());
+        std::vector<std::function<void()>> tasks;
+        for (size_t begin = 0; begin < keys.size(); begin += HIVE_KEYS_PER_TASK) {
+            const size_t end = std::min(keys.size(), begin + HIVE_KEYS_PER_TASK);
+            tasks.push_back([this, &parents, begin, end] {
+                for (size_t i = begin; i < end; i++) parents[i] = IsRoot(keys[i]) ? keys.size() : Find(keys[i].parent);
+            });
+        }
+        pool.Run(tasks);
+
+        enum : BYTE { Pending, Walking, Done };
+        std::vector<BYTE> state(keys.size(), Pending);
+        std::vector<size_t> chain;
+        for (size_t i = 0; i < keys.size(); i++) {
+            chain.clear();
+            for (size_t k = i; k < keys.size() && state[k] == Pending && chain.size() < HIVE_MAX_KEY_DEPTH; k = parents[k]) {
+                state[k] = Walking;
+                chain.push_back(k);
+            }
+
+            for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+                Key& key = keys[*it];
+                const size_t parent = parents[*it];
+                if (IsRoot(key)) {
+                    key.path.clear();
+                } else if (parent < keys.size() && state[parent] == Done) {
+                    const Key& up = keys[parent];
+                    key.orphan = up.orphan;
+                    key.path = up.path.empty() ? key.name : up.path + L"\\" + key.name;
+                } else {
+                    // Parent absent, cycle ou profondeur excessive
+                    wchar_t prefix[40];
+                    swprintf_s(prefix, L"<Orphelin @ 0x%08X>\\", key.parent);
+                    key.orphan = true;
+                    key.path = prefix + key.name;
+                    stats.orphans++;
+                }
+                state[*it] = Done;
+            }
+        }
+    }
+
+public:
+    // Base block "regf" d'un hive primaire (type 0) suivi de son premier hbin
+    static bool IsPrimary(const BYTE* data, size_t dataSize) {
+        if (dataSize < HBIN_BASE_OFFSET + HBIN_HEADER_SIZE) return false;
+        REGF_HEADER base;
+        memcpy(&base, data, sizeof(base));
+        return base.signature == 0x66676572 && base.type == 0 && Read32(data + HBIN_BASE_OFFSET) == HBIN_SIGNATURE;
+    }
+
+    // data doit satisfaire IsPrimary et rester valide pendant toute l'énumération
+    HiveWalker(const BYTE* data, size_t dataSize)
+        : hbins(data + HBIN_BASE_OFFSET), size(static_cast<size_t>(dataSize - HBIN_BASE_OFFSET)), rootOffset(0) {
+        REGF_HEADER base;
+        memcpy(&base, data, sizeof(base));
+        if (base.hiveSize && base.hiveSize < size) size = base.hiveSize;  // Au-delà : reliquat du fichier
+        rootOffset = base.rootCellOffset;
+        image.Add(0, hbins, size, 0);
+        image.Seal();
+    }
+
+    const Stats& Walk(WorkerPool& pool) {
+        const std::vector<ByteRange> bins = LocateBins();
+
+        // Plages contiguës de hbins, coupées à chaque fraction 1/taskCount des octets
+        SYSTEM_INFO si = {};
+        GetSystemInfo(&si);
+        const size_t taskCount = std::max<size_t>(1, std::min<size_t>(
+            { bins.size(), si.dwNumberOfProcessors * HIVE_TASKS_PER_THREAD, size / MIN_PARTITION_SIZE }));
+        std::vector<size_t> cuts(1, 0);
+        for (size_t i = 0; i < bins.size(); i++) {
+            if (cuts.size() < taskCount && bins[i].second * taskCount >= size * cuts.size()) cuts.push_back(i + 1);
+        }
+        if (cuts.back() != bins.size()) cuts.push_back(bins.size());
+
+        const size_t ranges = cuts.size() - 1;
+        std::vector<KeyVector> found(ranges);
+        std::vector<size_t> cells(ranges), broken(ranges);
+        std::vector<std::function<void()>> tasks;
+        for (size_t t = 0; t < ranges; t++) {
+            tasks.push_back([this, &bins, &cuts, &found, &cells, &broken, t] {
+                ScanBins(bins.data() + cuts[t], bins.data() + cuts[t + 1], found[t], cells[t], broken[t]);
+            });
+        }
+        pool.Run(tasks);
+        stats.tasks = ranges;
+
+        size_t total = 0;
+        for (const auto& part : found) total += part.size();
+        keys.reserve(total);
+        for (size_t t = 0; t < ranges; t++) {
+            std::move(found[t].begin(), found[t].end(), std::back_inserter(keys));
+            KeyVector().swap(found[t]);
+            stats.cells += cells[t];
+            stats.brokenBins += broken[t];
+        }
+
+        Stitch(pool);
+        return stats;
+    }
+
+    const KeyVector& Keys() const { return keys; }
+
+    // Contenu d'une cellule allouée (taille négative) contenue dans les hbins
+    bool Cell(DWORD offset, const BYTE*& data, size_t& length) const {
+        if (offset > size || size - offset < 8) return false;
+        const LONG cellSize = static_cast<LONG>(Read32(hbins + offset));
+        if (cellSize >= -4) return false;
+        length = static_cast<size_t>(-static_cast<LONGLONG>(cellSize)) - 4;
+        if (length > size - offset - 4) return false;
+        data = hbins + offset + 4;
+        return true;
+    }
+
+    // fn(offset, cell, vk, vkLength) pour chaque valeur lisible de la clé, vk
+    // désignant le contenu de la cellule "vk" ; renvoie le nombre de valeurs lues
+    template<typename Fn>
+    size_t ForEachValue(const Key& key, Fn fn) const {
+        const BYTE* list = nullptr;
+        size_t listLength = 0;
+        if (!key.valueCount || !Cell(key.valueList, list, listLength)) return 0;
+
+        const size_t count = std::min<size_t>(key.valueCount, listLength / sizeof(DWORD));
+        size_t read = 0;
+        for (size_t i = 0; i < count; i++) {
+            const DWORD offset = Read32(list + i * sizeof(DWORD));
+            const BYTE* vk = nullptr;
+            size_t length = 0;
+            if (!Cell(offset, vk, length) || length < VK_FIXED_SIZE || vk[0] != 'v' || vk[1] != 'k') continue;
+            const size_t nameLength = Read16(vk + 2);
+            if (VK_FIXED_SIZE + nameLength > length) continue;
+
+            ValueCell cell;
+            cell.cellOffset = offset;
+            const DWORD rawSize = Read32(vk + 4);
+            cell.inlineData = (rawSize & 0x80000000) != 0;
+            cell.dataSize = rawSize & 0x7FFFFFFF;
+            cell.dataOffset = Read32(vk + 8);
+            cell.type = Read32(vk + 12);
+            cell.name = Name(vk + VK_FIXED_SIZE, nameLength, (Read16(vk + 16) & VK_FLAG_ASCII_NAME) != 0);
+            if (cell.name.empty()) cell.name = L"(par défaut)";
+            fn(offset, cell, vk, length);
+            read++;
+        }
+        return read;
+    }
+
+    // Données d'une valeur, en place (inline : champ d'offset de la cellule "vk").
+    // L'image n'a pas de hive de repli : appels concurrents sans verrou.
+    bool ValueData(const ValueCell& cell, const BYTE* vk, std::vector<HiveImage::Span>& out, std::wstring& error) {
+        if (!cell.dataSize) return true;
+        if (cell.inlineData) {
+            out.emplace_back(vk + 8, std::min<size_t>(cell.dataSize, sizeof(DWORD)));
+            return true;
+        }
+        return image.ValueData(cell.dataOffset, cell.dataSize, out, error);
+    }
+};
+
+// Vue en colonnes d'un instantané, mise en page Arrow : chaînes UTF-8 avec
+// offsets 64 bits (large_utf8), entiers en tableaux contigus. Construite une
+// colonne par tâche du pool, puis partagée en lecture seule (export Arrow,
+// liaisons Python) ; elle reste valide tant qu'une référence est détenue.
+class ResultColumns {
+public:
+    enum class Type : DWORD { Utf8 = 1, UInt32, UInt64 };
+
+    struct Column {
+        std::wstring name;
+        Type type;
+        std::vector<int64_t, CountingAllocator<int64_t, MEM_RECORDS>> offsets;     // Utf8 : lignes + 1
+        std::vector<char, CountingAllocator<char, MEM_RECORDS>> text;
+        std::vector<DWORD, CountingAllocator<DWORD, MEM_RECORDS>> u32;
+        std::vector<ULONGLONG, CountingAllocator<ULONGLONG, MEM_RECORDS>> u64;
+
+        const void* Values() const {
+            switch (type) {
+            case Type::Utf8: return text.data();
+            case Type::UInt32: return u32.data();
+            default: return u64.data();
+            }
+        }
+    };
+
+    size_t Rows() const { return rows; }
+    const std::vector<Column>& Columns() const { return columns; }
+
+    // Colonnes dans l'ordre de l'export CSV, suivies des colonnes dérivées
+    static std::shared_ptr<const ResultColumns> Build(const ResultSnapshot& snapshot,
+                                                      const std::vector<std::wstring>& derived, WorkerPool& pool) {
+        auto result = std::make_shared<ResultColumns>();
+        result->rows = snapshot.size();
+
+        using Text = std::wstring TransactionEntry::*;
+        using Number = ULONGLONG (*)(const TransactionEntry&);
+        struct Spec { const wchar_t* name; Type type; Text text; Number number; };
+        const Spec specs[] = {
+            { L"Timestamp", Type::Utf8, &TransactionEntry::timestamp, nullptr },
+            { L"HiveFile", Type::Utf8, &TransactionEntry::hiveFile, nullptr },
+            { L"KeyPath", Type::Utf8, &TransactionEntry::keyPath, nullptr },
+            { L"ValueName", Type::Utf8, &TransactionEntry::valueName, nullptr },
+            { L"DataBefore", Type::Utf8, &TransactionEntry::dataBefore, nullptr },
+            { L"DataAfter", Type::Utf8, &TransactionEntry::dataAfter, nullptr },
+            { L"TxID", Type::Utf8, &TransactionEntry::txID, nullptr },
+            { L"Offset", Type::UInt32, nullptr, [](const TransactionEntry& tx) -> ULONGLONG { return tx.offset; } },
+            { L"LogFile", Type::Utf8, &TransactionEntry::logFile, nullptr },
+            { L"FileOffset", Type::UInt64, nullptr, [](const TransactionEntry& tx) -> ULONGLONG { return tx.fileOffset; } },
+            { L"Sequence", Type::UInt32, nullptr, [](const TransactionEntry& tx) -> ULONGLONG { return tx.sequence; } },
+            { L"ContentHash", Type::UInt64, nullptr, [](const TransactionEntry& tx) -> ULONGLONG { return tx.contentHash; } },
+            { L"Artifact", Type::Utf8, &TransactionEntry::artifact, nullptr },
+            { L"Details", Type::Utf8, &TransactionEntry::details, nullptr },
+            { L"Prevalence", Type::UInt32, nullptr, [](const TransactionEntry& tx) -> ULONGLONG { return tx.prevalence; } },
+            { L"FleetHosts", Type::UInt32, nullptr, [](const TransactionEntry& tx) -> ULONGLONG { return tx.fleetHosts; } },
+        };
+
+        const size_t fixed = _countof(specs);
+        result->columns.resize(fixed + derived.size());
+        std::vector<std::function<void()>> tasks;
+        for (size_t c = 0; c < result->columns.size(); c++) {
+            Column& column = result->columns[c];
+            column.name = c < fixed ? specs[c].name : derived[c - fixed];
+            column.type = c < fixed ? specs[c].type : Type::Utf8;
+            const Text text = c < fixed ? specs[c].text : nullptr;
+            const Number number = c < fixed ? specs[c].number : nullptr;
+            const size_t derivedIndex = c - fixed;
+            const ResultSnapshot* source = &snapshot;
+
+            tasks.push_back([&column, text, number, derivedIndex, source] {
+                const size_t rows = source->size();
+                if (column.type == Type::UInt32) {
+                    column.u32.reserve(rows);
+                    source->ForEach([&](const TransactionEntry& tx) { column.u32.push_back(static_cast<DWORD>(number(tx))); });
+                    return;
+                }
+                if (column.type == Type::UInt64) {
+                    column.u64.reserve(rows);
+                    source->ForEach([&](const TransactionEntry& tx) { column.u64.push_back(number(tx)); });
+                    return;
+                }
+
+                static const std::wstring empty;
+                column.offsets.reserve(rows + 1);
+                column.offsets.push_back(0);
+                source->ForEach([&](const TransactionEntry& tx) {
+                    const std::wstring& value = text ? tx.*text
+                                                     : (derivedIndex < tx.derived.size() ? tx.derived[derivedIndex] : empty);
+                    AppendUtf8(value, column.text);
+                    column.offsets.push_back(static_cast<int64_t>(column.text.size()));
+                });
+            });
+        }
+        pool.Run(tasks);
+        return result;
+    }
+
+    template<typename Bytes>
+    static void AppendUtf8(const std::wstring& value, Bytes& out) {
+        for (size_t i = 0; i < value.size(); i++) {
+            DWORD cp = value[i];
+            if (cp >= 0xD800 && cp < 0xDC00 && i + 1 < value.size() && value[i + 1] >= 0xDC00 && value[i + 1] < 0xE000) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (value[++i] - 0xDC00);
+            } else if (cp >= 0xD800 && cp < 0xE000) {
+                cp = 0xFFFD; // Surrogate isolé
+            }
+
+            if (cp < 0x80) {
+                out.push_back(static_cast<char>(cp));
+            } else if (cp < 0x800) {
+                out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+                out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+            } else if (cp < 0x10000) {
+                out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+                out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+            } else {
+                out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+                out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+            }
+        }
+    }
+
+private:
+    size_t rows = 0;
+    std::vector<Column> columns;
+};
+
+// Pool d'entrées décodées, indexé par le hash du contenu brut : une même page
+// présente dans plusieurs logs (LOG1/LOG2, sessions d'un même cas) n'est décodée
+// qu'une fois et son texte est repris tel quel.
+class InternPool {
+    struct Shard {
+        CRITICAL_SECTION lock;
+        std::unordered_map<ULONGLONG, TransactionEntry> entries;
+        Shard() { InitializeCriticalSection(&lock); }
+        ~Shard() { DeleteCriticalSection(&lock); }
+    };
+
+    Shard shards[INTERN_POOL_SHARDS];
+    std::atomic<size_t> count;
+    std::atomic<ULONGLONG> hits, misses;
+
+    Shard& ShardOf(ULONGLONG hash) { return shards[(hash >> 32) % INTERN_POOL_SHARDS]; }
+
+public:
+    InternPool() : count(0), hits(0), misses(0) {}
+
+    bool Find(ULONGLONG hash, TransactionEntry& tx) {
+        Shard& shard = ShardOf(hash);
+        EnterCriticalSection(&shard.lock);
+        auto it = shard.entries.find(hash);
+        const bool found = it != shard.entries.end();
+        if (found) tx = it->second;
+        LeaveCriticalSection(&shard.lock);
+        found ? hits++ : misses++;
+        return found;
+    }
+
+    void Insert(ULONGLONG hash, const TransactionEntry& tx) {
+        if (count >= INTERN_POOL_MAX_ENTRIES) return;
+        Shard& shard = ShardOf(hash);
+        EnterCriticalSection(&shard.lock);
+        if (shard.entries.emplace(hash, tx).second) count++;
+        LeaveCriticalSection(&shard.lock);
+    }
+
+    size_t Size() const { return count; }
+    ULONGLONG Hits() const { return hits; }
+    ULONGLONG Misses() const { return misses; }
+};
+
+// Entrées compressées (.gz, .zst), décompressées en mémoire avant le parsing.
+// gzip : les membres BGZF (champ extra "BC" annonçant la taille du bloc) sont
+// localisés sans décompression puis décodés en parallèle ; un gzip ordinaire,
+// à un ou plusieurs membres, est décodé séquentiellement.
+// zstd : les trames sont délimitées puis décodées en parallèle par libzstd.dll,
+// chargée à l'exécution ; sans elle, l'entrée est refusée.
+class CompressedInput {
+public:
+    enum class Format { None, Gzip, Zstd };
+
+    static Format Detect(const BYTE* data, size_t size) {
+        if (size >= GZIP_MIN_MEMBER && data[0] == 0x1F && data[1] == 0x8B && data[2] == 8) return Format::Gzip;
+        if (size >= sizeof(DWORD) && Read32(data) == ZSTD_MAGIC) return Format::Zstd;
+        return Format::None;
+    }
+
+    // "SYSTEM.LOG1.gz" -> "SYSTEM.LOG1"
+    static std::wstring StripExtension(const std::wstring& name) {
+        for (const wchar_t* ext : { L".gz", L".zst" }) {
+            const size_t len = wcslen(ext);
+            if (name.size() > len && _wcsicmp(name.c_str() + name.size() - len, ext) == 0) {
+                return name.substr(0, name.size() - len);
+            }
+        }
+        return name;
+    }
+
+    static bool Decode(const BYTE* data, size_t size, WorkerPool& pool, AlignedBuffer& out, size_t& outSize,
+                       std::wstring& mode, std::wstring& error) {
+        switch (Detect(data, size)) {
+            case Format::Gzip: return DecodeGzip(data, size, pool, out, outSize, mode, error);
+            case Format::Zstd: return DecodeZstd(data, size, pool, out, outSize, mode, error);
+            default:
+                error = L"Erreur : format compressé non reconnu";
+                return false;
+        }
+    }
+
+private:
+    // Membre gzip ou trame zstd : position, taille compressée, taille décompressée
+    struct Member {
+        size_t offset;
+        size_t length;
+        ULONGLONG rawSize;
+    };
+
+    static DWORD Read32(const BYTE* p) {
+        DWORD v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    // DECOMPRESS_MAX_SIZE borné à l'espace adressable
+    static size_t Budget() { return static_cast<size_t>(std::min<ULONGLONG>(DECOMPRESS_MAX_SIZE, ~static_cast<size_t>(0))); }
+
+    static bool CopyOut(const std::vector<BYTE>& raw, AlignedBuffer& out, size_t& outSize, std::wstring& error) {
+        if (!out.allocate(std::max<size_t>(raw.size(), 1))) {
+            error = L"Erreur : mémoire insuffisante pour la décompression";
+            return false;
+        }
+        if (!raw.empty()) memcpy(out.data(), raw.data(), raw.size());
+        outSize = raw.size();
+        return true;
+    }
+
+    // Décode les membres par lots d'environ DECOMPRESS_TASK_SIZE octets sur le pool,
+    // chacun directement à sa position dans la sortie
+    template<typename DecodeMember>
+    static bool DecodeParallel(const std::vector<Member>& members, WorkerPool& pool, AlignedBuffer& out,
+                               size_t& outSize, std::wstring& error, DecodeMember decodeMember) {
+        // Tailles déclarées par l'entrée (hostile) : chaque membre est borné avant
+        // d'être ajouté, la somme ne peut pas déborder
+        const ULONGLONG budget = Budget();
+        std::vector<ULONGLONG> offsets(members.size() + 1, 0);
+        for (size_t i = 0; i < members.size(); i++) {
+            if (members[i].rawSize > budget - offsets[i]) {
+                error = L"Erreur : taille décompressée excessive";
+                return false;
+            }
+            offsets[i + 1] = offsets[i] + members[i].rawSize;
+        }
+        if (!out.allocate(std::max<size_t>(static_cast<size_t>(offsets.back()), 1))) {
+            error = L"Erreur : mémoire insuffisante pour la décompression";
+            return false;
+        }
+
+        std::atomic<bool> failed(false);
+        std::vector<std::function<void()>> tasks;
+        for (size_t first = 0; first < members.size();) {
+            size_t last = first;
+            while (last < members.size() && offsets[last] - offsets[first] < DECOMPRESS_TASK_SIZE) last++;
+            tasks.push_back([&, first, last] {
+                for (size_t i = first; i < last && !failed; i++) {
+                    if (!decodeMember(members[i], out.data() + offsets[i])) failed = true;
+                }
+            });
+            first = last;
+        }
+        pool.Run(tasks);
+
+        if (failed) {
+            error = L"Erreur : bloc compressé corrompu";
+            return false;
+        }
+        outSize = static_cast<size_t>(offsets.back());
+        return true;
+    }
+
+    // En-tête gzip (RFC 1952) : dataStart reçoit le début du flux DEFLATE,
+    // blockSize la taille totale du membre si l'index BGZF est présent (0 sinon)
+    static bool ParseGzipHeader(const BYTE* p, size_t len, size_t& dataStart, size_t& blockSize) {
+        if (len < GZIP_MIN_MEMBER || p[0] != 0x1F || p[1] != 0x8B || p[2] != 8) return false;
+        const BYTE flags = p[3];
+        size_t pos = 10;
+        blockSize = 0;
+
+        if (flags & GZIP_FEXTRA) {
+            const size_t xlen = p[pos] | (p[pos + 1] << 8);
+            pos += 2;
+            if (len - pos < xlen) return false;
+            for (size_t x = pos; x + 4 <= pos + xlen;) {
+                const size_t slen = p[x + 2] | (p[x + 3] << 8);
+                if (p[x] == 'B' && p[x + 1] == 'C' && slen == 2 && x + 6 <= pos + xlen) {
+                    blockSize = (p[x + 4] | (p[x + 5] << 8)) + 1;
+                }
+                x += 4 + slen;
+            }
+            pos += xlen;
+        }
+        for (BYTE flag : { GZIP_FNAME, GZIP_FCOMMENT }) {
+            if (!(flags & flag)) continue;
+            while (pos < len && p[pos]) pos++;
+            pos++;
+        }
+        if (flags & GZIP_FHCRC) pos += 2;
+
+        if (pos >= len) return false;
+        dataStart = pos;
+        return true;
+    }
+
+    // Décode un membre à la suite de out sans que out dépasse limit octets
+    // (exceeded levé sinon), vérifie CRC-32 et taille
+    static bool InflateMember(const BYTE* p, size_t len, std::vector<BYTE>& out, size_t& memberLen, size_t limit,
+                              bool& exceeded) {
+        size_t dataStart = 0, blockSize = 0, consumed = 0;
+        exceeded = false;
+        if (!ParseGzipHeader(p, len, dataStart, blockSize)) return false;
+
+        const size_t start = out.size();
+        if (!DeflateDecoder::Inflate(p + dataStart, len - dataStart, out, consumed, limit, exceeded)) return false;
+
+        const size_t trailer = dataStart + consumed;
+        if (len - trailer < 8) return false;
+        const size_t rawLen = out.size() - start;
+        if (Read32(p + trailer) != DeflateDecoder::Crc32(out.data() + start, rawLen) ||
+            Read32(p + trailer + 4) != static_cast<DWORD>(rawLen)) {
+            return false;
+        }
+        memberLen = trailer + 8;
+        return true;
+    }
+
+    static bool DecodeGzip(const BYTE* data, size_t size, WorkerPool& pool, AlignedBuffer& out, size_t& outSize,
+                           std::wstring& mode, std::wstring& error) {
+        // Index BGZF : chaque membre annonce sa taille, l'ISIZE de fin donne sa sortie
+        // (au plus BGZF_MAX_BLOCK ; au-delà le fichier est traité en gzip ordinaire)
+        std::vector<Member> members;
+        for (size_t pos = 0; pos < size;) {
+            size_t dataStart = 0, blockSize = 0;
+            if (!ParseGzipHeader(data + pos, size - pos, dataStart, blockSize) ||
+                blockSize < GZIP_MIN_MEMBER || blockSize > size - pos ||
+                Read32(data + pos + blockSize - 4) > BGZF_MAX_BLOCK) {
+                members.clear();
+                break;
+            }
+            members.push_back({ pos, blockSize, Read32(data + pos + blockSize - 4) });
+            pos += blockSize;
+        }
+
+        if (members.size() > 1) {
+            mode = L"gzip BGZF, " + std::to_wstring(members.size()) + L" blocs en parallèle";
+            return DecodeParallel(members, pool, out, outSize, error, [data](const Member& m, BYTE* dst) {
+                std::vector<BYTE> raw;
+                raw.reserve(static_cast<size_t>(m.rawSize));
+                size_t memberLen = 0;
+                bool exceeded = false;
+                if (!InflateMember(data + m.offset, m.length, raw, memberLen, static_cast<size_t>(m.rawSize), exceeded) ||
+                    raw.size() != m.rawSize) {
+                    return false;
+                }
+                if (!raw.empty()) memcpy(dst, raw.data(), raw.size());
+                return true;
+            });
+        }
+
+        // gzip ordinaire : membres enchaînés, décodés l'un après l'autre dans le
+        // budget DECOMPRESS_MAX_SIZE restant
+        const size_t budget = Budget();
+        std::vector<BYTE> raw;
+        size_t pos = 0, count = 0;
+        while (pos < size && Detect(data + pos, size - pos) == Format::Gzip) {
+            size_t memberLen = 0;
+            bool exceeded = false;
+            if (!InflateMember(data + pos, size - pos, raw, memberLen, budget, exceeded)) {
+                error = exceeded ? L"Erreur : taille décompressée excessive" : L"Erreur : flux gzip corrompu";
+                return false;
+            }
+            pos += memberLen;
+            count++;
+        }
+
+        mode = L"gzip séquentiel, " + std::to_wstring(count) + L" membre(s)";
+        return CopyOut(raw, out, outSize, error);
+    }
+
+    struct ZstdApi {
+        typedef size_t (*DecompressFn)(void* dst, size_t dstCapacity, const void* src, size_t srcSize);
+        typedef unsigned (*IsErrorFn)(size_t code);
+        typedef unsigned (*ErrorCodeFn)(size_t code);
+        typedef unsigned long long (*FrameContentSizeFn)(const void* src, size_t srcSize);
+        typedef size_t (*FrameCompressedSizeFn)(const void* src, size_t srcSize);
+
+        DecompressFn decompress = nullptr;
+        IsErrorFn isError = nullptr;
+        ErrorCodeFn errorCode = nullptr;
+        FrameContentSizeFn frameContentSize = nullptr;
+        FrameCompressedSizeFn frameCompressedSize = nullptr;
+
+        ZstdApi() {
+            HMODULE hZstd = LoadLibraryW(L"libzstd.dll"); // Conservée jusqu'à la fin du processus
+            if (!hZstd) return;
+            decompress = reinterpret_cast<DecompressFn>(GetProcAddress(hZstd, "ZSTD_decompress"));
+            isError = reinterpret_cast<IsErrorFn>(GetProcAddress(hZstd, "ZSTD_isError"));
+            errorCode = reinterpret_cast<ErrorCodeFn>(GetProcAddress(hZstd, "ZSTD_getErrorCode"));
+            frameContentSize = reinterpret_cast<FrameContentSizeFn>(GetProcAddress(hZstd, "ZSTD_getFrameContentSize"));
+            frameCompressedSize = reinterpret_cast<FrameCompressedSizeFn>(GetProcAddress(hZstd, "ZSTD_findFrameCompressedSize"));
+        }
+
+        bool loaded() const { return decompress && isError && errorCode && frameContentSize && frameCompressedSize; }
+    };
+
+    static const ZstdApi& Zstd() {
+        static const ZstdApi api;
+        return api;
+    }
+
+    static bool DecodeZstd(const BYTE* data, size_t size, WorkerPool& pool, AlignedBuffer& out, size_t& outSize,
+                           std::wstring& mode, std::wstring& error) {
+        const ZstdApi& zstd = Zstd();
+        if (!zstd.loaded()) {
+            error = L"Erreur : libzstd.dll introuvable (requise pour les entrées .zst)";
+            return false;
+        }
+
+        // Délimitation des trames (trames sautables comprises)
+        std::vector<Member> frames;
+        bool sizesKnown = true;
+        for (size_t pos = 0; pos < size;) {
+            const size_t frameLen = zstd.frameCompressedSize(data + pos, size - pos);
+            if (zstd.isError(frameLen) || frameLen == 0) {
+                error = L"Erreur : trame zstd corrompue";
+                return false;
+            }
+            const ULONGLONG content = zstd.frameContentSize(data + pos, frameLen);
+            if (content == ZSTD_CONTENTSIZE_UNKNOWN || content == ZSTD_CONTENTSIZE_ERROR) sizesKnown = false;
+            frames.push_back({ pos, frameLen, content });
+            pos += frameLen;
+        }
+
+        if (sizesKnown) {
+            mode = L"zstd, " + std::to_wstring(frames.size()) + L" trame(s) en parallèle";
+            return DecodeParallel(frames, pool, out, outSize, error, [&zstd, data](const Member& f, BYTE* dst) {
+                const size_t written = zstd.decompress(dst, static_cast<size_t>(f.rawSize), data + f.offset, f.length);
+                return !zstd.isError(written) && written == f.rawSize;
+            });
+        }
+
+        // Taille absente d'au moins une trame : décodage séquentiel, capacité doublée
+        // tant que seule la place manque, dans le budget DECOMPRESS_MAX_SIZE
+        const size_t budget = Budget();
+        std::vector<BYTE> raw;
+        for (const Member& f : frames) {
+            const size_t start = raw.size();
+            size_t capacity = std::min(budget - start, std::max<size_t>(f.length * 4, DECOMPRESS_TASK_SIZE));
+            for (;;) {
+                raw.resize(start + capacity);
+                const size_t written = zstd.decompress(raw.data() + start, capacity, data + f.offset, f.length);
+                if (!zstd.isError(written)) {
+                    raw.resize(start + written);
+                    break;
+                }
+                raw.resize(start);
+                if (zstd.errorCode(written) != ZSTD_ERROR_DST_SIZE_TOO_SMALL) {
+                    error = L"Erreur : trame zstd corrompue";
+                    return false;
+                }
+                if (capacity == budget - start) {
+                    error = L"Erreur : taille décompressée excessive";
+                    return false;
+                }
+                capacity = capacity > (budget - start) / 2 ? budget - start : capacity * 2;
+            }
+        }
+
+        mode = L"zstd séquentiel, " + std::to_wstring(frames.size()) + L" trame(s) sans taille annoncée";
+        return CopyOut(raw, out, outSize, error);
+    }
+};
+
+// Index d'un fichier LOG déjà parcouru : positions des entrées valides et plages
+// ignorées. Identifié par chemin, taille et date de modification ; un fichier
+// inchangé ajouté à une autre session est décodé sans être reparcouru.
+struct LogIndex {
+    std::vector<std::pair<size_t, DWORD>> spans;
+    ByteRanges skipped;
+};
+
+// Identité d'un hive : déduite du chemin embarqué dans le base block (le nom du
+// fichier de preuve peut avoir été renommé par l'outil de collecte), à défaut du
+// nom de fichier.
+struct HiveIdentity {
+    std::wstring name;          // "SYSTEM", "NTUSER.DAT"...
+    std::wstring kind;          // Système, utilisateur, classes utilisateur...
+    std::wstring profile;       // Profil propriétaire des hives utilisateur
+    std::wstring embeddedPath;  // Tel que lu dans le base block
+    DWORD fileType = 0;         // 0 : hive primaire, 1/2/6 : journal de transactions
+
+    // Libellé de regroupement : les journaux d'un même hive partagent le même
+    std::wstring Label() const { return profile.empty() ? name : name + L" (" + profile + L")"; }
+
+    static HiveIdentity Resolve(const BYTE* data, size_t size, const std::wstring& path) {
+        HiveIdentity id;
+        const REGF_HEADER* base = reinterpret_cast<const REGF_HEADER*>(data);
+        if (size >= sizeof(REGF_HEADER) && base->signature == 0x66676572) { // "regf"
+            id.fileType = base->type;
+            for (size_t i = 0; i < _countof(base->fileName) && base->fileName[i]; i++) {
+                const wchar_t ch = base->fileName[i];
+                if (ch < 32) {
+                    id.embeddedPath.clear(); // Base block abîmé : chemin inexploitable
+                    break;
+                }
+                id.embeddedPath += ch;
+            }
+        }
+
+        const size_t slash = id.embeddedPath.find_last_of(L'\\');
+        id.name = slash == std::wstring::npos ? id.embeddedPath : id.embeddedPath.substr(slash + 1);
+        if (id.name.empty()) id.name = NameFromFileName(path);
+        id.name = Upper(id.name);
+
+        static const wchar_t* systemHives[] = { L"SYSTEM", L"SOFTWARE", L"SAM", L"SECURITY", L"DEFAULT",
+                                                L"COMPONENTS", L"DRIVERS", L"ELAM", L"BBI", L"BCD-TEMPLATE" };
+        if (std::any_of(std::begin(systemHives), std::end(systemHives),
+                        [&id](const wchar_t* hive) { return id.name == hive; })) {
+            id.kind = L"Système";
+        } else if (id.name == L"NTUSER.DAT") {
+            id.kind = L"Utilisateur";
+            // Dossier parent complet (précédé d'un séparateur) : c'est le profil
+            if (slash != std::wstring::npos) {
+                const size_t parent = id.embeddedPath.find_last_of(L'\\', slash - 1);
+                if (parent != std::wstring::npos && parent + 1 < slash) {
+                    id.profile = id.embeddedPath.substr(parent + 1, slash - parent - 1);
+                }
+            }
+        } else if (id.name == L"USRCLASS.DAT") {
+            id.kind = L"Classes utilisateur";
+        } else if (id.name == L"AMCACHE.HVE") {
+            id.kind = L"Amcache";
+        } else {
+            id.kind = L"Autre";
+        }
+
+        // Chemin tronqué dans le base block : le profil est cherché dans le chemin de la preuve
+        if (id.profile.empty() && (id.name == L"NTUSER.DAT" || id.name == L"USRCLASS.DAT")) {
+            id.profile = ProfileFromPath(path);
+        }
+        return id;
+    }
+
+private:
+    static std::wstring Upper(std::wstring s) {
+        std::transform(s.begin(), s.end(), s.begin(), [](wchar_t c) { return static_cast<wchar_t>(std::towupper(c)); });
+        return s;
+    }
+
+    // Repli : nom de fichier sans extension de compression ni suffixe .LOG/.LOG1/.LOG2
+    static std::wstring NameFromFileName(const std::wstring& path) {
+        std::wstring name = CompressedInput::StripExtension(PathFindFileNameW(path.c_str()));
+        for (const wchar_t* suffix : { L".LOG1", L".LOG2", L".LOG" }) {
+            const size_t len = wcslen(suffix);
+            if (name.size() > len && _wcsicmp(name.c_str() + name.size() - len, suffix) == 0) {
+                return name.substr(0, name.size() - len);
+            }
+        }
+        return name;
+    }
+
+    // "...\Users\<profil>\..." dans le chemin de la preuve
+    static std::wstring ProfileFromPath(const std::wstring& path) {
+        const std::wstring upper = Upper(path);
+        const size_t users = upper.rfind(L"\\USERS\\");
+        if (users == std::wstring::npos) return std::wstring();
+        const size_t start = users + 7;
+        const size_t end = path.find(L'\\', start);
+        return end == std::wstring::npos ? std::wstring() : path.substr(start, end - start);
+    }
+};
+
+// Cache de données dérivées d'un fichier, identifié par chemin, taille et date de
+// modification : index d'entrées, identité du hive.
+template<typename T>
+class FileCache {
+    std::map<std::wstring, std::shared_ptr<const T>> items;
+    CRITICAL_SECTION lock;
+
+public:
+    FileCache() { InitializeCriticalSection(&lock); }
+    ~FileCache() { DeleteCriticalSection(&lock); }
+
+    static std::wstring Identity(const std::wstring& path) {
+        WIN32_FILE_ATTRIBUTE_DATA fad = {};
+        if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &fad)) return std::wstring();
+
+        std::wstring key = path;
+        std::transform(key.begin(), key.end(), key.begin(),
+                       [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+        wchar_t suffix[64];
+        swprintf_s(suffix, L"|%08X%08X|%08X%08X", fad.nFileSizeHigh, fad.nFileSizeLow,
+                   fad.ftLastWriteTime.dwHighDateTime, fad.ftLastWriteTime.dwLowDateTime);
+        return key + suffix;
+    }
+
+    std::shared_ptr<const T> Find(const std::wstring& identity) {
+        EnterCriticalSection(&lock);
+        auto it = items.find(identity);
+        std::shared_ptr<const T> item = it != items.end() ? it->second : nullptr;
+        LeaveCriticalSection(&lock);
+        return item;
+    }
+
+    void Store(const std::wstring& identity, std::shared_ptr<const T> item) {
+        EnterCriticalSection(&lock);
+        items[identity] = std::move(item);
+        LeaveCriticalSection(&lock);
+    }
+
+    void Erase(const std::wstring& identity) {
+        EnterCriticalSection(&lock);
+        items.erase(identity);
+        LeaveCriticalSection(&lock);
+    }
+
+    size_t Size() {
+        EnterCriticalSection(&lock);
+        size_t size = items.size();
+        LeaveCriticalSection(&lock);
+        return size;
+    }
+};
+
+using LogIndexCache = FileCache<LogIndex>;
+using HiveIdentityCache = FileCache<HiveIdentity>;
+
+// Histogrammes d'activité d'une session : enregistrements par seconde et par
+// minute de Timestamp, par hive et tous hives confondus, tenus à jour à chaque
+// publication (seuls les enregistrements publiés depuis la précédente sont
+// comptés ; un remplacement du contenu repart de zéro). Seules les heures
+// d'événement réelles (dernière écriture de clé, ShimCache) sont comptées :
+// l'heure de décodage des entrées de log mesurerait le débit du parseur, ces
+// entrées sont non datées et n'entrent pas dans la détection de rafales. Les
+// lecteurs (interface, bibliothèque) obtiennent des copies sous verrou.
+//
+// Rafales : parcours chronologique des secondes d'un hive avec une base en
+// moyenne/variance mobiles exponentielles (les secondes vides comptent pour
+// zéro). Une seconde dépassant base + BURST_SIGMAS écarts-types et
+// BURST_MIN_RECORDS est anormale et n'alimente pas la base ; les secondes
+// anormales distantes d'au plus BURST_MERGE_GAP forment une même rafale.
+class ActivityHistograms {
+public:
+    using Bins = std::map<int64_t, DWORD, std::less<int64_t>, CountingAllocator<std::pair<const int64_t, DWORD>, MEM_INDEXES>>;
+
+    struct Series {
+        Bins seconds;
+        Bins minutes;           // Clé : début de la minute
+        ULONGLONG records = 0;
+        ULONGLONG undated = 0;  // Timestamp illisible ou heure de décodage
+    };
+
+    struct Burst {
+        std::wstring hive;
+        int64_t begin = 0, end = 0;     // Secondes, end incluse
+        ULONGLONG records = 0;
+        DWORD peak = 0;                 // Enregistrements de la seconde la plus dense
+        double baseline = 0.0;          // Base au début de la rafale
+    };
+
+private:
+    mutable CRITICAL_SECTION lock;
+    std::map<std::wstring, Series> hives;
+    Series total;
+    ULONGLONG generation = 0;
+    size_t counted = 0;
+
+    static void Count(Series& series, int64_t second) {
+        series.records++;
+        series.seconds[second]++;
+        const int64_t minute = second - ((second % ACTIVITY_MINUTE) + ACTIVITY_MINUTE) % ACTIVITY_MINUTE;
+        series.minutes[minute]++;
+    }
+
+    static void Detect(const std::wstring& hive, const Bins& seconds, std::vector<Burst>& bursts) {
+        double mean = 0.0, variance = 0.0;
+        size_t active = 0;
+        int64_t previous = 0;
+        bool open = false;
+        auto feed = [&mean, &variance](double x) {
+            const double diff = x - mean;
+            const double increment = BURST_EWMA_ALPHA * diff;
+            mean += increment;
+            variance = (1.0 - BURST_EWMA_ALPHA) * (variance + diff * increment);
+        };
+
+        for (const auto& bin : seconds) {
+            if (active) {
+                const int64_t silence = bin.first - previous - 1;
+                if (silence > BURST_DECAY_LIMIT) {
+                    mean = variance = 0.0;
+                } else {
+                    for (int64_t i = 0; i < silence; i++) feed(0.0);
+                }
+            }
+            previous = bin.first;
+
+            const double threshold = mean + BURST_SIGMAS * std::sqrt(variance);
+            const bool abnormal = active >= BURST_WARMUP_SECONDS && bin.second >= BURST_MIN_RECORDS &&
+                                  bin.second > threshold;
+            active++;
+            if (!abnormal) {
+                feed(bin.second);
+                continue;
+            }
+
+            if (open && bin.first - bursts.back().end <= BURST_MERGE_GAP) {
+                Burst& burst = bursts.back();
+                burst.end = bin.first;
+                burst.records += bin.second;
+                burst.peak = std::max(burst.peak, bin.second);
+            } else {
+                Burst burst;
+                burst.hive = hive;
+                burst.begin = burst.end = bin.first;
+                burst.records = bin.second;
+                burst.peak = bin.second;
+                burst.baseline = mean;
+                bursts.push_back(std::move(burst));
+                open = true;
+            }
+        }
+    }
+
+public:
+    ActivityHistograms() { InitializeCriticalSection(&lock); }
+    ~ActivityHistograms() { DeleteCriticalSection(&lock); }
+    ActivityHistograms(const ActivityHistograms&) = delete;
+    ActivityHistograms& operator=(const ActivityHistograms&) = delete;
+
+    // Compte les enregistrements publiés depuis le dernier appel
+    void Update(const ResultSnapshot& snapshot) {
+        EnterCriticalSection(&lock);
+        if (generation != snapshot.generation || counted > snapshot.size()) {
+            hives.clear();
+            total = Series();
+            generation = snapshot.generation;
+            counted = 0;
+        }
+        for (; counted < snapshot.size(); counted++) {
+            const TransactionEntry& tx = snapshot[counted];
+            Series& series = hives[tx.hiveFile];
+            int64_t second = 0;
+            if (!ParseEventTime(tx.timestamp.data(), tx.timestamp.size(), second)) {
+                series.undated++;
+                total.undated++;
+                continue;
+            }
+            Count(series, second);
+            Count(total, second);
+        }
+        LeaveCriticalSection(&lock);
+    }
+
+    // Histogramme d'un hive (vide : tous) à la seconde ou à la minute
+    bool Histogram(const std::wstring& hive, bool perMinute, std::vector<std::pair<int64_t, DWORD>>& bins) const {
+        bins.clear();
+        EnterCriticalSection(&lock);
+        auto it = hives.find(hive);
+        const Series* series = hive.empty() ? &total : it != hives.end() ? &it->second : nullptr;
+        if (series) {
+            const Bins& source = perMinute ? series->minutes : series->seconds;
+            bins.assign(source.begin(), source.end());
+        }
+        LeaveCriticalSection(&lock);
+        return series != nullptr;
+    }
+
+    // Enregistrements sans heure d'événement, tous hives confondus
+    ULONGLONG Undated() const {
+        EnterCriticalSection(&lock);
+        const ULONGLONG undated = total.undated;
+        LeaveCriticalSection(&lock);
+        return undated;
+    }
+
+    std::vector<std::wstring> Hives() const {
+        std::vector<std::wstring> names;
+        EnterCriticalSection(&lock);
+        for (const auto& hive : hives) names.push_back(hive.first);
+        LeaveCriticalSection(&lock);
+        return names;
+    }
+
+    // Rafales de tous les hives, par début croissant
+    std::vector<Burst> Bursts() const {
+        std::vector<Burst> bursts;
+        EnterCriticalSection(&lock);
+        for (const auto& hive : hives) Detect(hive.first, hive.second.seconds, bursts);
+        LeaveCriticalSection(&lock);
+        std::stable_sort(bursts.begin(), bursts.end(), [](const Burst& a, const Burst& b) { return a.begin < b.begin; });
+        return bursts;
+    }
+};
+
+// Session de parsing : un fichier ou dossier de logs et ses résultats publiés
+struct ParseSession {
+    std::wstring path;
+    std::wstring label;
+    SnapshotPublisher results;
+    ActivityHistograms activity;
+};
+
+// Greffons de décodage (RegistryTransactionLogParserPlugin.h). Chaque greffon
+// reçoit des lots de PLUGIN_BATCH_ROWS lignes en colonnes ; ses colonnes
+// dérivées sont rangées à la suite de celles des greffons précédents dans
+// TransactionEntry::derived.
+class PluginHost {
+public:
+    using ResultRow = std::pair<size_t, TransactionEntry>;
+
+private:
+    struct Plugin {
+        HMODULE module;
+        RTLP_PLUGIN_INFO info;
+        std::wstring name;
+        size_t firstColumn;
+        CRITICAL_SECTION lock;              // Sérialise les greffons non réentrants
+        std::atomic<size_t> batches{ 0 };
+        std::atomic<size_t> failures{ 0 };
+
+        Plugin() : module(nullptr), info(), firstColumn(0) { InitializeCriticalSection(&lock); }
+        ~Plugin() {
+            if (info.shutdown) info.shutdown(info.state);
+            if (module) FreeLibrary(module);
+            DeleteCriticalSection(&lock);
+        }
+    };
+
+    struct Sink {
+        ResultRow* rows;
+        uint32_t count;
+        size_t firstColumn;
+        uint32_t columns;
+    };
+
+    std::vector<std::unique_ptr<Plugin>> plugins;
+    std::vector<std::wstring> columns;
+
+    static void RTLP_CALL SetDerived(void* sink, uint32_t column, uint32_t row, const wchar_t* text, uint32_t length) {
+        const Sink* s = static_cast<const Sink*>(sink);
+        if (column >= s->columns || row >= s->count || (!text && length)) return;
+        s->rows[row].second.derived[s->firstColumn + column].assign(text ? text : L"", length);
+    }
+
+    // Vue en colonnes d'une plage de lignes : pointeurs vers les chaînes existantes
+    struct Columns {
+        std::vector<const wchar_t*> text[5];
+        std::vector<uint32_t> length[5];
+        std::vector<uint64_t> fileOffset, contentHash;
+        std::vector<uint32_t> sequence;
+        std::vector<RTLP_PAGE_SPAN> pages;
+
+        void Build(const ResultRow* rows, size_t count, const BYTE* data) {
+            for (auto& t : text) t.resize(count);
+            for (auto& l : length) l.resize(count);
+            fileOffset.resize(count);
+            contentHash.resize(count);
+            sequence.resize(count);
+            pages.resize(count);
+
+            for (size_t i = 0; i < count; i++) {
+                const TransactionEntry& tx = rows[i].second;
+                const std::wstring* fields[5] = { &tx.keyPath, &tx.valueName, &tx.dataAfter, &tx.artifact, &tx.details };
+                for (size_t f = 0; f < 5; f++) {
+                    text[f][i] = fields[f]->c_str();
+                    length[f][i] = static_cast<uint32_t>(fields[f]->size());
+                }
+                fileOffset[i] = tx.fileOffset;
+                contentHash[i] = tx.contentHash;
+                sequence[i] = tx.sequence;
+
+                const LOG_ENTRY_HEADER* entry = reinterpret_cast<const LOG_ENTRY_HEADER*>(data + rows[i].first);
+                pages[i].data = entry->data;
+                pages[i].size = entry->size - static_cast<uint32_t>(offsetof(LOG_ENTRY_HEADER, data));
+                pages[i].hiveOffset = entry->offset;
+            }
+        }
+
+        RTLP_STRING_COLUMN Column(size_t f) const { return { text[f].data(), length[f].data() }; }
+    };
+
+public:
+    PluginHost() = default;
+    PluginHost(const PluginHost&) = delete;
+    PluginHost& operator=(const PluginHost&) = delete;
+
+    // Charge les DLL du dossier ; messages reçoit le bilan de chaque fichier
+    size_t Load(const std::wstring& directory, std::vector<std::wstring>& messages) {
+        WIN32_FIND_DATAW fd = {};
+        HANDLE hFind = FindFirstFileW((directory + L"\\*.dll").c_str(), &fd);
+        if (hFind == INVALID_HANDLE_VALUE) return 0;
+
+        size_t loaded = 0;
+        do {
+            const std::wstring path = directory + L"\\" + fd.cFileName;
+            HMODULE module = LoadLibraryW(path.c_str());
+            auto init = module ? reinterpret_cast<RTLP_PLUGIN_INIT>(GetProcAddress(module, RTLP_PLUGIN_INIT_EXPORT)) : nullptr;
+            if (!init) {
+                messages.push_back(L"Greffon ignoré (" + std::wstring(module ? L"sans RtlpPluginInit" : L"chargement impossible")
+                                   + L") : " + fd.cFileName);
+                if (module) FreeLibrary(module);
+                continue;
+            }
+
+            auto plugin = std::make_unique<Plugin>();
+            plugin->module = module;
+            plugin->info = {};
+            plugin->info.structSize = sizeof(RTLP_PLUGIN_INFO);
+            std::wstring refusal;
+            if (init(RTLP_PLUGIN_ABI_VERSION, &plugin->info) != 0) {
+                refusal = L"initialisation refusée";
+            } else if (plugin->info.abiVersion != RTLP_PLUGIN_ABI_VERSION) {
+                refusal = L"version d'ABI " + std::to_wstring(plugin->info.abiVersion) + L", attendue "
+                          + std::to_wstring(RTLP_PLUGIN_ABI_VERSION);
+            } else if (!plugin->info.processBatch) {
+                refusal = L"sans processBatch";
+            } else if (plugin->info.derivedColumnCount && !plugin->info.derivedColumns) {
+                refusal = std::to_wstring(plugin->info.derivedColumnCount) + L" colonnes dérivées sans noms";
+            }
+            if (!refusal.empty()) {
+                messages.push_back(L"Greffon refusé (" + refusal + L") : " + fd.cFileName);
+                continue; // ~Plugin appelle shutdown s'il a été fourni
+            }
+
+            plugin->name = plugin->info.name ? plugin->info.name : fd.cFileName;
+            plugin->firstColumn = columns.size();
+            for (uint32_t i = 0; i < plugin->info.derivedColumnCount; i++) {
+                columns.push_back(plugin->info.derivedColumns[i] ? plugin->info.derivedColumns[i] : L"");
+            }
+            messages.push_back(L"Greffon chargé : " + plugin->name + L" (" + std::to_wstring(plugin->info.derivedColumnCount)
+                               + L" colonnes dérivées"
+                               + ((plugin->info.flags & RTLP_PLUGIN_THREAD_SAFE) ? L", réentrant)" : L")"));
+            plugins.push_back(std::move(plugin));
+            loaded++;
+        } while (FindNextFileW(hFind, &fd));
+        FindClose(hFind);
+        return loaded;
+    }
+
+    bool Empty() const { return plugins.empty(); }
+    const std::vector<std::wstring>& DerivedColumns() const { return columns; }
+
+    // Passe un lot à tous les greffons, dans l'ordre de chargement. data est le
+    // contenu du LOG ; rows[i].first y désigne l'entrée de la ligne.
+    void ProcessBatch(ResultRow* rows, size_t count, const BYTE* data, const std::wstring& hive,
+                      const std::wstring& logFile) const {
+        if (plugins.empty() || !count) return;
+        for (size_t i = 0; i < count; i++) rows[i].second.derived.resize(columns.size());
+
+        Columns cols;
+        cols.Build(rows, count, data);
+
+        RTLP_BATCH batch = {};
+        batch.structSize = sizeof(RTLP_BATCH);
+        batch.rows = static_cast<uint32_t>(count);
+        batch.hive = hive.c_str();
+        batch.logFile = logFile.c_str();
+        batch.keyPath = cols.Column(0);
+        batch.valueName = cols.Column(1);
+        batch.dataAfter = cols.Column(2);
+        batch.artifact = cols.Column(3);
+        batch.details = cols.Column(4);
+        batch.fileOffset = cols.fileOffset.data();
+        batch.sequence = cols.sequence.data();
+        batch.contentHash = cols.contentHash.data();
+        batch.pages = cols.pages.data();
+        batch.setDerived = SetDerived;
+
+        for (const auto& plugin : plugins) {
+            Sink sink = { rows, batch.rows, plugin->firstColumn, plugin->info.derivedColumnCount };
+            batch.sink = &sink;
+
+            const bool serialize = !(plugin->info.flags & RTLP_PLUGIN_THREAD_SAFE);
+            if (serialize) EnterCriticalSection(&plugin->lock);
+            const int status = plugin->info.processBatch(plugin->info.state, &batch);
+            if (serialize) LeaveCriticalSection(&plugin->lock);
+
+            plugin->batches++;
+            if (status != 0) plugin->failures++;
+        }
+    }
+
+    // Bilan depuis le dernier appel (lots traités, échecs)
+    std::vector<std::wstring> TakeStats() const {
+        std::vector<std::wstring> lines;
+        for (const auto& plugin : plugins) {
+            const size_t batches = plugin->batches.exchange(0), failures = plugin->failures.exchange(0);
+            if (!batches) continue;
+            lines.push_back(L"Greffon " + plugin->name + L" : " + std::to_wstring(batches) + L" lots"
+                            + (failures ? L", " + std::to_wstring(failures) + L" en échec" : L""));
+        }
+        return lines;
+    }
+};
+
+// Brassage final de splitmix64 : répartit les bits d'une empreinte FNV
+inline ULONGLONG Mix64(ULONGLONG value) {
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+// Count-min sketch à mise à jour conservatrice : l'estimation est par excès,
+// jamais par défaut. Deux sketches de mêmes dimensions fusionnent par addition.
+class CountMinSketch {
+    std::vector<DWORD, CountingAllocator<DWORD, MEM_INDEXES>> counters;
+
+    static void Cells(ULONGLONG hash, size_t* cells) {
+        const ULONGLONG h1 = Mix64(hash);
+        const ULONGLONG h2 = Mix64(h1) | 1;
+        for (size_t d = 0; d < RARITY_CMS_DEPTH; d++) {
+            cells[d] = d * RARITY_CMS_WIDTH + static_cast<size_t>((h1 + d * h2) % RARITY_CMS_WIDTH);
+        }
+    }
+
+public:
+    CountMinSketch() : counters(RARITY_CMS_WIDTH * RARITY_CMS_DEPTH, 0) {}
+
+    // Seuls les compteurs au minimum sont incrémentés
+    void Add(ULONGLONG hash) {
+        size_t cells[RARITY_CMS_DEPTH];
+        Cells(hash, cells);
+        DWORD minimum = MAXDWORD;
+        for (size_t d = 0; d < RARITY_CMS_DEPTH; d++) minimum = std::min(minimum, counters[cells[d]]);
+        if (minimum == MAXDWORD) return;
+        for (size_t d = 0; d < RARITY_CMS_DEPTH; d++) {
+            if (counters[cells[d]] == minimum) counters[cells[d]]++;
+        }
+    }
+
+    DWORD Estimate(ULONGLONG hash) const {
+        size_t cells[RARITY_CMS_DEPTH];
+        Cells(hash, cells);
+        DWORD minimum = MAXDWORD;
+        for (size_t d = 0; d < RARITY_CMS_DEPTH; d++) minimum = std::min(minimum, counters[cells[d]]);
+        return minimum;
+    }
+
+    void Merge(const CountMinSketch& other) {
+        for (size_t i = 0; i < counters.size(); i++) {
+            counters[i] = static_cast<DWORD>(std::min<ULONGLONG>(MAXDWORD, static_cast<ULONGLONG>(counters[i]) + other.counters[i]));
+        }
+    }
+
+    DWORD* data() { return counters.data(); }
+    const DWORD* data() const { return counters.data(); }
+    size_t bytes() const { return counters.size() * sizeof(DWORD); }
+};
+
+// HyperLogLog (2^RARITY_HLL_PRECISION registres) ; fusion par maximum registre à registre
+class HyperLogLog {
+    std::vector<BYTE, CountingAllocator<BYTE, MEM_INDEXES>> registers;
+
+public:
+    HyperLogLog() : registers(size_t(1) << RARITY_HLL_PRECISION, 0) {}
+
+    void Add(ULONGLONG hash) {
+        const ULONGLONG h = Mix64(hash);
+        const size_t index = static_cast<size_t>(h >> (64 - RARITY_HLL_PRECISION));
+        ULONGLONG rest = h << RARITY_HLL_PRECISION;
+        BYTE rank = 1;
+        while (rank <= 64 - RARITY_HLL_PRECISION && !(rest & 0x8000000000000000ULL)) {
+            rank++;
+            rest <<= 1;
+        }
+        registers[index] = std::max(registers[index], rank);
+    }
+
+    double Estimate() const {
+        const double m = static_cast<double>(registers.size());
+        double sum = 0.0;
+        size_t zeros = 0;
+        for (BYTE r : registers) {
+            sum += std::ldexp(1.0, -static_cast<int>(r));
+            if (!r) zeros++;
+        }
+        double estimate = 0.7213 / (1.0 + 1.079 / m) * m * m / sum;
+        if (estimate <= 2.5 * m && zeros) estimate = m * std::log(m / zeros); // Comptage linéaire
+        return estimate;
+    }
+
+    void Merge(const HyperLogLog& other) {
+        for (size_t i = 0; i < registers.size(); i++) registers[i] = std::max(registers[i], other.registers[i]);
+    }
+
+    BYTE* data() { return registers.data(); }
+    const BYTE* data() const { return registers.data(); }
+    size_t bytes() const { return registers.size(); }
+};
+
+// Comptage de piles sur la flotte : nombre d'hôtes sur lesquels chaque n-uplet
+// (clé, valeur, empreinte des données) a été vu, en mémoire constante. Un hôte
+// est une machine (identité donnée par l'appelant ou déduite du dossier de
+// preuves) ; ses hives (identité du base block) sont comptés chacun une fois :
+// les logs d'un même hive et les hives d'un même hôte parsés dans une exécution
+// s'additionnent, un hive déjà compté lors d'une exécution précédente est
+// seulement noté. Persisté dans rarity.rtlr, fusionnable entre exécutions.
+class RarityModel {
+    using HashSet = std::unordered_set<ULONGLONG, std::hash<ULONGLONG>, std::equal_to<ULONGLONG>,
+                                       CountingAllocator<ULONGLONG, MEM_INDEXES>>;
+    CountMinSketch prevalence;
+    HyperLogLog tuples;             // n-uplets distincts de la flotte
+    HyperLogLog hostCounter;        // Hôtes distincts, y compris après fusion de flottes qui se recouvrent
+    std::vector<ULONGLONG> hosts;   // Empreintes triées des hôtes comptés
+    std::vector<ULONGLONG> units;   // Empreintes triées des hives (hôte, hive) comptés
+    HashSet openUnits;              // Hives comptés par l'exécution en cours
+    HashSet seen;                   // n-uplets (par hôte) comptés par l'exécution en cours
+    ULONGLONG host = 0;             // Hôte courant
+    bool counting = false;
+    bool dirty = false;
+
+    static ULONGLONG Identity(const std::wstring& text) {
+        std::wstring key = text;
+        std::transform(key.begin(), key.end(), key.begin(),
+                       [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+        return Fnv1a64(key);
+    }
+
+    // Hive de l'hôte courant : compté s'il est nouveau ou déjà ouvert par cette exécution
+    bool OpenUnit(const std::wstring& hive) {
+        const ULONGLONG unit = Fnv1a64(hive, Mix64(host));
+        if (openUnits.count(unit)) return true;
+        auto it = std::lower_bound(units.begin(), units.end(), unit);
+        if (it != units.end() && *it == unit) return false;
+        units.insert(it, unit);
+        openUnits.insert(unit);
+
+        auto known = std::lower_bound(hosts.begin(), hosts.end(), host);
+        if (known == hosts.end() || *known != host) {
+            hosts.insert(known, host);
+            hostCounter.Add(host);
+        }
+        dirty = true;
+        return true;
+    }
+
+    static ULONGLONG TupleHash(const TransactionEntry& tx) {
+        const wchar_t separator = 0;
+        ULONGLONG data = Fnv1a64(tx.dataAfter);
+        data = Fnv1a64(&separator, sizeof(separator), data);
+        data = Fnv1a64(tx.details, data);
+
+        ULONGLONG hash = Fnv1a64(tx.keyPath);
+        hash = Fnv1a64(&separator, sizeof(separator), hash);
+        hash = Fnv1a64(tx.valueName, hash);
+        return Fnv1a64(&data, sizeof(data), hash);
+    }
+
+public:
+    // Début d'une exécution : les hives comptés jusqu'ici ne le sont plus à nouveau
+    void BeginRun() {
+        openUnits.clear();
+        seen.clear();
+        counting = false;
+    }
+
+    // Enregistrements observés ensuite attribués à cet hôte
+    void BeginHost(const std::wstring& identity) {
+        host = Identity(identity);
+        counting = true;
+    }
+
+    void EndHost() { counting = false; }
+
+    // Compte les n-uplets de l'hôte courant (par hive de l'enregistrement), puis
+    // note les enregistrements
+    void Observe(TransactionEntry* records, size_t count) {
+        if (counting) {
+            const std::wstring* hive = nullptr;
+            bool open = false;
+            for (size_t i = 0; i < count; i++) {
+                const TransactionEntry& tx = records[i];
+                if (!hive || tx.hiveFile != *hive) {
+                    hive = &tx.hiveFile;
+                    open = OpenUnit(tx.hiveFile);
+                }
+                if (!open) continue;
+                const ULONGLONG tuple = TupleHash(tx);
+                if (!seen.insert(Mix64(tuple ^ host)).second) continue;
+                prevalence.Add(tuple);
+                tuples.Add(tuple);
+            }
+        }
+        Score(records, count);
+    }
+
+    void Score(TransactionEntry* records, size_t count) const {
+        const DWORD fleet = static_cast<DWORD>(hosts.size());
+        for (size_t i = 0; i < count; i++) {
+            records[i].fleetHosts = fleet;
+            records[i].prevalence = fleet ? std::min(prevalence.Estimate(TupleHash(records[i])), fleet) : 0;
+        }
+    }
+
+    bool Dirty() const { return dirty; }
+
+    std::wstring Summary() const {
+        wchar_t text[160];
+        swprintf_s(text, L"Flotte : %zu hôtes (HLL %.0f), environ %.0f n-uplets distincts",
+                   hosts.size(), hostCounter.Estimate(), tuples.Estimate());
+        return text;
+    }
+
+    // Ajoute une flotte : compteurs additionnés, HLL, hôtes et hives réunis. Les
+    // hives présents des deux côtés (overlap) sont comptés deux fois dans le sketch.
+    void Merge(const RarityModel& other, size_t& overlap) {
+        auto unite = [](std::vector<ULONGLONG>& mine, const std::vector<ULONGLONG>& theirs) {
+            std::vector<ULONGLONG> merged;
+            merged.reserve(mine.size() + theirs.size());
+            std::set_union(mine.begin(), mine.end(), theirs.begin(), theirs.end(), std::back_inserter(merged));
+            const size_t common = mine.size() + theirs.size() - merged.size();
+            mine.swap(merged);
+            return common;
+        };
+        unite(hosts, other.hosts);
+        overlap = unite(units, other.units);
+        prevalence.Merge(other.prevalence);
+        tuples.Merge(other.tuples);
+        hostCounter.Merge(other.hostCounter);
+        dirty = true;
+    }
+
+    // Fichier : [magic][version][largeur][profondeur][précision][u64 hôtes]
+    // puis empreintes des hôtes, compteurs, registres HLL (hôtes, n-uplets),
+    // [u64 hives] et empreintes des hives (version 2)
+    bool Save(const std::wstring& path, std::wstring& error) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        const DWORD header[5] = { RARITY_FILE_MAGIC, RARITY_FILE_VERSION, static_cast<DWORD>(RARITY_CMS_WIDTH),
+                                  static_cast<DWORD>(RARITY_CMS_DEPTH), RARITY_HLL_PRECISION };
+        const ULONGLONG count = hosts.size();
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        out.write(reinterpret_cast<const char*>(hosts.data()), hosts.size() * sizeof(ULONGLONG));
+        out.write(reinterpret_cast<const char*>(prevalence.data()), prevalence.bytes());
+        out.write(reinterpret_cast<const char*>(hostCounter.data()), hostCounter.bytes());
+        out.write(reinterpret_cast<const char*>(tuples.data()), tuples.bytes());
+        const ULONGLONG unitCount = units.size();
+        out.write(reinterpret_cast<const char*>(&unitCount), sizeof(unitCount));
+        out.write(reinterpret_cast<const char*>(units.data()), units.size() * sizeof(ULONGLONG));
+        if (!out) {
+            error = L"Impossible d'enregistrer le modèle de rareté : " + path;
+            return false;
+        }
+        dirty = false;
+        return true;
+    }
+
+    bool Load(const std::wstring& path, std::wstring& error) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        const std::streamoff fileSize = in ? static_cast<std::streamoff>(in.tellg()) : 0;
+        in.seekg(0);
+
+        // Nombre d'empreintes annoncé par le fichier (peut-être corrompu) : jamais
+        // plus que les octets qui restent à lire, avant toute allocation
+        auto fits = [&in, fileSize](ULONGLONG items) {
+            const std::streamoff at = in.tellg();
+            return at >= 0 && at <= fileSize &&
+                   items <= static_cast<ULONGLONG>(fileSize - at) / sizeof(ULONGLONG);
+        };
+
+        DWORD header[5] = {};
+        ULONGLONG count = 0;
+        if (!in || !in.read(reinterpret_cast<char*>(header), sizeof(header)) || header[0] != RARITY_FILE_MAGIC) {
+            error = L"Modèle de rareté invalide : " + path;
+            return false;
+        }
+        if (header[1] < 1 || header[1] > RARITY_FILE_VERSION || header[2] != RARITY_CMS_WIDTH || header[3] != RARITY_CMS_DEPTH ||
+            header[4] != RARITY_HLL_PRECISION) {
+            error = L"Modèle de rareté de version ou de dimensions différentes : " + path;
+            return false;
+        }
+        if (!in.read(reinterpret_cast<char*>(&count), sizeof(count)) || !fits(count)) {
+            error = L"Modèle de rareté tronqué : " + path;
+            return false;
+        }
+
+        std::vector<ULONGLONG> loaded(static_cast<size_t>(count));
+        in.read(reinterpret_cast<char*>(loaded.data()), loaded.size() * sizeof(ULONGLONG));
+        in.read(reinterpret_cast<char*>(prevalence.data()), prevalence.bytes());
+        in.read(reinterpret_cast<char*>(hostCounter.data()), hostCounter.bytes());
+        in.read(reinterpret_cast<char*>(tuples.data()), tuples.bytes());
+
+        // Version 1 : hives non enregistrés, un hôte reparsé serait compté à nouveau
+        std::vector<ULONGLONG> loadedUnits;
+        ULONGLONG unitCount = 0;
+        bool unitsFit = true;
+        if (in && header[1] >= 2 && in.read(reinterpret_cast<char*>(&unitCount), sizeof(unitCount))) {
+            unitsFit = fits(unitCount);
+            if (unitsFit) {
+                loadedUnits.resize(static_cast<size_t>(unitCount));
+                in.read(reinterpret_cast<char*>(loadedUnits.data()), loadedUnits.size() * sizeof(ULONGLONG));
+            }
+        }
+        if (!in || !unitsFit || !std::is_sorted(loaded.begin(), loaded.end()) ||
+            !std::is_sorted(loadedUnits.begin(), loadedUnits.end())) {
+            *this = RarityModel();
+            error = L"Modèle de rareté tronqué : " + path;
+            return false;
+        }
+        hosts.swap(loaded);
+        units.swap(loadedUnits);
+        dirty = false;
+        return true;
+    }
+};
+
+// MinHash à permutation unique : chaque fragment de SIMILARITY_SHINGLE octets
+// est haché une fois, ses 6 bits de poids fort choisissent le slot où garder le
+// minimum ; les slots vides sont densifiés par rotation (slot non vide suivant,
+// décalé par la distance). Les 16 bits de poids faible de chaque minimum forment
+// la signature : deux signatures concordent sur une fraction J + (1 - J) / 2^16
+// des slots, J étant le Jaccard des ensembles de fragments.
+class MinHash {
+public:
+    class Builder {
+        std::array<ULONGLONG, SIMILARITY_SLOTS> minimum;
+        size_t shingles = 0;
+
+    public:
+        Builder() { minimum.fill(~0ULL); }
+
+        // Les fragments ne chevauchent pas deux blocs ajoutés séparément
+        void Add(const BYTE* data, size_t size) {
+            for (size_t i = 0; i + SIMILARITY_SHINGLE <= size; i++) {
+                ULONGLONG shingle;
+                memcpy(&shingle, data + i, sizeof(shingle));
+                const ULONGLONG hash = Mix64(shingle);
+                ULONGLONG& slot = minimum[static_cast<size_t>(hash >> (64 - SIMILARITY_SLOT_BITS))];
+                slot = std::min(slot, hash);
+                shingles++;
+            }
+        }
+
+        bool Finish(MinHashSignature& signature) const {
+            signature.valid = shingles >= SIMILARITY_MIN_SHINGLES;
+            if (!signature.valid) return false;
+            for (size_t s = 0; s < SIMILARITY_SLOTS; s++) {
+                size_t source = s;
+                ULONGLONG distance = 0;
+                while (minimum[source] == ~0ULL) {
+                    source = (source + 1) % SIMILARITY_SLOTS;
+                    distance++;
+                }
+                const ULONGLONG value = distance ? Mix64(minimum[source] + distance) : minimum[source];
+                signature.slots[s] = static_cast<WORD>(value);
+            }
+            return true;
+        }
+    };
+
+    // Jaccard estimé, corrigé des concordances fortuites sur 16 bits
+    static double Similarity(const MinHashSignature& a, const MinHashSignature& b) {
+        if (!a.valid || !b.valid) return 0.0;
+        size_t equal = 0;
+        for (size_t s = 0; s < SIMILARITY_SLOTS; s++) equal += a.slots[s] == b.slots[s];
+        const double chance = 1.0 / 65536.0;
+        const double raw = static_cast<double>(equal) / SIMILARITY_SLOTS;
+        return std::max(0.0, (raw - chance) / (1.0 - chance));
+    }
+
+    static ULONGLONG BandKey(const MinHashSignature& signature, size_t band) {
+        return Fnv1a64(signature.slots.data() + band * SIMILARITY_ROWS, SIMILARITY_ROWS * sizeof(WORD), Mix64(band + 1));
+    }
+};
+
+// Index LSH des signatures d'une session : une valeur est candidate dès qu'elle
+// partage une bande de SIMILARITY_ROWS slots avec la requête, soit une
+// probabilité 1 - (1 - J^4)^16 (64 % à J = 0,5, 99 % à J = 0,7). Les candidats
+// sont ensuite filtrés sur le Jaccard estimé. Les sessions ne font que grandir
+// au sein d'une génération : seuls les enregistrements publiés depuis la
+// dernière requête sont indexés, l'index est reconstruit si la session change.
+class SimilarityIndex {
+    using Bucket = std::vector<DWORD, CountingAllocator<DWORD, MEM_INDEXES>>;
+    std::unordered_map<ULONGLONG, Bucket, std::hash<ULONGLONG>, std::equal_to<ULONGLONG>,
+                       CountingAllocator<std::pair<const ULONGLONG, Bucket>, MEM_INDEXES>> buckets;
+    const SnapshotPublisher* source = nullptr;
+    ULONGLONG generation = 0;
+    size_t indexed = 0;
+    size_t signatures = 0;
+
+public:
+    struct Match {
+        size_t index;
+        double similarity;
+    };
+
+    void Update(const SnapshotPublisher* results, const ResultSnapshot& snapshot) {
+        if (source != results || generation != snapshot.generation || indexed > snapshot.size()) {
+            buckets.clear();
+            source = results;
+            generation = snapshot.generation;
+            indexed = 0;
+            signatures = 0;
+        }
+        for (; indexed < snapshot.size(); indexed++) {
+            const MinHashSignature& signature = snapshot[indexed].signature;
+            if (!signature.valid) continue;
+            for (size_t band = 0; band < SIMILARITY_BANDS; band++) {
+                buckets[MinHash::BandKey(signature, band)].push_back(static_cast<DWORD>(indexed));
+            }
+            signatures++;
+        }
+    }
+
+    size_t Signatures() const { return signatures; }
+
+    // Enregistrements (hors index lui-même) de Jaccard estimé >= threshold, du plus proche au plus éloigné
+    void Find(const ResultSnapshot& snapshot, size_t index, double threshold, std::vector<Match>& matches) const {
+        matches.clear();
+        const MinHashSignature& query = snapshot[index].signature;
+        if (!query.valid) return;
+
+        std::vector<DWORD> candidates;
+        for (size_t band = 0; band < SIMILARITY_BANDS; band++) {
+            auto it = buckets.find(MinHash::BandKey(query, band));
+            if (it != buckets.end()) candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+        }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        for (DWORD candidate : candidates) {
+            if (candidate == index) continue;
+            const double similarity = MinHash::Similarity(query, snapshot[candidate].signature);
+            if (similarity >= threshold) matches.push_back({ candidate, similarity });
+        }
+        std::sort(matches.begin(), matches.end(), [](const Match& a, const Match& b) {
+            return a.similarity != b.similarity ? a.similarity > b.similarity : a.index < b.index;
+        });
+    }
+};
+
+// Comptage et position des bits d'un mot de 64 bits (sans intrinsèque)
+inline size_t PopCount64(ULONGLONG x) {
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<size_t>((x * 0x0101010101010101ULL) >> 56);
+}
+
+inline size_t TrailingZeros64(ULONGLONG x) {
+    static const BYTE positions[64] = {
+        0, 1, 2, 53, 3, 7, 54, 27, 4, 38, 41, 8, 34, 55, 48, 28, 62, 5, 39, 46, 44, 42, 22, 9, 24, 35, 59, 56, 49, 18, 29, 11,
+        63, 52, 6, 26, 37, 40, 33, 47, 61, 45, 43, 21, 23, 58, 17, 10, 51, 25, 36, 32, 60, 20, 57, 16, 50, 31, 19, 15, 30, 14, 13, 12
+    };
+    return positions[((x & (~x + 1)) * 0x022FDD63CC95386DULL) >> 58];
+}
+
+// Ensemble d'indices d'enregistrements compressé façon Roaring : les indices sont
+// rangés par blocs de ROARING_BLOCK ; un bloc peu peuplé est un tableau trié de
+// 16 bits, un bloc dense (plus de ROARING_ARRAY_MAX indices) un bitset de 8 Ko.
+// ET / OU / SAUF travaillent bloc à bloc ; un bloc se construit par indices
+// croissants, indépendamment des autres (évaluation parallèle).
+class RecordBitmap {
+public:
+    struct Container {
+        DWORD key = 0;                  // Indice / ROARING_BLOCK
+        size_t cardinality = 0;
+        std::vector<WORD, CountingAllocator<WORD, MEM_INDEXES>> values;           // Tableau trié
+        std::vector<ULONGLONG, CountingAllocator<ULONGLONG, MEM_INDEXES>> bits;    // Bitset sinon
+
+        bool Dense() const { return !bits.empty(); }
+
+        bool Contains(WORD low) const {
+            return Dense() ? ((bits[low >> 6] >> (low & 63)) & 1) != 0 : std::binary_search(values.begin(), values.end(), low);
+        }
+
+        // Indices croissants
+        void Push(WORD low) {
+            if (Dense()) {
+                bits[low >> 6] |= 1ULL << (low & 63);
+            } else {
+                values.push_back(low);
+                if (values.size() > ROARING_ARRAY_MAX) ToBitset();
+            }
+            cardinality++;
+        }
+
+        void ToBitset() {
+            bits.assign(ROARING_BITSET_WORDS, 0);
+            for (WORD low : values) bits[low >> 6] |= 1ULL << (low & 63);
+            values.clear();
+            values.shrink_to_fit();
+        }
+
+        // Recalcule la cardinalité et choisit la forme la plus compacte
+        void Normalize() {
+            if (!Dense()) {
+                cardinality = values.size();
+                if (cardinality > ROARING_ARRAY_MAX) ToBitset();
+                return;
+            }
+            cardinality = 0;
+            for (ULONGLONG word : bits) cardinality += PopCount64(word);
+            if (cardinality > ROARING_ARRAY_MAX) return;
+            values.clear();
+            values.reserve(cardinality);
+            ForEachLow([this](WORD low) { values.push_back(low); });
+            bits.clear();
+            bits.shrink_to_fit();
+        }
+
+        template<typename Fn>
+        void ForEachLow(Fn fn) const {
+            if (!Dense()) {
+                for (WORD low : values) fn(low);
+                return;
+            }
+            for (size_t w = 0; w < bits.size(); w++) {
+                for (ULONGLONG word = bits[w]; word; word &= word - 1) {
+                    fn(static_cast<WORD>(w * 64 + TrailingZeros64(word)));
+                }
+            }
+        }
+    };
+
+    size_t Count() const {
+        size_t count = 0;
+        for (const auto& container : containers) count += container.cardinality;
+        return count;
+    }
+
+    bool Contains(size_t index) const {
+        const Container* container = Find(static_cast<DWORD>(index / ROARING_BLOCK));
+        return container && container->Contains(static_cast<WORD>(index % ROARING_BLOCK));
+    }
+
+    size_t Bytes() const {
+        size_t bytes = 0;
+        for (const auto& container : containers) {
+            bytes += sizeof(Container) + container.values.size() * sizeof(WORD) + container.bits.size() * sizeof(ULONGLONG);
+        }
+        return bytes;
+    }
+
+    const std::vector<Container>& Containers() const { return containers; }
+
+    // Blocs de clés croissantes ; les blocs vides sont ignorés
+    void Append(Container&& container) {
+        if (container.cardinality) containers.push_back(std::move(container));
+    }
+
+    // Indices >= from, dans l'ordre croissant
+    template<typename Fn>
+    void ForEachFrom(size_t from, Fn fn) const {
+        for (const auto& container : containers) {
+            const size_t base = static_cast<size_t>(container.key) * ROARING_BLOCK;
+            if (base + ROARING_BLOCK <= from) continue;
+            container.ForEachLow([&](WORD low) {
+                if (base + low >= from) fn(base + low);
+            });
+        }
+    }
+
+    // [0, count)
+    static RecordBitmap Range(size_t count) {
+        RecordBitmap result;
+        for (size_t base = 0; base < count; base += ROARING_BLOCK) {
+            Container container;
+            container.key = static_cast<DWORD>(base / ROARING_BLOCK);
+            const size_t size = std::min(ROARING_BLOCK, count - base);
+            container.bits.assign(ROARING_BITSET_WORDS, 0);
+            for (size_t w = 0; w < size / 64; w++) container.bits[w] = ~0ULL;
+            if (size % 64) container.bits[size / 64] = (1ULL << (size % 64)) - 1;
+            container.Normalize();
+            result.Append(std::move(container));
+        }
+        return result;
+    }
+
+    static RecordBitmap And(const RecordBitmap& a, const RecordBitmap& b) {
+        return Combine(a, b, Op::And);
+    }
+    static RecordBitmap Or(const RecordBitmap& a, const RecordBitmap& b) {
+        return Combine(a, b, Op::Or);
+    }
+    static RecordBitmap AndNot(const RecordBitmap& a, const RecordBitmap& b) {
+        return Combine(a, b, Op::AndNot);
+    }
+
+private:
+    std::vector<Container> containers;      // Par clé croissante
+
+    enum class Op { And, Or, AndNot };
+
+    const Container* Find(DWORD key) const {
+        auto it = std::lower_bound(containers.begin(), containers.end(), key,
+                                   [](const Container& c, DWORD k) { return c.key < k; });
+        return it != containers.end() && it->key == key ? &*it : nullptr;
+    }
+
+    static Container Merge(const Container& a, const Container& b, Op op) {
+        Container result;
+        result.key = a.key;
+        if (!a.Dense() && !b.Dense()) {
+            auto out = std::back_inserter(result.values);
+            if (op == Op::And) std::set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), out);
+            else if (op == Op::Or) std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), out);
+            else std::set_difference(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), out);
+        } else if (op == Op::And && (!a.Dense() || !b.Dense())) {
+            const Container& sparse = a.Dense() ? b : a;
+            const Container& dense = a.Dense() ? a : b;
+            for (WORD low : sparse.values) {
+                if (dense.Contains(low)) result.values.push_back(low);
+            }
+        } else if (op == Op::AndNot && !a.Dense()) {
+            for (WORD low : a.values) {
+                if (!b.Contains(low)) result.values.push_back(low);
+            }
+        } else {
+            // Au moins un bitset : opération mot à mot
+            result.bits.assign(ROARING_BITSET_WORDS, 0);
+            auto word = [](const Container& c, size_t w) {
+                return c.Dense() ? c.bits[w] : 0ULL;
+            };
+            for (size_t w = 0; w < ROARING_BITSET_WORDS; w++) {
+                const ULONGLONG x = word(a, w), y = word(b, w);
+                result.bits[w] = op == Op::And ? x & y : op == Op::Or ? x | y : x & ~y;
+            }
+            auto scatter = [&result, op](const Container& sparse, bool clear) {
+                for (WORD low : sparse.values) {
+                    if (clear) result.bits[low >> 6] &= ~(1ULL << (low & 63));
+                    else result.bits[low >> 6] |= 1ULL << (low & 63);
+                }
+            };
+            if (op == Op::Or) {
+                if (!a.Dense()) scatter(a, false);
+                if (!b.Dense()) scatter(b, false);
+            } else if (op == Op::AndNot && !b.Dense()) {
+                scatter(b, true);
+            }
+        }
+        result.Normalize();
+        return result;
+    }
+
+    static RecordBitmap Combine(const RecordBitmap& a, const RecordBitmap& b, Op op) {
+        RecordBitmap result;
+        size_t i = 0, j = 0;
+        while (i < a.containers.size() || j < b.containers.size()) {
+            const bool hasA = i < a.containers.size(), hasB = j < b.containers.size();
+            if (hasA && (!hasB || a.containers[i].key < b.containers[j].key)) {
+                if (op != Op::And) result.containers.push_back(a.containers[i]);
+                i++;
+            } else if (hasB && (!hasA || b.containers[j].key < a.containers[i].key)) {
+                if (op == Op::Or) result.containers.push_back(b.containers[j]);
+                j++;
+            } else {
+                result.Append(Merge(a.containers[i++], b.containers[j++], op));
+            }
+        }
+        return result;
+    }
+};
+
+// Filtre interactif de la liste. Une expression combine des termes (sous-chaînes
+// insensibles à la casse, mêmes champs que la requête) par "!" (sauf), "&" (et)
+// et "|" (ou), par priorité décroissante. Le bitmap de chaque terme est gardé en
+// cache : un terme qui prolonge un terme connu (frappe caractère par caractère)
+// n'est évalué que sur les enregistrements retenus par celui-ci, plus ceux
+// publiés depuis ; un terme connu n'est complété que sur les nouveaux
+// enregistrements. Les termes en cache servent de filtres enregistrés pour les
+// combinaisons. Le cache est vidé quand la session ou sa génération change.
+class ResultFilter {
+    struct Term {
+        RecordBitmap matches;
+        size_t evaluated = 0;       // Enregistrements [0, evaluated) couverts
+        ULONGLONG lastUse = 0;
+    };
+    std::map<std::wstring, Term> terms;
+    const SnapshotPublisher* source = nullptr;
+    ULONGLONG generation = 0;
+    ULONGLONG clock = 0;
+
+    // Termes retenus parmi les candidats de base (sur [0, from)) puis sur [from, taille)
+    static RecordBitmap Scan(const ResultSnapshot& snapshot, const std::wstring& term, const RecordBitmap* base,
+                             size_t from, WorkerPool& pool, size_t& scanned) {
+        using Container = RecordBitmap::Container;
+        std::vector<Container> refined(base ? base->Containers().size() : 0);
+        std::vector<Container> appended;
+        std::vector<std::function<void()>> tasks;
+
+        for (size_t c = 0; c < refined.size(); c++) {
+            const Container& candidates = base->Containers()[c];
+            scanned += candidates.cardinality;
+            tasks.push_back([&snapshot, &term, &candidates, &refined, c, from] {
+                Container& out = refined[c];
+                out.key = candidates.key;
+                const size_t blockBase = static_cast<size_t>(candidates.key) * ROARING_BLOCK;
+                candidates.ForEachLow([&](WORD low) {
+                    if (blockBase + low < from && RecordContains(snapshot[blockBase + low], term)) out.Push(low);
+                });
+            });
+        }
+
+        const size_t size = snapshot.size();
+        if (from < size) {
+            scanned += size - from;
+            const size_t firstKey = from / ROARING_BLOCK;
+            appended.resize((size - 1) / ROARING_BLOCK - firstKey + 1);
+            for (size_t k = 0; k < appended.size(); k++) {
+                tasks.push_back([&snapshot, &term, &appended, k, firstKey, from, size] {
+                    Container& out = appended[k];
+                    out.key = static_cast<DWORD>(firstKey + k);
+                    const size_t blockBase = (firstKey + k) * ROARING_BLOCK;
+                    const size_t begin = std::max(from, blockBase), end = std::min(size, blockBase + ROARING_BLOCK);
+                    for (size_t i = begin; i < end; i++) {
+                        if (RecordContains(snapshot[i], term)) out.Push(static_cast<WORD>(i - blockBase));
+                    }
+                });
+            }
+        }
+        pool.Run(tasks);
+
+        RecordBitmap previous, added;
+        for (auto& container : refined) previous.Append(std::move(container));
+        for (auto& container : appended) added.Append(std::move(container));
+        return RecordBitmap::Or(previous, added);
+    }
+
+    const RecordBitmap& TermMatches(const ResultSnapshot& snapshot, const std::wstring& term, WorkerPool& pool,
+                                    size_t& scanned) {
+        auto known = terms.find(term);
+        if (known != terms.end()) {
+            Term& entry = known->second;
+            if (entry.evaluated < snapshot.size()) {
+                entry.matches = RecordBitmap::Or(entry.matches, Scan(snapshot, term, nullptr, entry.evaluated, pool, scanned));
+                entry.evaluated = snapshot.size();
+            }
+            entry.lastUse = ++clock;
+            return entry.matches;
+        }
+
+        // Base : le plus long terme connu contenu dans le nouveau
+        const Term* base = nullptr;
+        size_t baseLength = 0;
+        for (const auto& candidate : terms) {
+            if ((!base || candidate.first.size() > baseLength) && term.find(candidate.first) != std::wstring::npos) {
+                base = &candidate.second;
+                baseLength = candidate.first.size();
+            }
+        }
+
+        Term entry;
+        entry.matches = Scan(snapshot, term, base ? &base->matches : nullptr, base ? base->evaluated : 0, pool, scanned);
+        entry.evaluated = snapshot.size();
+        entry.lastUse = ++clock;
+        return terms.emplace(term, std::move(entry)).first->second.matches;
+    }
+
+    static std::wstring Trim(const std::wstring& text) {
+        const size_t begin = text.find_first_not_of(L" \t");
+        if (begin == std::wstring::npos) return L"";
+        return text.substr(begin, text.find_last_not_of(L" \t") - begin + 1);
+    }
+
+    static std::vector<std::wstring> Split(const std::wstring& text, wchar_t separator) {
+        std::vector<std::wstring> parts;
+        size_t start = 0;
+        for (size_t pos; (pos = text.find(separator, start)) != std::wstring::npos; start = pos + 1) {
+            parts.push_back(text.substr(start, pos - start));
+        }
+        parts.push_back(text.substr(start));
+        return parts;
+    }
+
+    // Termes les moins récemment utilisés au-delà de FILTER_CACHE_TERMS
+    void Evict() {
+        while (terms.size() > FILTER_CACHE_TERMS) {
+            auto oldest = std::min_element(terms.begin(), terms.end(), [](const std::pair<const std::wstring, Term>& a,
+                                                                          const std::pair<const std::wstring, Term>& b) {
+                return a.second.lastUse < b.second.lastUse;
+            });
+            terms.erase(oldest);
+        }
+    }
+
+public:
+    // false si l'expression ne contient aucun terme non vide (pas de filtre) ; scanned
+    // reçoit le nombre d'enregistrements examinés
+    bool Evaluate(const SnapshotPublisher* results, const ResultSnapshot& snapshot, const std::wstring& expression,
+                  WorkerPool& pool, RecordBitmap& matches, size_t& scanned) {
+        scanned = 0;
+        matches = RecordBitmap();
+        if (source != results || generation != snapshot.generation) {
+            terms.clear();
+            source = results;
+            generation = snapshot.generation;
+        }
+
+        std::wstring lowered = expression;
+        std::transform(lowered.begin(), lowered.end(), lowered.begin(),
+                       [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+        if (Trim(lowered).empty()) return false;
+
+        // Facteurs vides (saisie en cours : "foo |", "a & ", "!") ignorés, ainsi que
+        // les groupes qui n'en ont pas d'autre ; le terme vide retiendrait tout
+        bool any = false;
+        for (const std::wstring& group : Split(lowered, L'|')) {
+            RecordBitmap conjunction;
+            bool first = true;
+            for (const std::wstring& raw : Split(group, L'&')) {
+                std::wstring factor = Trim(raw);
+                const bool negated = !factor.empty() && factor[0] == L'!';
+                if (negated) factor = Trim(factor.substr(1));
+                if (factor.empty()) continue;
+
+                const RecordBitmap& term = TermMatches(snapshot, factor, pool, scanned);
+                if (first) {
+                    conjunction = negated ? RecordBitmap::AndNot(RecordBitmap::Range(snapshot.size()), term) : term;
+                    first = false;
+                } else {
+                    conjunction = negated ? RecordBitmap::AndNot(conjunction, term) : RecordBitmap::And(conjunction, term);
+                }
+            }
+            if (first) continue;
+            matches = RecordBitmap::Or(matches, conjunction);
+            any = true;
+        }
+        Evict();
+        return any;
+    }
+};
+
+// Espace de travail : sessions ouvertes simultanément (SYSTEM, SOFTWARE, NTUSER...)
+// et caches partagés entre elles
+struct Workspace {
+    std::vector<std::unique_ptr<ParseSession>> sessions;
+    size_t active = 0;
+    WorkerPool pool;
+    InternPool decoded;
+    LogIndexCache indexes;
+    HiveIdentityCache hives;
+    CompressedPageStore pages;
+    PluginHost plugins;
+    RarityModel rarity;
+};
+
+// Diff de deux exports CSV. Les enregistrements sont appariés par identité
+// (fichier LOG, offset, séquence) ; un enregistrement apparié est « modifié »
+// si le hash du contenu brut ou celui des champs décodés diffère. Les deux
+// ensembles sont répartis par hash de l'identité, puis chaque partition est
+// triée et fusionnée sur son propre thread.
+class ResultSetDiff {
+public:
+    struct Record {
+        std::wstring logFile;       // Nom de fichier en minuscules
+        ULONGLONG fileOffset;
+        DWORD sequence;
+        ULONGLONG contentHash;
+        ULONGLONG fieldsHash;       // Champs décodés (DecodedColumns)
+        ULONGLONG identityHash;
+        std::wstring keyPath;
+    };
+
+    enum class Change { Added, Removed, Modified };
+
+    struct Difference {
+        Change change;
+        const Record* before;       // nullptr si ajouté
+        const Record* after;        // nullptr si supprimé
+    };
+
+    struct Report {
+        std::vector<Difference> differences;
+        size_t added = 0, removed = 0, modified = 0, unchanged = 0;
+    };
+
+private:
+    static bool IdentityLess(const Record* a, const Record* b) {
+        if (a->fileOffset != b->fileOffset) return a->fileOffset < b->fileOffset;
+        if (a->sequence != b->sequence) return a->sequence < b->sequence;
+        return a->logFile < b->logFile;
+    }
+
+    static bool SameIdentity(const Record* a, const Record* b) {
+        return a->fileOffset == b->fileOffset && a->sequence == b->sequence && a->logFile == b->logFile;
+    }
+
+    // Découpe l'enregistrement CSV commençant à start (champs entre guillemets,
+    // guillemets doublés) ; un saut de ligne entre guillemets appartient au champ
+    // (REG_MULTI_SZ). Renvoie le début de l'enregistrement suivant, npos à la fin.
+    static size_t SplitCsvRecord(const std::wstring& text, size_t start, std::vector<std::wstring>& fields) {
+        fields.clear();
+        std::wstring field;
+        bool quoted = false;
+        for (size_t i = start; i < text.size(); i++) {
+            wchar_t c = text[i];
+            if (quoted) {
+                if (c == L'"') {
+                    if (i + 1 < text.size() && text[i + 1] == L'"') {
+                        field += L'"';
+                        i++;
+                    } else {
+                        quoted = false;
+                    }
+                } else {
+                    field += c;
+                }
+            } else if (c == L'"') {
+                quoted = true;
+            } else if (c == L',') {
+                fields.push_back(std::move(field));
+                field.clear();
+            } else if (c == L'\n') {
+                fields.push_back(std::move(field));
+                return i + 1;
+            } else if (c != L'\r') {
+                field += c;
+            }
+        }
+        fields.push_back(std::move(field));
+        return std::wstring::npos;
+    }
+
+    struct PartitionJob {
+        std::vector<const Record*> before, after;
+        Report report;
+    };
+
+    static DWORD WINAPI PartitionThreadProc(LPVOID param) {
+        auto* job = static_cast<PartitionJob*>(param);
+        std::sort(job->before.begin(), job->before.end(), IdentityLess);
+        std::sort(job->after.begin(), job->after.end(), IdentityLess);
+
+        Report& r = job->report;
+        size_t i = 0, j = 0;
+        while (i < job->before.size() || j < job->after.size()) {
+            if (j == job->after.size() || (i < job->before.size() && IdentityLess(job->before[i], job->after[j]))) {
+                r.differences.push_back({ Change::Removed, job->before[i++], nullptr });
+                r.removed++;
+            } else if (i == job->before.size() || IdentityLess(job->after[j], job->before[i])) {
+                r.differences.push_back({ Change::Added, nullptr, job->after[j++] });
+                r.added++;
+            } else {
+                const Record* a = job->before[i++];
+                const Record* b = job->after[j++];
+                if (a->contentHash != b->contentHash || a->fieldsHash != b->fieldsHash) {
+                    r.differences.push_back({ Change::Modified, a, b });
+                    r.modified++;
+                } else {
+                    r.unchanged++;
+                }
+            }
+        }
+        return 0;
+    }
+
+public:
+    static bool Load(const std::wstring& path, std::vector<Record>& records, std::wstring& error) {
+        FileHandle hFile(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                     nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr));
+        if (!hFile.valid()) {
+            error = L"Impossible d'ouvrir " + path;
+            return false;
+        }
+
+        LARGE_INTEGER size = {};
+        if (!GetFileSizeEx(hFile, &size) || size.QuadPart == 0 || size.QuadPart > 0x7FFFFFFFLL) {
+            error = L"Export vide ou trop volumineux : " + path;
+            return false;
+        }
+
+        std::vector<char> raw(static_cast<size_t>(size.QuadPart));
+        DWORD bytesRead = 0;
+        if (!ReadFile(hFile, raw.data(), static_cast<DWORD>(raw.size()), &bytesRead, nullptr) || bytesRead != raw.size()) {
+            error = L"Lecture échouée : " + path;
+            return false;
+        }
+
+        // UTF-8 avec BOM éventuel
+        int skip = (raw.size() >= 3 && static_cast<BYTE>(raw[0]) == 0xEF &&
+                    static_cast<BYTE>(raw[1]) == 0xBB && static_cast<BYTE>(raw[2]) == 0xBF) ? 3 : 0;
+        int wideLen = MultiByteToWideChar(CP_UTF8, 0, raw.data() + skip, static_cast<int>(raw.size()) - skip, nullptr, 0);
+        std::wstring text(static_cast<size_t>(wideLen), L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, raw.data() + skip, static_cast<int>(raw.size()) - skip, &text[0], wideLen);
+        raw.clear();
+        raw.shrink_to_fit();
+
+        std::vector<std::wstring> fields;
+        size_t next = SplitCsvRecord(text, 0, fields);
+
+        auto column = [&fields](const wchar_t* name) -> int {
+            for (size_t i = 0; i < fields.size(); i++) {
+                if (fields[i] == name) return static_cast<int>(i);
+            }
+            return -1;
+        };
+        const int colLogFile = column(L"LogFile"), colOffset = column(L"FileOffset");
+        const int colSequence = column(L"Sequence"), colHash = column(L"ContentHash");
+        const int colKeyPath = column(L"KeyPath");
+        if (colLogFile < 0 || colOffset < 0 || colSequence < 0 || colHash < 0) {
+            error = L"Export sans colonnes d'identité (LogFile, FileOffset, Sequence, ContentHash) : " + path;
+            return false;
+        }
+        // Seuls les champs décodés sont comparés : le timestamp dépend de l'heure du
+        // parsing, la rareté du modèle de flotte et les colonnes dérivées des greffons
+        static const wchar_t* const decodedColumns[] = {
+            L"HiveFile", L"KeyPath", L"ValueName", L"DataBefore", L"DataAfter", L"TxID", L"Artifact", L"Details",
+        };
+        std::vector<int> decoded;
+        for (const wchar_t* name : decodedColumns) decoded.push_back(column(name));
+        const size_t required = static_cast<size_t>(std::max({ colLogFile, colOffset, colSequence, colHash }));
+
+        records.clear();
+        while (next != std::wstring::npos) {
+            next = SplitCsvRecord(text, next, fields);
+            if (fields.size() <= required) continue;   // Ligne vide ou incomplète
+
+            Record rec;
+            rec.logFile = fields[colLogFile];
+            std::transform(rec.logFile.begin(), rec.logFile.end(), rec.logFile.begin(),
+                           [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+            rec.fileOffset = wcstoull(fields[colOffset].c_str(), nullptr, 10);
+            rec.sequence = static_cast<DWORD>(wcstoul(fields[colSequence].c_str(), nullptr, 10));
+            rec.contentHash = wcstoull(fields[colHash].c_str(), nullptr, 16);
+            rec.keyPath = colKeyPath >= 0 && static_cast<size_t>(colKeyPath) < fields.size() ? fields[colKeyPath] : L"";
+
+            rec.fieldsHash = FNV_OFFSET_BASIS;
+            for (int col : decoded) {
+                if (col >= 0 && static_cast<size_t>(col) < fields.size()) {
+                    rec.fieldsHash = Fnv1a64(fields[col], rec.fieldsHash);
+                }
+                rec.fieldsHash = Fnv1a64("\x1F", 1, rec.fieldsHash);
+            }
+
+            rec.identityHash = Fnv1a64(rec.logFile);
+            rec.identityHash = Fnv1a64(&rec.fileOffset, sizeof(rec.fileOffset), rec.identityHash);
+            rec.identityHash = Fnv1a64(&rec.sequence, sizeof(rec.sequence), rec.identityHash);
+            records.push_back(std::move(rec));
+        }
+        return true;
+    }
+
+    static Report Compare(const std::vector<Record>& before, const std::vector<Record>& after) {
+        SYSTEM_INFO si = {};
+        GetSystemInfo(&si);
+        const size_t partitionCount = std::max<size_t>(1, std::min<size_t>(
+            { static_cast<size_t>(si.dwNumberOfProcessors), MAX_SCAN_PARTITIONS, (before.size() + after.size()) / 65536 + 1 }));
+
+        std::vector<PartitionJob> jobs(partitionCount);
+        for (const auto& rec : before) jobs[rec.identityHash % partitionCount].before.push_back(&rec);
+        for (const auto& rec : after) jobs[rec.identityHash % partitionCount].after.push_back(&rec);
+
+        std::vector<HANDLE> threads;
+        for (auto& job : jobs) {
+            HANDLE hThread = CreateThread(nullptr, 0, PartitionThreadProc, &job, 0, nullptr);
+            if (hThread) {
+                threads.push_back(hThread);
+            } else {
+                PartitionThreadProc(&job);
+            }
+        }
+        if (!threads.empty()) {
+            WaitForMultipleObjects(static_cast<DWORD>(threads.size()), threads.data(), TRUE, INFINITE);
+        }
+        for (HANDLE hThread : threads) CloseHandle(hThread);
+
+        Report report;
+        for (auto& job : jobs) {
+            report.added += job.report.added;
+            report.removed += job.report.removed;
+            report.modified += job.report.modified;
+            report.unchanged += job.report.unchanged;
+            report.differences.insert(report.differences.end(),
+                                      job.report.differences.begin(), job.report.differences.end());
+        }
+
+        // Rapport ordonné par fichier puis offset
+        std::sort(report.differences.begin(), report.differences.end(), [](const Difference& a, const Difference& b) {
+            const Record* ra = a.after ? a.after : a.before;
+            const Record* rb = b.after ? b.after : b.before;
+            if (ra->logFile != rb->logFile) return ra->logFile < rb->logFile;
+            return IdentityLess(ra, rb);
+        });
+        return report;
+    }
+
+    static bool WriteReport(const std::wstring& path, const Report& report) {
+        std::wofstream csv(path, std::ios::binary);
+        if (!csv.is_open()) return false;
+        csv.imbue(std::locale(std::locale(), new std::codecvt_utf8<wchar_t>));
+
+        csv << L'\xFEFF' << L"Change,LogFile,FileOffset,Sequence,HashBefore,HashAfter,KeyPathBefore,KeyPathAfter\n";
+        for (const auto& d : report.differences) {
+            const Record* id = d.after ? d.after : d.before;
+            wchar_t hashBefore[24] = L"", hashAfter[24] = L"";
+            if (d.before) swprintf_s(hashBefore, L"%016llX", d.before->contentHash);
+            if (d.after) swprintf_s(hashAfter, L"%016llX", d.after->contentHash);
+
+            csv << (d.change == Change::Added ? L"added" : d.change == Change::Removed ? L"removed" : L"modified") << L","
+                << CsvQuote(id->logFile) << L"," << id->fileOffset << L"," << id->sequence << L","
+                << hashBefore << L"," << hashAfter << L","
+                << CsvQuote(d.before ? d.before->keyPath : L"") << L","
+                << CsvQuote(d.after ? d.after->keyPath : L"") << L"\n";
+        }
+        return true;
+    }
+};
+
+// RAII pour socket
+class SocketHandle {
+    SOCKET s;
+public:
+    explicit SocketHandle(SOCKET sock = INVALID_SOCKET) : s(sock) {}
+    ~SocketHandle() { reset(); }
+    SocketHandle(const SocketHandle&) = delete;
+    SocketHandle& operator=(const SocketHandle&) = delete;
+    SocketHandle(SocketHandle&& other) noexcept : s(other.s) { other.s = INVALID_SOCKET; }
+    SocketHandle& operator=(SocketHandle&& other) noexcept {
+        if (this != &other) { reset(); s = other.s; other.s = INVALID_SOCKET; }
+        return *this;
+    }
+    void reset() {
+        if (s != INVALID_SOCKET) closesocket(s);
+        s = INVALID_SOCKET;
+    }
+    operator SOCKET() const { return s; }
+    bool valid() const { return s != INVALID_SOCKET; }
+};
+
+// Protocole coordinateur/worker : trames [u32 taille][u8 type][charge utile],
+// chaînes UTF-16 préfixées par leur longueur.
+class DistProtocol {
+public:
+    enum class Frame : BYTE {
+        Hello = 1,      // worker -> coordinateur : pid
+        Job,            // coordinateur -> worker : id, chemin du LOG
+        Heartbeat,      // worker -> coordinateur : job en cours
+        Results,        // worker -> coordinateur : id, lot d'enregistrements
+        Done,           // worker -> coordinateur : id, nombre d'enregistrements
+        Shutdown        // coordinateur -> worker
+    };
+
+    class Writer {
+        std::vector<BYTE> buf;
+        void Append(const void* data, size_t len) {
+            const BYTE* p = static_cast<const BYTE*>(data);
+            buf.insert(buf.end(), p, p + len);
+        }
+    public:
+        void U32(DWORD v) { Append(&v, sizeof(v)); }
+        void U64(ULONGLONG v) { Append(&v, sizeof(v)); }
+        void Str(const std::wstring& v) {
+            U32(static_cast<DWORD>(v.size()));
+            Append(v.data(), v.size() * sizeof(wchar_t));
+        }
+        void Entry(const TransactionEntry& tx) {
+            Str(tx.timestamp); Str(tx.hiveFile); Str(tx.keyPath); Str(tx.valueName);
+            Str(tx.dataBefore); Str(tx.dataAfter); Str(tx.txID); U32(tx.offset);
+            Str(tx.logFile); U64(tx.fileOffset); U32(tx.sequence); U64(tx.contentHash);
+            Str(tx.artifact); Str(tx.details);
+            U32(static_cast<DWORD>(tx.derived.size()));
+            for (const auto& value : tx.derived) Str(value);
+            U32(tx.signature.valid ? static_cast<DWORD>(SIMILARITY_SLOTS) : 0);
+            if (tx.signature.valid) Append(tx.signature.slots.data(), sizeof(tx.signature.slots));
+        }
+        const std::vector<BYTE>& bytes() const { return buf; }
+    };
+
+    class Reader {
+        const BYTE* p;
+        size_t left;
+        bool ok;
+        bool signatures;    // Absentes des sessions de version 1
+        bool Take(void* out, size_t len) {
+            if (!ok || len > left) return ok = false;
+            memcpy(out, p, len);
+            p += len;
+            left -= len;
+            return true;
+        }
+    public:
+        explicit Reader(const std::vector<BYTE>& data, bool withSignatures = true)
+            : p(data.data()), left(data.size()), ok(true), signatures(withSignatures) {}
+        DWORD U32() { DWORD v = 0; Take(&v, sizeof(v)); return v; }
+        ULONGLONG U64() { ULONGLONG v = 0; Take(&v, sizeof(v)); return v; }
+        std::wstring Str() {
+            DWORD len = U32();
+            if (!ok || static_cast<size_t>(len) * sizeof(wchar_t) > left) { ok = false; return L""; }
+            std::wstring v(reinterpret_cast<const wchar_t*>(p), len);
+            p += len * sizeof(wchar_t);
+            left -= len * sizeof(wchar_t);
+            return v;
+        }
+        bool Entry(TransactionEntry& tx) {
+            tx.timestamp = Str(); tx.hiveFile = Str(); tx.keyPath = Str(); tx.valueName = Str();
+            tx.dataBefore = Str(); tx.dataAfter = Str(); tx.txID = Str(); tx.offset = U32();
+            tx.logFile = Str(); tx.fileOffset = static_cast<size_t>(U64()); tx.sequence = U32(); tx.contentHash = U64();
+            tx.artifact = Str(); tx.details = Str();
+            const DWORD derived = U32();
+            if (!ok || derived > left / sizeof(DWORD)) return ok = false;
+            tx.derived.resize(derived);
+            for (auto& value : tx.derived) value = Str();
+            if (signatures) {
+                const DWORD slots = U32();
+                if (slots && slots != SIMILARITY_SLOTS) return ok = false;
+                tx.signature.valid = slots != 0 && Take(tx.signature.slots.data(), sizeof(tx.signature.slots));
+            }
+            tx.pageId = PAGE_NONE; // Les pages restent sur le worker
+            return ok;
+        }
+        bool valid() const { return ok; }
+    };
+
+    static bool SendFrame(SOCKET s, Frame type, const Writer& payload) {
+        const std::vector<BYTE>& body = payload.bytes();
+        std::vector<BYTE> frame(5 + body.size());
+        DWORD size = static_cast<DWORD>(body.size());
+        memcpy(frame.data(), &size, 4);
+        frame[4] = static_cast<BYTE>(type);
+        if (!body.empty()) memcpy(frame.data() + 5, body.data(), body.size());
+
+        size_t sent = 0;
+        while (sent < frame.size()) {
+            int n = send(s, reinterpret_cast<const char*>(frame.data() + sent), static_cast<int>(frame.size() - sent), 0);
+            if (n <= 0) return false;
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    // Réception bloquante d'une trame complète (côté worker)
+    static bool RecvFrame(SOCKET s, Frame& type, std::vector<BYTE>& payload) {
+        BYTE header[5];
+        if (!RecvAll(s, header, sizeof(header))) return false;
+        DWORD size = 0;
+        memcpy(&size, header, 4);
+        if (size > DIST_MAX_FRAME_SIZE) return false;
+        type = static_cast<Frame>(header[4]);
+        payload.resize(size);
+        return size == 0 || RecvAll(s, payload.data(), size);
+    }
+
+    // Extrait une trame complète d'un tampon de réception (côté coordinateur).
+    // Retourne false si la trame est incomplète ; malformed signale une taille aberrante.
+    static bool PopFrame(std::vector<BYTE>& inbox, Frame& type, std::vector<BYTE>& payload, bool& malformed) {
+        malformed = false;
+        if (inbox.size() < 5) return false;
+        DWORD size = 0;
+        memcpy(&size, inbox.data(), 4);
+        if (size > DIST_MAX_FRAME_SIZE) {
+            malformed = true;
+            return false;
+        }
+        if (inbox.size() < 5 + static_cast<size_t>(size)) return false;
+        type = static_cast<Frame>(inbox[4]);
+        payload.assign(inbox.begin() + 5, inbox.begin() + 5 + size);
+        inbox.erase(inbox.begin(), inbox.begin() + 5 + size);
+        return true;
+    }
+
+private:
+    static bool RecvAll(SOCKET s, BYTE* data, size_t len) {
+        size_t got = 0;
+        while (got < len) {
+            int n = recv(s, reinterpret_cast<char*>(data + got), static_cast<int>(len - got), 0);
+            if (n <= 0) return false;
+            got += static_cast<size_t>(n);
+        }
+        return true;
+    }
+};
+
+// Session enregistrée : en-tête [magic][version] puis blocs [u32 taille][u32
+// nombre][enregistrements au format DistProtocol], terminés par un bloc vide.
+class SessionFile {
+public:
+    static bool Save(const std::wstring& path, const ResultSnapshot& snapshot, std::wstring& error) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            error = L"Impossible de créer la session : " + path;
+            return false;
+        }
+        const DWORD header[2] = { SESSION_FILE_MAGIC, SESSION_FILE_VERSION };
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+        DistProtocol::Writer block;
+        DWORD count = 0;
+        auto flush = [&out, &block, &count] {
+            const DWORD prefix[2] = { static_cast<DWORD>(block.bytes().size()), count };
+            out.write(reinterpret_cast<const char*>(prefix), sizeof(prefix));
+            out.write(reinterpret_cast<const char*>(block.bytes().data()), block.bytes().size());
+            block = DistProtocol::Writer();
+            count = 0;
+        };
+        snapshot.ForEach([&](const TransactionEntry& tx) {
+            block.Entry(tx);
+            if (++count == SESSION_FILE_BLOCK) flush();
+        });
+        if (count) flush();
+        flush(); // Bloc vide de fin
+
+        if (!out) {
+            error = L"Écriture de la session interrompue : " + path;
+            return false;
+        }
+        return true;
+    }
+
+    static bool Load(const std::wstring& path, RecordVector& records, std::wstring& error) {
+        std::ifstream in(path, std::ios::binary);
+        DWORD header[2] = {};
+        if (!in || !in.read(reinterpret_cast<char*>(header), sizeof(header)) || header[0] != SESSION_FILE_MAGIC) {
+            error = L"Fichier de session invalide : " + path;
+            return false;
+        }
+        if (header[1] != SESSION_FILE_VERSION && header[1] != 1) {
+            error = L"Version de session non prise en charge (" + std::to_wstring(header[1]) + L") : " + path;
+            return false;
+        }
+
+        std::vector<BYTE> payload;
+        for (;;) {
+            DWORD prefix[2] = {};
+            if (!in.read(reinterpret_cast<char*>(prefix), sizeof(prefix)) || prefix[0] > DIST_MAX_FRAME_SIZE) break;
+            if (prefix[1] == 0) return true;
+
+            payload.resize(prefix[0]);
+            if (!in.read(reinterpret_cast<char*>(payload.data()), payload.size())) break;
+            DistProtocol::Reader reader(payload, header[1] >= 2);
+            for (DWORD i = 0; i < prefix[1]; i++) {
+                TransactionEntry tx;
+                if (!reader.Entry(tx)) break;
+                records.push_back(std::move(tx));
+            }
+            if (!reader.valid()) break;
+        }
+        error = L"Session tronquée ou corrompue : " + path;
+        return false;
+    }
+};
+
+// Export Parquet des colonnes de résultats. Chaque row group couvre environ
+// PARQUET_ROW_GROUP_BYTES de données ; ses column chunks sont encodés en
+// parallèle sur le pool, puis écrits dans l'ordre des colonnes. Hive, clé, log
+// et artefact sont encodés par dictionnaire (RLE_DICTIONARY) tant que le
+// dictionnaire du chunk reste petit. Chaque chunk porte ses statistiques min/max
+// (entiers non signés, chaînes en ordre d'octets) pour l'élagage des row groups ;
+// EventTime (TIMESTAMP µs UTC) est dérivé de Timestamp, nul si illisible ou pour
+// une entrée de log (heure de décodage).
+// Pages non compressées, métadonnées en Thrift compact.
+class ParquetWriter {
+public:
+    static bool Write(const std::wstring& path, const ResultColumns& table, WorkerPool& pool, std::wstring& error) {
+        std::vector<Field> fields;
+        for (const auto& column : table.Columns()) {
+            fields.push_back({ &column, Utf8Name(column.name), false, IsDictionaryColumn(column.name) });
+            if (column.name == L"Timestamp") fields.push_back({ &column, "EventTime", true, false });
+        }
+
+        // Découpage en row groups de volume comparable
+        const size_t rows = table.Rows();
+        ULONGLONG totalBytes = 0;
+        for (const auto& field : fields) totalBytes += FieldBytes(field, rows);
+        size_t groupRows = rows;
+        if (totalBytes > PARQUET_ROW_GROUP_BYTES) {
+            groupRows = static_cast<size_t>(std::max<ULONGLONG>(1, rows * PARQUET_ROW_GROUP_BYTES / totalBytes));
+        }
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            error = L"Impossible de créer le fichier Parquet : " + path;
+            return false;
+        }
+        out.write(PARQUET_MAGIC, 4);
+        ULONGLONG position = 4;
+
+        std::vector<RowGroup> groups;
+        std::vector<Chunk> chunks(fields.size());
+        for (size_t begin = 0; begin < rows; begin += groupRows) {
+            const size_t end = std::min(rows, begin + groupRows);
+            std::vector<std::function<void()>> tasks;
+            for (size_t c = 0; c < fields.size(); c++) {
+                chunks[c] = Chunk();
+                Chunk* chunk = &chunks[c];
+                const Field* field = &fields[c];
+                tasks.push_back([chunk, field, begin, end] { EncodeChunk(*field, begin, end, *chunk); });
+            }
+            pool.Run(tasks);
+
+            RowGroup group;
+            group.rows = end - begin;
+            group.offset = position;
+            for (auto& chunk : chunks) {
+                out.write(reinterpret_cast<const char*>(chunk.bytes.data()), chunk.bytes.size());
+                ChunkMeta meta;
+                meta.offset = position;
+                meta.dataOffset = position + chunk.dataOffset;
+                meta.size = chunk.bytes.size();
+                meta.dictionary = chunk.dataOffset != 0;
+                meta.nulls = chunk.nulls;
+                meta.stats = chunk.stats;
+                meta.minValue = std::move(chunk.minValue);
+                meta.maxValue = std::move(chunk.maxValue);
+                position += chunk.bytes.size();
+                group.size += chunk.bytes.size();
+                group.chunks.push_back(std::move(meta));
+            }
+            groups.push_back(std::move(group));
+        }
+
+        const std::vector<BYTE> footer = Footer(fields, groups, rows);
+        const DWORD footerSize = static_cast<DWORD>(footer.size());
+        out.write(reinterpret_cast<const char*>(footer.data()), footer.size());
+        out.write(reinterpret_cast<const char*>(&footerSize), sizeof(footerSize));
+        out.write(PARQUET_MAGIC, 4);
+        if (!out) {
+            error = L"Écriture du fichier Parquet interrompue : " + path;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    // Valeurs des énumérations du format (parquet.thrift)
+    enum PhysicalType { TYPE_INT32 = 1, TYPE_INT64 = 2, TYPE_BYTE_ARRAY = 6 };
+    enum ConvertedType { CONVERTED_UTF8 = 0, CONVERTED_TIMESTAMP_MICROS = 10, CONVERTED_UINT_32 = 13, CONVERTED_UINT_64 = 14 };
+    enum Encoding { ENCODING_PLAIN = 0, ENCODING_RLE = 3, ENCODING_RLE_DICTIONARY = 8 };
+    enum PageType { PAGE_DATA = 0, PAGE_DICTIONARY = 2 };
+    enum Repetition { REPETITION_REQUIRED = 0, REPETITION_OPTIONAL = 1 };
+
+    struct Field {
+        const ResultColumns::Column* column;
+        std::string name;
+        bool eventTime;         // Dérivé de la colonne Timestamp
+        bool dictionary;
+    };
+
+    struct Chunk {
+        std::vector<BYTE> bytes;        // Page dictionnaire éventuelle puis pages de données
+        size_t dataOffset = 0;          // Taille de la page dictionnaire
+        int64_t nulls = 0;
+        bool stats = false;
+        std::string minValue, maxValue; // Encodage PLAIN de la valeur (sans longueur pour les chaînes)
+    };
+
+    struct ChunkMeta {
+        ULONGLONG offset = 0, dataOffset = 0, size = 0;
+        bool dictionary = false;
+        int64_t nulls = 0;
+        bool stats = false;
+        std::string minValue, maxValue;
+    };
+
+    struct RowGroup {
+        size_t rows = 0;
+        ULONGLONG offset = 0, size = 0;
+        std::vector<ChunkMeta> chunks;
+    };
+
+    // Protocole compact Thrift : en-têtes de champ par delta d'identifiant,
+    // entiers zigzag en varint, structures terminées par un octet nul
+    class Thrift {
+    public:
+        enum : BYTE { T_TRUE = 1, T_FALSE = 2, T_BYTE = 3, T_I32 = 5, T_I64 = 6, T_BINARY = 8, T_LIST = 9, T_STRUCT = 12 };
+
+        Thrift() { fields.push_back(0); }
+
+        void I32(short id, int32_t value) { FieldHeader(id, T_I32); Varint(ZigZag(value)); }
+        void I64(short id, int64_t value) { FieldHeader(id, T_I64); Varint(ZigZag(value)); }
+        void Byte(short id, BYTE value) { FieldHeader(id, T_BYTE); out.push_back(value); }
+        void Bool(short id, bool value) { FieldHeader(id, value ? T_TRUE : T_FALSE); }
+        void Binary(short id, const std::string& value) { FieldHeader(id, T_BINARY); Bytes(value); }
+
+        void BeginStruct(short id) { FieldHeader(id, T_STRUCT); fields.push_back(0); }
+        void EmptyStruct(short id) { BeginStruct(id); EndStruct(); }
+        void EndStruct() { out.push_back(0); fields.pop_back(); }
+
+        void BeginList(short id, BYTE elementType, size_t size) {
+            FieldHeader(id, T_LIST);
+            if (size < 15) {
+                out.push_back(static_cast<BYTE>((size << 4) | elementType));
+            } else {
+                out.push_back(static_cast<BYTE>(0xF0 | elementType));
+                Varint(size);
+            }
+        }
+        void BeginElement() { fields.push_back(0); }    // Structure élément de liste
+        void I32Element(int32_t value) { Varint(ZigZag(value)); }
+        void BinaryElement(const std::string& value) { Bytes(value); }
+
+        std::vector<BYTE> Finish() { out.push_back(0); return std::move(out); }
+
+    private:
+        std::vector<BYTE> out;
+        std::vector<short> fields;      // Dernier identifiant par structure ouverte
+
+        void FieldHeader(short id, BYTE type) {
+            const int delta = id - fields.back();
+            if (delta > 0 && delta <= 15) {
+                out.push_back(static_cast<BYTE>((delta << 4) | type));
+            } else {
+                out.push_back(type);
+                Varint(ZigZag(id));
+            }
+            fields.back() = id;
+        }
+        void Bytes(const std::string& value) {
+            Varint(value.size());
+            out.insert(out.end(), value.begin(), value.end());
+        }
+        void Varint(ULONGLONG value) { AppendVarint(out, value); }
+        static ULONGLONG ZigZag(int64_t value) {
+            return (static_cast<ULONGLONG>(value) << 1) ^ static_cast<ULONGLONG>(value >> 63);
+        }
+    };
+
+    static void AppendVarint(std::vector<BYTE>& out, ULONGLONG value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<BYTE>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<BYTE>(value));
+    }
+
+    template<typename T>
+    static void AppendPlain(std::vector<BYTE>& out, T value) {
+        const BYTE* bytes = reinterpret_cast<const BYTE*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    template<typename T>
+    static std::string PlainValue(T value) {
+        return std::string(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static std::string Utf8Name(const std::wstring& name) {
+        std::string result;
+        ResultColumns::AppendUtf8(name, result);
+        return result;
+    }
+
+    static bool IsDictionaryColumn(const std::wstring& name) {
+        return name == L"HiveFile" || name == L"KeyPath" || name == L"LogFile" || name == L"Artifact";
+    }
+
+    static ULONGLONG FieldBytes(const Field& field, size_t rows) {
+        if (field.eventTime) return rows * sizeof(int64_t);
+        switch (field.column->type) {
+        case ResultColumns::Type::Utf8: return field.column->text.size() + rows * sizeof(DWORD);
+        case ResultColumns::Type::UInt32: return rows * sizeof(DWORD);
+        default: return rows * sizeof(ULONGLONG);
+        }
+    }
+
+    // Hybride RLE / bit-packing : un groupe de 8 valeurs identiques prolonge une
+    // plage RLE, les autres sont empaquetés sur bitWidth bits (LSB d'abord)
+    static void EncodeHybrid(const DWORD* values, size_t count, int bitWidth, std::vector<BYTE>& out) {
+        std::vector<BYTE> literal;
+        size_t literalGroups = 0;
+        DWORD runValue = 0;
+        size_t runLength = 0;
+
+        auto flushRun = [&] {
+            if (!runLength) return;
+            AppendVarint(out, runLength << 1);
+            for (int b = 0; b < (bitWidth + 7) / 8; b++) out.push_back(static_cast<BYTE>(runValue >> (8 * b)));
+            runLength = 0;
+        };
+        auto flushLiteral = [&] {
+            if (!literalGroups) return;
+            AppendVarint(out, (literalGroups << 1) | 1);
+            out.insert(out.end(), literal.begin(), literal.end());
+            literal.clear();
+            literalGroups = 0;
+        };
+
+        for (size_t g = 0; g < count; g += 8) {
+            const size_t n = std::min<size_t>(8, count - g);
+            bool uniform = n == 8;
+            for (size_t i = 1; uniform && i < n; i++) uniform = values[g + i] == values[g];
+            if (uniform) {
+                flushLiteral();
+                if (runLength && runValue != values[g]) flushRun();
+                runValue = values[g];
+                runLength += 8;
+                continue;
+            }
+
+            flushRun();
+            ULONGLONG bits = 0;
+            int pending = 0;
+            for (size_t i = 0; i < 8; i++) {
+                bits |= static_cast<ULONGLONG>(i < n ? values[g + i] : 0) << pending;
+                pending += bitWidth;
+                while (pending >= 8) {
+                    literal.push_back(static_cast<BYTE>(bits));
+                    bits >>= 8;
+                    pending -= 8;
+                }
+            }
+            literalGroups++;
+        }
+        flushRun();
+        flushLiteral();
+    }
+
+    static void AppendPage(std::vector<BYTE>& out, PageType type, const std::vector<BYTE>& payload, size_t values,
+                           Encoding encoding) {
+        Thrift header;
+        header.I32(1, type);
+        header.I32(2, static_cast<int32_t>(payload.size()));
+        header.I32(3, static_cast<int32_t>(payload.size()));
+        header.BeginStruct(type == PAGE_DICTIONARY ? 7 : 5);
+        header.I32(1, static_cast<int32_t>(values));
+        header.I32(2, encoding);
+        if (type == PAGE_DATA) {
+            header.I32(3, ENCODING_RLE);
+            header.I32(4, ENCODING_RLE);
+        }
+        header.EndStruct();
+        const std::vector<BYTE> bytes = header.Finish();
+        out.insert(out.end(), bytes.begin(), bytes.end());
+        out.insert(out.end(), payload.begin(), payload.end());
+    }
+
+    static void EncodeChunk(const Field& field, size_t begin, size_t end, Chunk& chunk) {
+        const ResultColumns::Column& column = *field.column;
+        if (field.eventTime) {
+            EncodeEventTime(column, begin, end, chunk);
+        } else if (column.type == ResultColumns::Type::UInt32) {
+            EncodeIntegers(column.u32.data(), begin, end, chunk);
+        } else if (column.type == ResultColumns::Type::UInt64) {
+            EncodeIntegers(column.u64.data(), begin, end, chunk);
+        } else if (!field.dictionary || !EncodeDictionary(column, begin, end, chunk)) {
+            EncodePlainText(column, begin, end, chunk);
+        }
+    }
+
+    template<typename T>
+    static void EncodeIntegers(const T* values, size_t begin, size_t end, Chunk& chunk) {
+        T minValue = values[begin], maxValue = values[begin];
+        std::vector<BYTE> payload;
+        for (size_t page = begin; page < end; page += PARQUET_PAGE_ROWS) {
+            const size_t pageEnd = std::min(end, page + PARQUET_PAGE_ROWS);
+            payload.clear();
+            for (size_t i = page; i < pageEnd; i++) {
+                AppendPlain(payload, values[i]);
+                minValue = std::min(minValue, values[i]);
+                maxValue = std::max(maxValue, values[i]);
+            }
+            AppendPage(chunk.bytes, PAGE_DATA, payload, pageEnd - page, ENCODING_PLAIN);
+        }
+        chunk.stats = true;
+        chunk.minValue = PlainValue(minValue);
+        chunk.maxValue = PlainValue(maxValue);
+    }
+
+    static void EncodeEventTime(const ResultColumns::Column& timestamp, size_t begin, size_t end, Chunk& chunk) {
+        int64_t minValue = 0, maxValue = 0;
+        std::vector<DWORD> defined;
+        std::vector<BYTE> levels, payload;
+        for (size_t page = begin; page < end; page += PARQUET_PAGE_ROWS) {
+            const size_t pageEnd = std::min(end, page + PARQUET_PAGE_ROWS);
+            defined.clear();
+            levels.clear();
+            std::vector<BYTE> values;
+            for (size_t i = page; i < pageEnd; i++) {
+                const char* text = timestamp.text.data() + timestamp.offsets[i];
+                const size_t size = static_cast<size_t>(timestamp.offsets[i + 1] - timestamp.offsets[i]);
+                int64_t micros = 0;
+                const bool valid = ParseEventTime(text, size, micros);
+                micros *= 1000000LL;
+                defined.push_back(valid ? 1 : 0);
+                if (!valid) {
+                    chunk.nulls++;
+                    continue;
+                }
+                AppendPlain(values, micros);
+                if (!chunk.stats || micros < minValue) minValue = micros;
+                if (!chunk.stats || micros > maxValue) maxValue = micros;
+                chunk.stats = true;
+            }
+
+            // Niveaux de définition : longueur sur 4 octets puis hybride RLE (1 bit)
+            EncodeHybrid(defined.data(), defined.size(), 1, levels);
+            payload.clear();
+            AppendPlain(payload, static_cast<DWORD>(levels.size()));
+            payload.insert(payload.end(), levels.begin(), levels.end());
+            payload.insert(payload.end(), values.begin(), values.end());
+            AppendPage(chunk.bytes, PAGE_DATA, payload, pageEnd - page, ENCODING_PLAIN);
+        }
+        if (chunk.stats) {
+            chunk.minValue = PlainValue(minValue);
+            chunk.maxValue = PlainValue(maxValue);
+        }
+    }
+
+    // Bornes min/max d'une chaîne en ordre d'octets non signés ; omises si trop longues
+    static void TextStats(const ResultColumns::Column& column, size_t begin, size_t end, Chunk& chunk) {
+        auto value = [&column](size_t row) {
+            return std::make_pair(column.text.data() + column.offsets[row],
+                                  static_cast<size_t>(column.offsets[row + 1] - column.offsets[row]));
+        };
+        auto less = [](const std::pair<const char*, size_t>& a, const std::pair<const char*, size_t>& b) {
+            const size_t common = std::min(a.second, b.second);
+            const int order = common ? memcmp(a.first, b.first, common) : 0;
+            return order < 0 || (order == 0 && a.second < b.second);
+        };
+        auto minValue = value(begin), maxValue = value(begin);
+        for (size_t i = begin + 1; i < end; i++) {
+            const auto current = value(i);
+            if (less(current, minValue)) minValue = current;
+            if (less(maxValue, current)) maxValue = current;
+        }
+        if (maxValue.second > PARQUET_MAX_STAT_BYTES || minValue.second > PARQUET_MAX_STAT_BYTES) return;
+        chunk.stats = true;
+        chunk.minValue.assign(minValue.first, minValue.second);
+        chunk.maxValue.assign(maxValue.first, maxValue.second);
+    }
+
+    static void AppendText(std::vector<BYTE>& out, const char* text, size_t size) {
+        AppendPlain(out, static_cast<DWORD>(size));
+        out.insert(out.end(), text, text + size);
+    }
+
+    static void EncodePlainText(const ResultColumns::Column& column, size_t begin, size_t end, Chunk& chunk) {
+        std::vector<BYTE> payload;
+        for (size_t page = begin; page < end; page += PARQUET_PAGE_ROWS) {
+            const size_t pageEnd = std::min(end, page + PARQUET_PAGE_ROWS);
+            payload.clear();
+            for (size_t i = page; i < pageEnd; i++) {
+                AppendText(payload, column.text.data() + column.offsets[i],
+                           static_cast<size_t>(column.offsets[i + 1] - column.offsets[i]));
+            }
+            AppendPage(chunk.bytes, PAGE_DATA, payload, pageEnd - page, ENCODING_PLAIN);
+        }
+        TextStats(column, begin, end, chunk);
+    }
+
+    // false si le dictionnaire dépasse PARQUET_MAX_DICTIONARY_BYTES : le chunk passe en PLAIN
+    static bool EncodeDictionary(const ResultColumns::Column& column, size_t begin, size_t end, Chunk& chunk) {
+        std::unordered_map<std::string, DWORD> ids;
+        std::vector<DWORD> indices;
+        std::vector<BYTE> dictionary;
+        indices.reserve(end - begin);
+        for (size_t i = begin; i < end; i++) {
+            const char* text = column.text.data() + column.offsets[i];
+            const size_t size = static_cast<size_t>(column.offsets[i + 1] - column.offsets[i]);
+            auto inserted = ids.emplace(std::string(text, size), static_cast<DWORD>(ids.size()));
+            if (inserted.second) {
+                AppendText(dictionary, text, size);
+                if (dictionary.size() > PARQUET_MAX_DICTIONARY_BYTES) return false;
+            }
+            indices.push_back(inserted.first->second);
+        }
+
+        int bitWidth = 1;
+        while ((1ULL << bitWidth) < ids.size()) bitWidth++;
+
+        AppendPage(chunk.bytes, PAGE_DICTIONARY, dictionary, ids.size(), ENCODING_PLAIN);
+        chunk.dataOffset = chunk.bytes.size();
+        std::vector<BYTE> payload;
+        for (size_t page = 0; page < indices.size(); page += PARQUET_PAGE_ROWS) {
+            const size_t count = std::min<size_t>(PARQUET_PAGE_ROWS, indices.size() - page);
+            payload.assign(1, static_cast<BYTE>(bitWidth));
+            EncodeHybrid(indices.data() + page, count, bitWidth, payload);
+            AppendPage(chunk.bytes, PAGE_DATA, payload, count, ENCODING_RLE_DICTIONARY);
+        }
+        TextStats(column, begin, end, chunk);
+        return true;
+    }
+
+    static std::vector<BYTE> Footer(const std::vector<Field>& fields, const std::vector<RowGroup>& groups, size_t rows) {
+        Thrift meta;
+        meta.I32(1, 1);     // version
+
+        // Schéma : racine puis une feuille par colonne
+        meta.BeginList(2, Thrift::T_STRUCT, fields.size() + 1);
+        meta.BeginElement();
+        meta.Binary(4, "schema");
+        meta.I32(5, static_cast<int32_t>(fields.size()));
+        meta.EndStruct();
+        for (const auto& field : fields) {
+            meta.BeginElement();
+            meta.I32(1, PhysicalTypeOf(field));
+            meta.I32(3, field.eventTime ? REPETITION_OPTIONAL : REPETITION_REQUIRED);
+            meta.Binary(4, field.name);
+            meta.I32(6, ConvertedTypeOf(field));
+            meta.BeginStruct(10);   // logicalType
+            if (field.eventTime) {
+                meta.BeginStruct(8);
+                meta.Bool(1, true);     // isAdjustedToUTC
+                meta.BeginStruct(2);
+                meta.EmptyStruct(2);    // MICROS
+                meta.EndStruct();
+                meta.EndStruct();
+            } else if (field.column->type == ResultColumns::Type::Utf8) {
+                meta.EmptyStruct(1);    // STRING
+            } else {
+                meta.BeginStruct(10);   // INTEGER
+                meta.Byte(1, field.column->type == ResultColumns::Type::UInt32 ? 32 : 64);
+                meta.Bool(2, false);
+                meta.EndStruct();
+            }
+            meta.EndStruct();
+            meta.EndStruct();
+        }
+
+        meta.I64(3, static_cast<int64_t>(rows));
+        meta.BeginList(4, Thrift::T_STRUCT, groups.size());
+        for (const auto& group : groups) {
+            meta.BeginElement();
+            meta.BeginList(1, Thrift::T_STRUCT, group.chunks.size());
+            for (size_t c = 0; c < group.chunks.size(); c++) {
+                const ChunkMeta& chunk = group.chunks[c];
+                meta.BeginElement();
+                meta.I64(2, static_cast<int64_t>(chunk.offset));
+                meta.BeginStruct(3);
+                meta.I32(1, PhysicalTypeOf(fields[c]));
+                meta.BeginList(2, Thrift::T_I32, chunk.dictionary ? 3 : 2);
+                meta.I32Element(ENCODING_PLAIN);
+                meta.I32Element(ENCODING_RLE);
+                if (chunk.dictionary) meta.I32Element(ENCODING_RLE_DICTIONARY);
+                meta.BeginList(3, Thrift::T_BINARY, 1);
+                meta.BinaryElement(fields[c].name);
+                meta.I32(4, 0);     // UNCOMPRESSED
+                meta.I64(5, static_cast<int64_t>(group.rows));
+                meta.I64(6, static_cast<int64_t>(chunk.size));
+                meta.I64(7, static_cast<int64_t>(chunk.size));
+                meta.I64(9, static_cast<int64_t>(chunk.dataOffset));
+                if (chunk.dictionary) meta.I64(11, static_cast<int64_t>(chunk.offset));
+                meta.BeginStruct(12);   // statistics
+                meta.I64(3, chunk.nulls);
+                if (chunk.stats) {
+                    meta.Binary(5, chunk.maxValue);
+                    meta.Binary(6, chunk.minValue);
+                }
+                meta.EndStruct();
+                meta.EndStruct();
+                meta.EndStruct();
+            }
+            meta.I64(2, static_cast<int64_t>(group.size));
+            meta.I64(3, static_cast<int64_t>(group.rows));
+            meta.I64(5, static_cast<int64_t>(group.offset));
+            meta.I64(6, static_cast<int64_t>(group.size));
+            meta.EndStruct();
+        }
+
+        meta.Binary(6, "RegistryTransactionLogParser (WinToolsSuite)");
+
+        // Ordre défini par le type : min/max des chaînes et entiers non signés valides
+        meta.BeginList(7, Thrift::T_STRUCT, fields.size());
+        for (size_t c = 0; c < fields.size(); c++) {
+            meta.BeginElement();
+            meta.EmptyStruct(1);
+            meta.EndStruct();
+        }
+        return meta.Finish();
+    }
+
+    static int32_t ConvertedTypeOf(const Field& field) {
+        if (field.eventTime) return CONVERTED_TIMESTAMP_MICROS;
+        switch (field.column->type) {
+        case ResultColumns::Type::Utf8: return CONVERTED_UTF8;
+        case ResultColumns::Type::UInt32: return CONVERTED_UINT_32;
+        default: return CONVERTED_UINT_64;
+        }
+    }
+
+    static int32_t PhysicalTypeOf(const Field& field) {
+        if (field.eventTime) return TYPE_INT64;
+        switch (field.column->type) {
+        case ResultColumns::Type::Utf8: return TYPE_BYTE_ARRAY;
+        case ResultColumns::Type::UInt32: return TYPE_INT32;
+        default: return TYPE_INT64;
+        }
+    }
+};
+
+// Logs synthétiques de l'auto-contrôle : base block "regf" puis entrées HvLE de
+// tailles variées portant des chemins de clés (dont des emplacements de
+// persistance), entrecoupées de zones corrompues : tailles incohérentes,
+// signatures orphelines, trous non alignés et fausses entrées logées dans les
+// données d'une entrée (faux positifs des partitions). En mode fuzz, des octets
+// sont ensuite altérés au hasard.
+class SyntheticLog {
+public:
+    static std::vector<BYTE> Generate(std::mt19937_64& rng, bool fuzz) {
+        std::uniform_int_distribution<size_t> sizeDist(SELFCHECK_MIN_SIZE, SELFCHECK_MAX_SIZE);
+        const size_t target = sizeDist(rng);
+
+        std::vector<BYTE> out(sizeof(REGF_HEADER), 0);
+        Put<DWORD>(out, 0, 0x66676572); // "regf"
+        DWORD sequence = 1;
+        while (out.size() < target) {
+            const unsigned kind = static_cast<unsigned>(rng() % 100);
+            if (kind < 80) {
+                AppendEntry(rng, out, sequence++, false, false);
+            } else if (kind < 88) {
+                AppendGarbage(rng, out);
+            } else if (kind < 94) {
+                AppendBadEntry(rng, out, sequence++);
+            } else {
+                AppendEntry(rng, out, sequence++, false, true);
+            }
+        }
+        if (fuzz) Mutate(rng, out);
+        return out;
+    }
+
+    static bool Save(const std::wstring& path, const std::vector<BYTE>& data) {
+        FileHandle hFile(CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+        DWORD written = 0;
+        return hFile.valid() && WriteFile(hFile, data.data(), static_cast<DWORD>(data.size()), &written, nullptr) &&
+               written == data.size();
+    }
+
+    // Copie gzip en blocs DEFLATE "stored" : un seul membre, ou des membres BGZF
+    // (taille du membre dans le champ extra "BC", sortie bornée par BGZF_MAX_BLOCK)
+    static std::vector<BYTE> Gzip(const std::vector<BYTE>& data, bool bgzf) {
+        const size_t chunk = bgzf ? BGZF_MAX_BLOCK - 256 : 65535;  // Membre BGZF entier sous 64 Ko
+        std::vector<BYTE> out;
+        size_t pos = 0;
+        do {
+            const size_t member = out.size();
+            const BYTE header[10] = { 0x1F, 0x8B, 8, static_cast<BYTE>(bgzf ? GZIP_FEXTRA : 0), 0, 0, 0, 0, 0, 0xFF };
+            out.insert(out.end(), header, header + sizeof(header));
+            if (bgzf) {
+                const BYTE extra[8] = { 6, 0, 'B', 'C', 2, 0, 0, 0 };   // BSIZE renseigné à la fin du membre
+                out.insert(out.end(), extra, extra + sizeof(extra));
+            }
+
+            const size_t first = pos;
+            do {
+                const size_t len = std::min(chunk, data.size() - pos);
+                const bool last = bgzf || pos + len == data.size();
+                const BYTE block[5] = { static_cast<BYTE>(last ? 1 : 0), static_cast<BYTE>(len), static_cast<BYTE>(len >> 8),
+                                        static_cast<BYTE>(~len), static_cast<BYTE>(~len >> 8) };
+                out.insert(out.end(), block, block + sizeof(block));
+                out.insert(out.end(), data.begin() + pos, data.begin() + pos + len);
+                pos += len;
+                if (last) break;
+            } while (true);
+
+            const size_t trailer = out.size();
+            out.resize(trailer + 8);
+            Put<DWORD>(out, trailer, DeflateDecoder::Crc32(data.data() + first, pos - first));
+            Put<DWORD>(out, trailer + 4, static_cast<DWORD>(pos - first));
+            if (bgzf) Put<WORD>(out, member + 16, static_cast<WORD>(out.size() - member - 1));
+        } while (pos < data.size());
+        return out;
+    }
+
+    // Corruption appliquée par Build, en probabilités
+    struct Corruption {
+        double bitFlip;             // Par secteur : un bit inversé
+        double zeroSector;          // Par secteur : remis à zéro
+        double repeatedSignature;   // Par secteur : signature HvLE orpheline en tête
+        double truncatedEntry;      // Par entrée : données coupées, taille annoncée conservée
+        double bogusSize;           // Par entrée : champ size aléatoire
+        bool truncateTail;          // Log coupé au milieu de sa dernière entrée
+    };
+
+    // Log du banc d'essai : entrées enchaînées comme dans un vrai log, puis
+    // corruption aux taux demandés. entries reçoit les offsets des entrées restées
+    // intactes après corruption, damaged ceux des entrées écrites entières puis
+    // endommagées par les secteurs altérés (ni attendues, ni faux positifs).
+    static std::vector<BYTE> Build(std::mt19937_64& rng, size_t target, const Corruption& corruption,
+                                   std::vector<size_t>& entries, std::vector<size_t>& damaged) {
+        std::vector<BYTE> out(sizeof(REGF_HEADER), 0);
+        Put<DWORD>(out, 0, 0x66676572); // "regf"
+        std::bernoulli_distribution truncated(corruption.truncatedEntry), bogus(corruption.bogusSize);
+        std::vector<size_t> ends;
+        DWORD sequence = 1;
+        while (out.size() < target) {
+            const size_t start = out.size();
+            AppendEntry(rng, out, sequence++, true, false);
+            const size_t dataSize = out.size() - start - offsetof(LOG_ENTRY_HEADER, data);
+            if (truncated(rng)) {
+                out.resize(start + offsetof(LOG_ENTRY_HEADER, data) + rng() % (dataSize + 1));
+                PadToAlignment(rng, out);
+            } else if (bogus(rng)) {
+                Put(out, start + 4, static_cast<DWORD>(rng()));
+            } else {
+                entries.push_back(start);
+                ends.push_back(out.size());
+            }
+        }
+
+        std::bernoulli_distribution flip(corruption.bitFlip), zero(corruption.zeroSector),
+                                    signature(corruption.repeatedSignature);
+        std::vector<ByteRange> altered;
+        for (size_t sector = ENTRY_ALIGNMENT; sector + ENTRY_ALIGNMENT <= out.size(); sector += ENTRY_ALIGNMENT) {
+            if (flip(rng)) {
+                const size_t at = sector + rng() % ENTRY_ALIGNMENT;
+                out[at] ^= static_cast<BYTE>(1u << (rng() % 8));
+                altered.emplace_back(at, at + 1);
+            }
+            if (zero(rng)) {
+                std::fill(out.begin() + sector, out.begin() + sector + ENTRY_ALIGNMENT, BYTE(0));
+                altered.emplace_back(sector, sector + ENTRY_ALIGNMENT);
+            }
+            if (signature(rng)) {
+                Put(out, sector, SIGNATURE_HVLE);
+                altered.emplace_back(sector, sector + sizeof(DWORD));
+            }
+        }
+        if (corruption.truncateTail && !entries.empty()) {
+            out.resize(entries.back() + (out.size() - entries.back()) / 2);
+            if (out.size() < ends.back()) altered.emplace_back(out.size(), ends.back());
+        }
+
+        // Entrées touchées par une plage altérée : celle qui contient son début et les suivantes
+        std::vector<bool> hit(entries.size());
+        for (const ByteRange& range : altered) {
+            size_t e = static_cast<size_t>(std::upper_bound(entries.begin(), entries.end(), range.first) - entries.begin());
+            if (e) e--;
+            for (; e < entries.size() && entries[e] < range.second; e++) {
+                if (ends[e] > range.first) hit[e] = true;
+            }
+        }
+        std::vector<size_t> intact;
+        for (size_t e = 0; e < entries.size(); e++) (hit[e] ? damaged : intact).push_back(entries[e]);
+        entries.swap(intact);
+        return out;
+    }
+
+private:
+    static constexpr DWORD SIGNATURE_HVLE = 0x656C7648;
+    static constexpr DWORD SIGNATURE_HKNH = 0x486B6E68;
+
+    template<typename T>
+    static void Put(std::vector<BYTE>& out, size_t offset, T value) {
+        memcpy(out.data() + offset, &value, sizeof(T));
+    }
+
+    static void AppendHeader(std::vector<BYTE>& out, size_t at, DWORD signature, DWORD size, DWORD offset, DWORD sequence) {
+        Put(out, at, signature);
+        Put(out, at + 4, size);
+        Put(out, at + 8, offset);
+        Put(out, at + 12, sequence);
+    }
+
+    static void AppendRandom(std::mt19937_64& rng, std::vector<BYTE>& out, size_t count) {
+        for (size_t i = 0; i < count; i++) out.push_back(static_cast<BYTE>(rng()));
+    }
+
+    static const wchar_t* RandomKeyPath(std::mt19937_64& rng) {
+        static const wchar_t* const paths[] = {
+            L"ControlSet001\\Services\\Tcpip\\Parameters",
+            L"ControlSet001\\Services\\EvilSvc",
+            L"ControlSet001\\Control\\Session Manager\\AppCompatCache",
+            L"Microsoft\\Windows\\CurrentVersion\\Run",
+            L"Microsoft\\Windows NT\\CurrentVersion\\Image File Execution Options\\sethc.exe",
+            L"Microsoft\\Windows NT\\CurrentVersion\\Winlogon",
+            L"Microsoft\\Windows NT\\CurrentVersion\\Schedule\\TaskCache\\Tree\\Updater",
+            L"Software\\Classes\\CLSID",
+            L"abc",
+        };
+        return paths[rng() % _countof(paths)];
+    }
+
+    // aligned : entrée d'un vrai log, sans tirage de granularité (banc d'essai)
+    static void AppendEntry(std::mt19937_64& rng, std::vector<BYTE>& out, DWORD sequence, bool aligned, bool nested) {
+        size_t dataSize;
+        switch (rng() % 4) {
+        case 0: dataSize = 16 + rng() % 512; break;
+        case 1: dataSize = 4096 - offsetof(LOG_ENTRY_HEADER, data); break;
+        case 2: dataSize = 4096 + rng() % (32 * 1024); break;
+        default: dataSize = rng() % 2048; break;
+        }
+        // Tailles réelles multiples de ENTRY_ALIGNMENT ; les autres enchaînent sur une entrée non alignée
+        const DWORD granularity = aligned || rng() % 4 ? ENTRY_ALIGNMENT : 4;
+        const DWORD size = static_cast<DWORD>((offsetof(LOG_ENTRY_HEADER, data) + dataSize + granularity - 1)
+                                              / granularity * granularity);
+
+        const size_t start = out.size();
+        out.resize(start + offsetof(LOG_ENTRY_HEADER, data));
+        AppendHeader(out, start, rng() % 20 ? SIGNATURE_HVLE : SIGNATURE_HKNH, size,
+                     static_cast<DWORD>(rng() % 4096) * 4096, sequence);
+        AppendRandom(rng, out, size - offsetof(LOG_ENTRY_HEADER, data));
+
+        // Chemin de clé UTF-16 en tête des données
+        if (rng() % 5) {
+            const wchar_t* path = RandomKeyPath(rng);
+            size_t at = start + offsetof(LOG_ENTRY_HEADER, data);
+            for (size_t i = 0; path[i] && at + 4 <= out.size(); i++, at += 2) Put<WORD>(out, at, path[i]);
+            if (at + 2 <= out.size()) Put<WORD>(out, at, 0);
+        }
+
+        // Fausse entrée sur une frontière d'alignement à l'intérieur des données
+        if (nested) {
+            const size_t fake = (start + offsetof(LOG_ENTRY_HEADER, data)) / ENTRY_ALIGNMENT * ENTRY_ALIGNMENT + ENTRY_ALIGNMENT;
+            if (fake + offsetof(LOG_ENTRY_HEADER, data) <= out.size()) {
+                AppendHeader(out, fake, SIGNATURE_HVLE, static_cast<DWORD>(16 + (rng() % 2048) * 4), 0, sequence);
+            }
+        }
+    }
+
+    static void AppendGarbage(std::mt19937_64& rng, std::vector<BYTE>& out) {
+        const size_t start = out.size();
+        AppendRandom(rng, out, 1 + rng() % 3000);
+        for (unsigned i = static_cast<unsigned>(rng() % 3); i > 0; i--) {
+            const size_t at = start + rng() % (out.size() - start);
+            if (at + 4 <= out.size()) Put(out, at, SIGNATURE_HVLE);
+        }
+        PadToAlignment(rng, out);
+    }
+
+    // L'entrée suivante reprend sur une frontière de resynchronisation
+    static void PadToAlignment(std::mt19937_64& rng, std::vector<BYTE>& out) {
+        AppendRandom(rng, out, (ENTRY_ALIGNMENT - out.size() % ENTRY_ALIGNMENT) % ENTRY_ALIGNMENT);
+    }
+
+    // Signature valide, taille hors limites, non multiple de 4 ou inférieure à l'en-tête
+    static void AppendBadEntry(std::mt19937_64& rng, std::vector<BYTE>& out, DWORD sequence) {
+        static const DWORD sizes[] = { 0, 8, 13, 0x10002, 0xFFFFFFF0 };
+        const size_t start = out.size();
+        out.resize(start + offsetof(LOG_ENTRY_HEADER, data));
+        AppendHeader(out, start, SIGNATURE_HVLE, sizes[rng() % _countof(sizes)], 0, sequence);
+        AppendRandom(rng, out, 64 + rng() % 1024);
+        PadToAlignment(rng, out);
+    }
+
+    static void Mutate(std::mt19937_64& rng, std::vector<BYTE>& out) {
+        for (unsigned i = 1 + static_cast<unsigned>(rng() % 64); i > 0 && out.size() > ENTRY_ALIGNMENT; i--) {
+            const size_t at = rng() % (out.size() - 16);
+            switch (rng() % 4) {
+            case 0:
+                out[at] ^= static_cast<BYTE>(1u << (rng() % 8));
+                break;
+            case 1: {
+                const size_t aligned = std::max<size_t>(ENTRY_ALIGNMENT, at / ENTRY_ALIGNMENT * ENTRY_ALIGNMENT);
+                AppendHeader(out, aligned, SIGNATURE_HVLE, static_cast<DWORD>(16 + (rng() % 4096) * 4), 0, 0);
+                break;
+            }
+            case 2:
+                std::fill(out.begin() + at, out.begin() + std::min(out.size(), at + rng() % 2048), BYTE(0));
+                break;
+            default:
+                if (rng() % 8 == 0) out.resize(at + 16);  // Log tronqué
+                break;
+            }
+        }
+    }
+};
+
+// Classe principale
+// Dossier du module contenant ce code : l'exécutable, ou la DLL en mode bibliothèque
+inline std::wstring ModuleDirectory() {
+    HMODULE module = nullptr;
+    GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                       reinterpret_cast<LPCWSTR>(&ModuleDirectory), &module);
+    wchar_t path[MAX_PATH];
+    GetModuleFileNameW(module, path, MAX_PATH);
+    PathRemoveFileSpecW(path);
+    return path;
+}
+
+class RegistryTransactionLogParser {
+private:
+    HWND hwndMain, hwndList, hwndStatus, hwndEditPath;
+    RecordVector transactions;          // Segment privé du parser, publié dans la session cible
+    Workspace workspace;
+    ParseSession* parseTarget;          // Session alimentée par le thread de travail
+    SnapshotPublisher noResults;        // Vue vide tant qu'aucune session n'existe
+    const SnapshotPublisher* displayedResults;  // Contenu actuellement affiché dans la ListView
+    ResultSnapshot displayed;           // Instantané servi à la ListView virtuelle (LVN_GETDISPINFO)
+    bool displayedFiltered;
+    std::vector<size_t> displayedRows;  // Rang de l'enregistrement de chaque ligne si displayedFiltered
+    std::wstring displayedText;         // Texte calculé de la dernière cellule servie
+    std::wstring filterExpression;      // Filtre interactif de la liste (vide : tout afficher)
+    RecordBitmap filtered;              // Enregistrements retenus par filterExpression
+    ResultFilter resultFilter;
+    size_t filterScanned;               // Dernière évaluation : enregistrements examinés, durée
+    double filterMs;
+    std::wstring currentLogPath;
+    std::wstring rarityPath;            // Modèle de rareté persistant (RarityModel)
+    DWORD exportFilterIndex;            // Filtre du dernier export (1 : CSV, 2 : Parquet)
+    std::wofstream logFile;
+    HANDLE hWorkerThread;
+    volatile bool stopProcessing;
+    bool useDirectIO;
+    bool keepPages;
+
+    enum class WorkMode { Parse, Sample, Distributed };
+    WorkMode workMode;
+    std::wstring listenAddress;     // Adresse d'écoute du coordinateur
+
+    // Métriques du dernier parsing
+    RssSampler rssSampler;
+    ULONGLONG bytesParsed;
+    std::wstring lastMetrics;
+    std::wstring lastStatus;
+    double lastElapsedMs;
+    SIZE_T lastPeakRss;
+    size_t lastStringBytes;
+
+    // Destinataire des enregistrements par tranches de SINK_BATCH_RECORDS au fil du
+    // transfert des partitions (mode bibliothèque) ; false interrompt le parsing
+    std::function<bool(const TransactionEntry*, size_t)> recordSink;
+    size_t streamed = 0;        // Enregistrements de transactions déjà remis au sink
+
+    // Comptage des hôtes de la flotte : identité donnée par l'appelant, sinon
+    // déduite du dossier de preuves de chaque fichier (voir HostIdentity)
+    std::wstring rarityHost;
+    bool fleetCounting;
+
+    // Vue en colonnes de la session active (mode bibliothèque), reconstruite
+    // quand la session ou sa version publiée change
+    std::shared_ptr<const ResultColumns> columns;
+    const SnapshotPublisher* columnsSource;
+    ULONGLONG columnsVersion;
+
+    // Index LSH de la session active, complété à chaque recherche de valeurs similaires
+    SimilarityIndex similarity;
+
+    // Entrées décodées lors de l'échantillonnage (offset fichier -> entrée),
+    // réutilisées si la session est promue en parsing complet.
+    std::map<size_t, TransactionEntry, std::less<size_t>,
+             CountingAllocator<std::pair<const size_t, TransactionEntry>, MEM_INDEXES>> sampleCache;
+    std::wstring samplePath;
+    std::wstring sampleSummary;
+
+    // Requête à arrêt anticipé : les queryMaxMatches premières correspondances dans
+    // l'ordre du fichier. Une partition s'arrête dès qu'elle en a assez à elle seule,
+    // et les partitions suivantes avec elle (queryCutoff) ; le raccord, dans l'ordre
+    // des partitions, reprend celles dont il manque encore des correspondances.
+    // queryStop signale un fichier coupé (et arrête le lot si queryStopBatch).
+    std::wstring queryText;         // En minuscules, vide = pas de filtre
+    size_t queryMaxMatches;         // 0 = illimité
+    bool queryStopBatch;
+    std::atomic<size_t> queryCutoff;    // Rang de la première partition arrêtée sur sa limite
+    std::atomic<bool> queryStop;
+
+    // Partition d'un fichier LOG parcourue par un thread
+    struct ScanPartition {
+        RegistryTransactionLogParser* owner;
+        const BYTE* data;
+        size_t dataSize;
+        size_t begin, end;
+        const std::wstring* hiveName;
+        const std::wstring* logFile;
+        const KeyPathResolver* keyPaths;                            // Chemins reconstitués (nullptr : heuristique)
+        bool reuseSample;
+        // (offset, taille) des entrées valides
+        std::vector<std::pair<size_t, DWORD>, CountingAllocator<std::pair<size_t, DWORD>, MEM_INDEXES>> spans;
+        // Entrées retenues par la requête
+        std::vector<std::pair<size_t, TransactionEntry>,
+                    CountingAllocator<std::pair<size_t, TransactionEntry>, MEM_RECORDS>> results;
+        ByteRanges skipped;                                         // Plages franchies par resynchronisation
+        const LogIndex* index;                                      // Index connu : [indexBegin, indexEnd) à décoder
+        size_t indexBegin, indexEnd;
+        size_t resume;                                              // Offset où le parcours s'est arrêté
+        size_t reused;
+        size_t ordinal;                                             // Rang dans le fichier
+        size_t cap;                                                 // Correspondances suffisantes (0 = illimité)
+        bool capped;                                                // Arrêtée avant sa fin : reprise à resume
+    };
+
+    void Log(const std::wstring& message) {
+        if (logFile.is_open()) {
+            SYSTEMTIME st;
+            GetLocalTime(&st);
+            wchar_t timeStr[64];
+            swprintf_s(timeStr, L"[%02d/%02d/%04d %02d:%02d:%02d] ",
+                      st.wDay, st.wMonth, st.wYear, st.wHour, st.wMinute, st.wSecond);
+            logFile << timeStr << message << std::endl;
+            logFile.flush();
+        }
+    }
+
+    void UpdateStatus(const std::wstring& text) {
+        SetWindowTextW(hwndStatus, text.c_str());
+        lastStatus = text;
+        Log(text);
+    }
+
+    std::wstring FileTimeToString(FILETIME ft) {
+        SYSTEMTIME st;
+        if (FileTimeToSystemTime(&ft, &st)) {
+            wchar_t buf[128];
+            swprintf_s(buf, L"%02d/%02d/%04d %02d:%02d:%02d",
+                      st.wDay, st.wMonth, st.wYear, st.wHour, st.wMinute, st.wSecond);
+            return buf;
+        }
+        return L"N/A";
+    }
+
+    std::wstring DwordToHex(DWORD value) {
+        wchar_t buf[32];
+        swprintf_s(buf, L"0x%08X", value);
+        return buf;
+    }
+
+    std::wstring BytesToHex(const BYTE* data, size_t len) {
+        if (len > 64) len = 64; // Limite pour affichage
+        std::wstringstream ss;
+        for (size_t i = 0; i < len; i++) {
+            wchar_t buf[4];
+            swprintf_s(buf, L"%02X", data[i]);
+            ss << buf;
+            if (i < len - 1) ss << L" ";
+        }
+        return ss.str();
+    }
+
+    // Identité du hive d'un fichier, calculée une fois par fichier (chemin, taille, date)
+    std::wstring HiveLabel(const std::wstring& path, const BYTE* baseBlock, size_t size) {
+        const std::wstring key = LogIndexCache::Identity(path);
+        std::shared_ptr<const HiveIdentity> hive = key.empty() ? nullptr : workspace.hives.Find(key);
+        if (!hive) {
+            hive = std::make_shared<HiveIdentity>(HiveIdentity::Resolve(baseBlock, size, path));
+            if (!key.empty()) workspace.hives.Store(key, hive);
+            Log(L"Hive : " + hive->Label() + L" [" + hive->kind + L"]"
+                + (hive->embeddedPath.empty() ? L" (nom de fichier)" : L", base block : " + hive->embeddedPath));
+        }
+        return hive->Label();
+    }
+
+    void DecodeEntry(const LOG_ENTRY_HEADER* entry, const std::wstring& hiveName, const std::wstring& logFile,
+                     size_t fileOffset, TransactionEntry& tx) {
+        DecodeContent(entry, tx);
+        SetLocation(tx, hiveName, logFile, fileOffset, Fnv1a64(entry, entry->size));
+    }
+
+    // Champs propres à l'emplacement de l'entrée (hors texte décodé)
+    static void SetLocation(TransactionEntry& tx, const std::wstring& hiveName, const std::wstring& logFile,
+                            size_t fileOffset, ULONGLONG contentHash) {
+        tx.hiveFile = hiveName;
+        tx.logFile = logFile;
+        tx.fileOffset = fileOffset;
+        tx.contentHash = contentHash;
+        tx.pageId = PAGE_NONE;
+    }
+
+    // Champs déduits du seul contenu de l'entrée
+    void DecodeContent(const LOG_ENTRY_HEADER* entry, TransactionEntry& tx) {
+        // Timestamp : utiliser la séquence comme approximation temporelle
+        FILETIME ft;
+        GetSystemTimeAsFileTime(&ft);
+        tx.timestamp = FileTimeToString(ft) + LOG_SEQUENCE_TAG + std::to_wstring(entry->sequenceNumber) + L")";
+
+        tx.offset = entry->offset;
+        tx.txID = DwordToHex(entry->sequenceNumber);
+        tx.sequence = entry->sequenceNumber;
+
+        // Tentative d'extraction de key path (heuristique)
+        // Recherche de strings Unicode dans les données
+        std::wstring extractedPath;
+        for (DWORD i = 0; i < std::min<DWORD>(entry->size, 512); i += 2) {
+            if (i + 2 <= entry->size) {
+                wchar_t ch = *reinterpret_cast<const wchar_t*>(&entry->data[i]);
+                if (ch >= 32 && ch < 127) {
+                    extractedPath += ch;
+                } else if (extractedPath.length() > 0) {
+                    break;
+                }
+            }
+        }
+
+        if (extractedPath.length() > 3) {
+            tx.keyPath = extractedPath;
+        } else {
+            tx.keyPath = L"<Key @ offset " + DwordToHex(entry->offset) + L">";
+        }
+
+        tx.valueName = L"<Dirty Page>";
+        tx.dataBefore = L"<Uncommitted>";
+        tx.dataAfter = BytesToHex(entry->data, std::min<DWORD>(entry->size, 32));
+
+        // Artefact : seulement sur un chemin reconstitué (ApplyKeyPath)
+        tx.artifact.clear();
+        tx.details.clear();
+
+        // Signature MinHash des données de valeur lisibles dans la page ; sans valeur
+        // lisible, la signature reste invalide (en-têtes de page communs à toutes)
+        const HivePage page(entry);
+        MinHash::Builder minhash;
+        page.ForEachValue([&](const ValueCell& cell) {
+            const BYTE* bytes = nullptr;
+            size_t length = 0;
+            if (page.ValueBytes(cell, bytes, length)) minhash.Add(bytes, length);
+        });
+        minhash.Finish(tx.signature);
+    }
+
+    // Chemin reconstitué de la page (le chemin heuristique de DecodeContent n'est
+    // jamais un vrai chemin de clé) et décodage de l'emplacement de persistance
+    static void ApplyKeyPath(const KeyPathResolver& keyPaths, const LOG_ENTRY_HEADER* entry, TransactionEntry& tx) {
+        std::wstring path;
+        if (!keyPaths.PagePath(entry, path)) return;
+        tx.keyPath = path;
+        tx.artifact.clear();
+        tx.details.clear();
+        if (const ArtifactDecoder* decoder = ArtifactDispatch::Instance().Match(path)) {
+            tx.artifact = decoder->name;
+            tx.details = decoder->Decode(HivePage(entry), path);
+        }
+    }
+
+    // Hive primaire voisin d'un log (SYSTEM pour SYSTEM.LOG1.gz), vide sinon
+    static std::wstring PrimaryHivePath(const std::wstring& path) {
+        std::wstring primaryPath = CompressedInput::StripExtension(path);
+        const wchar_t* ext = PathFindExtensionW(primaryPath.c_str());
+        if (_wcsicmp(ext, L".LOG") != 0 && _wcsicmp(ext, L".LOG1") != 0 && _wcsicmp(ext, L".LOG2") != 0) return L"";
+        primaryPath.resize(ext - primaryPath.c_str());
+        return primaryPath;
+    }
+
+    // Signature connue et structure cohérente : taille couvrant au moins l'en-tête,
+    // multiple de 4, bornée et contenue dans les données.
+    static bool IsEntryAt(const BYTE* data, size_t dataSize, size_t offset) {
+        if (offset + sizeof(LOG_ENTRY_HEADER) >= dataSize) return false;
+        const LOG_ENTRY_HEADER* entry = reinterpret_cast<const LOG_ENTRY_HEADER*>(data + offset);
+
+        // Signature "HvLE" (0x456C7648) pour dirty page
+        if (entry->signature != 0x656C7648 && entry->signature != 0x486B6E68) { // "HvLE" ou "hknh" (hive node header)
+            return false;
+        }
+        return entry->size >= offsetof(LOG_ENTRY_HEADER, data) && entry->size < MAX_ENTRY_SIZE &&
+               entry->size % 4 == 0 && offset + entry->size <= dataSize;
+    }
+
+    // Parcourt les entrées dont le début se situe dans [begin, end).
+    // Une entrée peut déborder de end tant qu'elle tient dans dataSize.
+    // onEntry(offset, entry) est appelé pour chaque entrée valide ; halt() est
+    // consulté avant chaque pas et interrompt le parcours.
+    // Après une entrée, la suivante est attendue juste derrière ; à défaut (taille
+    // bidon, données écrasées), seules les frontières de ENTRY_ALIGNMENT sont sondées
+    // jusqu'à la prochaine entrée valide, et la plage franchie est ajoutée à skipped.
+    // resumeOffset reçoit la position où le parcours reprendrait.
+    template<typename OnEntry, typename Halt>
+    size_t ScanEntries(const BYTE* data, size_t dataSize, size_t begin, size_t end, OnEntry onEntry, Halt halt,
+                       size_t* resumeOffset = nullptr, ByteRanges* skipped = nullptr) {
+        size_t offset = begin;
+        size_t found = 0;
+        size_t gapStart = 0;
+        bool inGap = false;
+
+        while (offset < end && offset + sizeof(LOG_ENTRY_HEADER) < dataSize && !stopProcessing && !halt()) {
+            if (IsEntryAt(data, dataSize, offset)) {
+                if (inGap && skipped) skipped->emplace_back(gapStart, offset);
+                inGap = false;
+
+                const LOG_ENTRY_HEADER* entry = reinterpret_cast<const LOG_ENTRY_HEADER*>(data + offset);
+                onEntry(offset, entry);
+                found++;
+                offset += entry->size;
+            } else {
+                if (!inGap) {
+                    gapStart = offset;
+                    inGap = true;
+                }
+                offset = (offset / ENTRY_ALIGNMENT + 1) * ENTRY_ALIGNMENT;
+            }
+        }
+
+        if (inGap && skipped) skipped->emplace_back(gapStart, std::min(offset, dataSize));
+        if (resumeOffset) *resumeOffset = offset;
+        return found;
+    }
+
+    bool MatchesQuery(const TransactionEntry& tx) const {
+        return queryText.empty() || RecordContains(tx, queryText);
+    }
+
+    void CollectEntry(ScanPartition& part, size_t offset, const LOG_ENTRY_HEADER* entry) {
+        part.spans.emplace_back(offset, entry->size);
+
+        TransactionEntry tx;
+        auto cached = part.reuseSample ? sampleCache.find(offset) : sampleCache.end();
+        if (cached != sampleCache.end()) {
+            tx = std::move(cached->second);
+            part.reused++;
+        } else {
+            const ULONGLONG hash = Fnv1a64(entry, entry->size);
+            if (!workspace.decoded.Find(hash, tx)) {
+                DecodeContent(entry, tx);
+                workspace.decoded.Insert(hash, tx);
+            }
+            SetLocation(tx, *part.hiveName, *part.logFile, offset, hash);
+        }
+        if (part.keyPaths) ApplyKeyPath(*part.keyPaths, entry, tx);
+
+        if (!MatchesQuery(tx)) return;
+        part.results.emplace_back(offset, std::move(tx));
+
+        if (part.cap && part.results.size() >= part.cap) {
+            // Les partitions suivantes ne servent plus, sauf si le raccord écarte des entrées
+            part.capped = true;
+            size_t cutoff = queryCutoff.load();
+            while (part.ordinal < cutoff && !queryCutoff.compare_exchange_weak(cutoff, part.ordinal)) {}
+        }
+    }
+
+    // Partition arrêtée sur sa propre limite ou derrière une partition qui l'a atteinte
+    bool PartitionHalted(ScanPartition& part) {
+        if (!part.capped && part.ordinal > queryCutoff.load(std::memory_order_relaxed)) part.capped = true;
+        return part.capped;
+    }
+
+    void ScanPartitionRange(ScanPartition& part, size_t from) {
+        part.capped = false;
+        ScanEntries(part.data, part.dataSize, from, part.end,
+                    [&](size_t offset, const LOG_ENTRY_HEADER* entry) { CollectEntry(part, offset, entry); },
+                    [&] { return PartitionHalted(part); }, &part.resume, &part.skipped);
+    }
+
+    // Chaque entrée de l'index est encore en place, avec la même taille
+    static bool IndexMatches(const LogIndex& index, const BYTE* data, size_t dataSize) {
+        return std::all_of(index.spans.begin(), index.spans.end(), [data, dataSize](const std::pair<size_t, DWORD>& span) {
+            return IsEntryAt(data, dataSize, span.first) &&
+                   reinterpret_cast<const LOG_ENTRY_HEADER*>(data + span.first)->size == span.second;
+        });
+    }
+
+    // Fichier déjà indexé (IndexMatches vérifié) : décodage direct des entrées connues (indexBegin avance
+    // avec le décodage, pour une reprise après arrêt)
+    void DecodeIndexedRange(ScanPartition& part) {
+        part.capped = false;
+        for (; part.indexBegin < part.indexEnd; part.indexBegin++) {
+            if (stopProcessing || PartitionHalted(part)) break;
+            const size_t offset = part.index->spans[part.indexBegin].first;
+            CollectEntry(part, offset, reinterpret_cast<const LOG_ENTRY_HEADER*>(part.data + offset));
+        }
+    }
+
+    // Reprise d'une partition arrêtée dont le raccord a encore besoin
+    void ResumePartition(ScanPartition& part) {
+        if (part.index) {
+            DecodeIndexedRange(part);
+        } else {
+            ScanPartitionRange(part, part.resume);
+        }
+    }
+
+    // Raccorde une partition à la position où le parcours séquentiel reprendrait.
+    // Les entrées situées avant cette position sont des faux positifs (données de
+    // l'entrée précédente). La partition débute sur une frontière d'alignement et
+    // sonde toutes les frontières hors entrées : les deux parcours convergent si la
+    // position est le début d'une entrée trouvée, ou si elle n'est couverte par
+    // aucune entrée et ne porte pas d'entrée valide (resynchronisation commune).
+    // Sinon la partition est reparcourue séquentiellement.
+    void StitchPartition(ScanPartition& part, size_t continuation) {
+        if (continuation <= part.begin) return;
+
+        bool crossed = false, spanStart = false;
+        for (const auto& span : part.spans) {
+            if (span.first >= continuation) {
+                spanStart = span.first == continuation;
+                break;
+            }
+            if (span.first + span.second > continuation) crossed = true;
+        }
+
+        // Partition arrêtée avant la position : rien de ce qu'elle a vu n'est réutilisable
+        const bool converges = spanStart || (!crossed && !IsEntryAt(part.data, part.dataSize, continuation));
+        if (!converges || continuation >= part.end || (part.capped && continuation >= part.resume)) {
+            part.spans.clear();
+            part.results.clear();
+            part.skipped.clear();
+            part.reuseSample = false; // Les entrées reprises ont déjà été déplacées
+            ScanPartitionRange(part, continuation);
+            return;
+        }
+
+        part.spans.erase(part.spans.begin(),
+                         std::find_if(part.spans.begin(), part.spans.end(),
+                                      [continuation](const auto& s) { return s.first >= continuation; }));
+        auto keep = std::find_if(part.results.begin(), part.results.end(),
+                                 [continuation](const auto& r) { return r.first >= continuation; });
+        part.results.erase(part.results.begin(), keep);
+
+        // Plages franchies par la partition avant la reprise : rognées à la position
+        auto firstGap = std::find_if(part.skipped.begin(), part.skipped.end(),
+                                     [continuation](const ByteRange& r) { return r.second > continuation; });
+        part.skipped.erase(part.skipped.begin(), firstGap);
+        if (!part.skipped.empty()) part.skipped.front().first = std::max(part.skipped.front().first, continuation);
+    }
+
+    // Bilan des plages ignorées : fusion des plages contiguës entre partitions.
+    // L'en-tête de base "regf" en début de fichier n'est pas une corruption.
+    void ReportSkippedRanges(const std::vector<ScanPartition>& parts, const BYTE* data, size_t dataSize) {
+        ByteRanges merged;
+        for (const auto& part : parts) {
+            for (const ByteRange& range : part.skipped) {
+                if (!merged.empty() && merged.back().second == range.first) {
+                    merged.back().second = range.second;
+                } else if (range.first < range.second) {
+                    merged.push_back(range);
+                }
+            }
+        }
+        if (!merged.empty() && merged.front().first == 0 && dataSize >= sizeof(DWORD) &&
+            *reinterpret_cast<const DWORD*>(data) == 0x66676572) { // "regf"
+            merged.erase(merged.begin());
+        }
+        if (merged.empty()) return;
+
+        size_t skippedBytes = 0;
+        for (const ByteRange& range : merged) skippedBytes += range.second - range.first;
+        Log(L"Resynchronisation : " + std::to_wstring(merged.size()) + L" plages ignorées, "
+            + std::to_wstring(skippedBytes) + L" octets");
+        for (size_t i = 0; i < merged.size() && i < RESYNC_REPORT_RANGES; i++) {
+            Log(L"  Plage ignorée " + DwordToHex(static_cast<DWORD>(merged[i].first)) + L" - "
+                + DwordToHex(static_cast<DWORD>(merged[i].second)) + L" ("
+                + std::to_wstring(merged[i].second - merged[i].first) + L" octets)");
+        }
+    }
+
+    // ShimCache : la valeur AppCompatCache (souvent big data, plusieurs Mo) est
+    // reconstituée depuis les pages du log, complétées au besoin par le hive
+    // primaire, puis parcourue sans recopie. Chaque entrée devient un
+    // enregistrement rattaché à l'entrée de log portant la cellule "vk".
+    void DecodeShimCache(std::vector<ScanPartition>& parts, const BYTE* data, const std::wstring& path,
+                         const std::wstring& hiveName, const std::wstring& logFile) {
+        HiveImage image;
+        struct Candidate { size_t fileOffset; DWORD sequence; ValueCell cell; };
+        std::vector<Candidate> candidates;
+
+        for (const auto& part : parts) {
+            for (const auto& span : part.spans) {
+                const LOG_ENTRY_HEADER* entry = reinterpret_cast<const LOG_ENTRY_HEADER*>(data + span.first);
+                const HivePage page(entry);
+                image.Add(entry->offset, entry->data, span.second - offsetof(LOG_ENTRY_HEADER, data), entry->sequenceNumber);
+                page.ForEachValue([&](const ValueCell& cell) {
+                    if (cell.type == REG_BINARY && !cell.inlineData && _wcsicmp(cell.name.c_str(), L"AppCompatCache") == 0) {
+                        candidates.push_back({ span.first, entry->sequenceNumber, cell });
+                    }
+                });
+            }
+        }
+        if (candidates.empty()) return;
+
+        // Version la plus récente de chaque valeur
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return a.cell.dataOffset != b.cell.dataOffset ? a.cell.dataOffset < b.cell.dataOffset : a.sequence > b.sequence;
+        });
+        candidates.erase(std::unique(candidates.begin(), candidates.end(),
+                                     [](const Candidate& a, const Candidate& b) { return a.cell.dataOffset == b.cell.dataOffset; }),
+                         candidates.end());
+
+        image.Seal();
+        const std::wstring primaryPath = PrimaryHivePath(path);
+        if (!primaryPath.empty() && image.OpenPrimary(primaryPath)) Log(L"ShimCache : hive primaire de repli " + primaryPath);
+
+        for (const Candidate& candidate : candidates) {
+            std::vector<HiveImage::Span> spans;
+            std::wstring error;
+            if (!image.ValueData(candidate.cell.dataOffset, candidate.cell.dataSize, spans, error)) {
+                Log(L"ShimCache @ " + DwordToHex(candidate.cell.dataOffset) + L" non reconstitué : " + error);
+                continue;
+            }
+
+            const BlobStream blob(std::move(spans));
+            const ShimCache::Layout layout = ShimCache::Detect(blob);
+            const std::wstring layoutName = ShimCache::LayoutName(layout);
+            auto& results = parts.back().results;
+
+            const size_t count = ShimCache::Parse(blob, layout, [&](const ShimCacheEntry& shim) {
+                TransactionEntry tx;
+                tx.timestamp = FileTimeToString(shim.lastModified);
+                tx.keyPath = L"Control\\Session Manager\\AppCompatCache";
+                tx.valueName = shim.path;
+                tx.dataBefore = L"<ShimCache>";
+                tx.dataAfter = shim.hasInsertFlags ? DwordToHex(shim.insertFlags) : L"";
+                tx.txID = DwordToHex(candidate.sequence);
+                tx.offset = candidate.cell.dataOffset;
+                tx.artifact = L"ShimCache";
+                tx.details = L"Position=" + std::to_wstring(shim.position) + L"; Format=" + layoutName;
+                if (shim.hasInsertFlags) {
+                    tx.details += (shim.insertFlags & SHIMCACHE_FLAG_EXECUTED) ? L"; Exécuté=oui" : L"; Exécuté=non";
+                }
+
+                // Identité : entrée de log de la cellule "vk", rang dans le cache
+                ULONGLONG hash = Fnv1a64(shim.path);
+                hash = Fnv1a64(&shim.lastModified, sizeof(shim.lastModified), hash);
+                SetLocation(tx, hiveName, logFile, candidate.fileOffset, hash);
+                tx.sequence = shim.position;
+
+                if (MatchesQuery(tx)) results.emplace_back(candidate.fileOffset, std::move(tx));
+            });
+
+            Log(L"ShimCache (" + layoutName + L") : " + std::to_wstring(count) + L" entrées, valeur de "
+                + std::to_wstring(blob.Size()) + L" octets en " + std::to_wstring(blob.ChunkCount()) + L" plages");
+        }
+        if (image.FetchedBytes()) {
+            Log(L"ShimCache : " + std::to_wstring(image.FetchedBytes()) + L" octets lus dans le hive primaire");
+        }
+    }
+
+    // Greffons : lots de PLUGIN_BATCH_ROWS lignes répartis sur le pool
+    void RunPlugins(std::vector<ScanPartition>& parts, const BYTE* data, const std::wstring& hiveName,
+                    const std::wstring& logFile) {
+        if (workspace.plugins.Empty()) return;
+
+        std::vector<std::function<void()>> tasks;
+        for (auto& part : parts) {
+            for (size_t first = 0; first < part.results.size(); first += PLUGIN_BATCH_ROWS) {
+                PluginHost::ResultRow* rows = part.results.data() + first;
+                const size_t count = std::min(PLUGIN_BATCH_ROWS, part.results.size() - first);
+                tasks.push_back([this, rows, count, data, &hiveName, &logFile] {
+                    workspace.plugins.ProcessBatch(rows, count, data, hiveName, logFile);
+                });
+            }
+        }
+        workspace.pool.Run(tasks);
+        for (const auto& line : workspace.plugins.TakeStats()) Log(line);
+    }
+
+    // Donnée d'une valeur du hive primaire : chaînes en clair (bornées), entiers en
+    // hexadécimal, autres types en octets comme pour les pages de log
+    std::wstring FormatValueData(const ValueCell& cell, const BlobStream& data) {
+        const size_t size = data.Size();
+        switch (cell.type) {
+        case REG_SZ:
+        case REG_EXPAND_SZ:
+        case REG_MULTI_SZ:
+        case REG_LINK: {
+            std::wstring units, value;
+            if (!data.Utf16(0, std::min(size, HIVE_VALUE_TEXT_MAX * sizeof(WORD)), units)) break;
+            for (wchar_t ch : units) {
+                if (ch == 0) {
+                    if (cell.type != REG_MULTI_SZ) break;
+                    if (!value.empty() && value.back() != L' ') value += L"; ";
+                    continue;
+                }
+                value += ch;
+            }
+            while (!value.empty() && (value.back() == L' ' || value.back() == L';')) value.pop_back();
+            return value;
+        }
+        case REG_DWORD:
+        case REG_DWORD_BIG_ENDIAN: {
+            DWORD value = 0;
+            if (size != sizeof(DWORD) || !data.Get(0, value)) break;
+            if (cell.type == REG_DWORD_BIG_ENDIAN) {
+                value = (value >> 24) | ((value >> 8) & 0xFF00) | ((value << 8) & 0xFF0000) | (value << 24);
+            }
+            return DwordToHex(value);
+        }
+        case REG_QWORD: {
+            ULONGLONG value = 0;
+            if (size != sizeof(ULONGLONG) || !data.Get(0, value)) break;
+            wchar_t buf[32];
+            swprintf_s(buf, L"0x%016llX", value);
+            return buf;
+        }
+        }
+
+        BYTE head[32];
+        const size_t shown = std::min(size, sizeof(head));
+        data.Read(0, head, shown);
+        return BytesToHex(head, shown);
+    }
+
+    // Clé du hive primaire : un enregistrement <Key> (dernière écriture, nombre de
+    // sous-clés et de valeurs) puis un par valeur, horodaté par la clé
+    void CollectHiveKey(HiveWalker& walker, const HiveWalker::Key& key, const std::wstring& hiveName,
+                        const std::wstring& logFile, DWORD sequence, RecordVector& out, size_t& unreadable) {
+        const std::wstring keyPath = key.path.empty() ? L"\\" : key.path;
+        const std::wstring timestamp = FileTimeToString(key.lastWritten);
+        const ArtifactDecoder* decoder = ArtifactDispatch::Instance().Match(keyPath);
+
+        auto emit = [&](TransactionEntry& tx) {
+            if (!MatchesQuery(tx)) return;
+            out.push_back(std::move(tx));
+        };
+        auto start = [&](TransactionEntry& tx, DWORD offset) {
+            tx.timestamp = timestamp;
+            tx.keyPath = keyPath;
+            tx.offset = offset;
+            tx.sequence = sequence;
+        };
+
+        const BYTE* nk = nullptr;
+        size_t nkLength = 0;
+        TransactionEntry keyTx;
+        start(keyTx, key.offset);
+        keyTx.valueName = L"<Key>";
+        keyTx.dataAfter = std::to_wstring(key.subkeyCount) + L" sous-clés, " + std::to_wstring(key.valueCount) + L" valeurs";
+        SetLocation(keyTx, hiveName, logFile, HBIN_BASE_OFFSET + key.offset,
+                    walker.Cell(key.offset, nk, nkLength) ? Fnv1a64(nk, nkLength) : 0);
+        emit(keyTx);
+
+        walker.ForEachValue(key, [&](DWORD offset, const ValueCell& cell, const BYTE* vk, size_t vkLength) {
+            TransactionEntry tx;
+            start(tx, offset);
+            tx.valueName = cell.name;
+
+            ULONGLONG hash = Fnv1a64(vk, vkLength);
+            std::vector<HiveImage::Span> spans;
+            std::wstring error;
+            if (walker.ValueData(cell, vk, spans, error)) {
+                MinHash::Builder minhash;
+                for (const auto& span : spans) {
+                    hash = Fnv1a64(span.first, span.second, hash);
+                    minhash.Add(span.first, span.second);
+                }
+                minhash.Finish(tx.signature);
+
+                const BlobStream blob(std::move(spans));
+                tx.dataAfter = FormatValueData(cell, blob);
+                if (decoder && decoder->Selects(cell.name)) {
+                    DWORD dword = 0;
+                    std::wstring text = tx.dataAfter;
+                    if (cell.type == REG_DWORD && blob.Size() == sizeof(DWORD) && blob.Get(0, dword)) {
+                        text = ArtifactDecoder::FormatDword(cell.name, dword);
+                    } else if (cell.type == REG_BINARY) {
+                        text = L"<" + std::to_wstring(blob.Size()) + L" octets>";
+                    }
+                    tx.artifact = decoder->name;
+                    tx.details = decoder->DecodeValue(keyPath, cell.name, text);
+                }
+            } else {
+                tx.dataAfter = L"<" + error + L">";
+                unreadable++;
+            }
+            SetLocation(tx, hiveName, logFile, HBIN_BASE_OFFSET + offset, hash);
+            emit(tx);
+        });
+    }
+
+    // Hive primaire : énumération complète des clés et valeurs (HiveWalker), les
+    // enregistrements étant produits par tranches de clés sur le pool
+    bool EnumerateHive(const std::wstring& path, const BYTE* data, size_t size) {
+        HiveWalker walker(data, size);
+        const HiveWalker::Stats& stats = walker.Walk(workspace.pool);
+        const HiveWalker::KeyVector& keys = walker.Keys();
+
+        const std::wstring hiveName = HiveLabel(path, data, size);
+        const std::wstring logFile = PathFindFileNameW(path.c_str());
+        REGF_HEADER base;
+        memcpy(&base, data, sizeof(base));
+
+        // Avec une limite, comme pour les partitions d'un log : une tranche s'arrête
+        // dès qu'elle a assez de correspondances à elle seule, et les suivantes avec
+        // elle (queryCutoff) ; next mémorise la clé où chaque tranche s'est arrêtée
+        const size_t chunks = (keys.size() + HIVE_KEYS_PER_TASK - 1) / HIVE_KEYS_PER_TASK;
+        std::vector<RecordVector> parts(chunks);
+        std::vector<size_t> unreadable(chunks);
+        std::vector<size_t> next(chunks);
+        std::vector<std::function<void()>> tasks;
+        queryCutoff = chunks;
+        for (size_t c = 0; c < chunks; c++) {
+            next[c] = c * HIVE_KEYS_PER_TASK;
+            tasks.push_back([&, c] {
+                const size_t end = std::min(keys.size(), (c + 1) * HIVE_KEYS_PER_TASK);
+                while (next[c] < end && !stopProcessing && c <= queryCutoff.load(std::memory_order_relaxed)) {
+                    CollectHiveKey(walker, keys[next[c]++], hiveName, logFile, base.sequence1, parts[c], unreadable[c]);
+                    if (queryMaxMatches && parts[c].size() >= queryMaxMatches) {
+                        size_t cutoff = queryCutoff.load();
+                        while (c < cutoff && !queryCutoff.compare_exchange_weak(cutoff, c)) {}
+                        break;
+                    }
+                }
+            });
+        }
+        workspace.pool.Run(tasks);
+
+        // Raccord dans l'ordre des tranches : une tranche arrêtée derrière la coupure
+        // reprend ses clés tant qu'il manque des correspondances aux précédentes
+        size_t txCounter = 0, unreadableValues = 0;
+        for (size_t c = 0; c < chunks; c++) {
+            if (queryMaxMatches && txCounter < queryMaxMatches) {
+                const size_t end = std::min(keys.size(), (c + 1) * HIVE_KEYS_PER_TASK);
+                while (next[c] < end && !stopProcessing && parts[c].size() < queryMaxMatches - txCounter) {
+                    CollectHiveKey(walker, keys[next[c]++], hiveName, logFile, base.sequence1, parts[c], unreadable[c]);
+                }
+            }
+            for (auto& tx : parts[c]) {
+                if (queryMaxMatches && txCounter >= queryMaxMatches) break;
+                transactions.push_back(std::move(tx));
+                txCounter++;
+            }
+            StreamRecords(false);
+            RecordVector().swap(parts[c]);
+            unreadableValues += unreadable[c];
+        }
+        queryStop = queryMaxMatches && txCounter >= queryMaxMatches;
+
+        Log(L"Hive primaire : " + std::to_wstring(stats.hbins) + L" hbins en " + std::to_wstring(stats.tasks)
+            + L" plages, " + std::to_wstring(stats.cells) + L" cellules allouées, " + std::to_wstring(keys.size())
+            + L" clés (" + std::to_wstring(stats.orphans) + L" orphelines)");
+        if (stats.skippedBlocks || stats.brokenBins || unreadableValues) {
+            Log(L"Hive primaire : " + std::to_wstring(stats.skippedBlocks) + L" blocs sans en-tête hbin, "
+                + std::to_wstring(stats.brokenBins) + L" hbins interrompus, " + std::to_wstring(unreadableValues)
+                + L" données de valeur illisibles");
+        }
+        sampleCache.clear();
+        samplePath.clear();
+
+        if (queryStop) {
+            UpdateStatus(L"Requête : " + std::to_wstring(txCounter) + L" correspondances dans " + hiveName
+                         + L", arrêt anticipé");
+        } else if (!queryText.empty()) {
+            UpdateStatus(L"Requête : " + std::to_wstring(txCounter) + L" correspondances dans " + hiveName);
+        } else {
+            UpdateStatus(L"Énumération terminée : " + std::to_wstring(keys.size()) + L" clés, "
+                         + std::to_wstring(txCounter) + L" enregistrements");
+        }
+        return txCounter > 0;
+    }
+
+    bool ParseLogFile(const std::wstring& path) {
+        AlignedBuffer buffer;
+        size_t fileSize = 0;
+        std::wstring readError;
+        if (!LogFileReader::Read(path, useDirectIO, buffer, fileSize, readError)) {
+            UpdateStatus(readError);
+            return false;
+        }
+        if (useDirectIO) {
+            Log(L"Lecture en E/S directes : " + std::to_wstring(fileSize) + L" octets");
+        }
+
+        if (CompressedInput::Detect(buffer.data(), fileSize) != CompressedInput::Format::None) {
+            AlignedBuffer inflated;
+            size_t inflatedSize = 0;
+            std::wstring mode;
+            if (!CompressedInput::Decode(buffer.data(), fileSize, workspace.pool, inflated, inflatedSize, mode, readError)) {
+                UpdateStatus(readError);
+                return false;
+            }
+            Log(L"Entrée compressée (" + mode + L") : " + std::to_wstring(fileSize) + L" -> "
+                + std::to_wstring(inflatedSize) + L" octets");
+            buffer.swap(inflated);
+            fileSize = inflatedSize;
+        }
+        bytesParsed += fileSize;
+
+        // Hive primaire (SYSTEM, SOFTWARE...) : énumération complète plutôt que parcours d'entrées
+        if (HiveWalker::IsPrimary(buffer.data(), fileSize)) {
+            return EnumerateHive(path, buffer.data(), fileSize);
+        }
+
+        // Parse header (si format REGF header existe dans les logs)
+        if (fileSize < sizeof(REGF_HEADER)) {
+            UpdateStatus(L"Attention : Fichier trop petit pour contenir un header complet");
+        }
+
+        // Identité du hive depuis le base block (repli sur le nom de fichier)
+        std::wstring hiveName = HiveLabel(path, buffer.data(), fileSize);
+        const std::wstring logFile = PathFindFileNameW(path.c_str());
+
+        // Promotion d'une session échantillonnée : les entrées déjà décodées sont reprises
+        const bool reuseSample = !sampleCache.empty() && samplePath == path;
+
+        // Fichier déjà parcouru dans l'espace de travail (même taille, même date)
+        const std::wstring identity = LogIndexCache::Identity(path);
+        std::shared_ptr<const LogIndex> knownIndex = identity.empty() ? nullptr : workspace.indexes.Find(identity);
+        if (knownIndex && !IndexMatches(*knownIndex, buffer.data(), fileSize)) {
+            // Même taille et même date, contenu différent (copie restaurée, horloge) : index abandonné
+            Log(L"Index périmé : entrées absentes du fichier, parcours complet");
+            workspace.indexes.Erase(identity);
+            knownIndex = nullptr;
+        }
+        if (knownIndex) {
+            Log(L"Index réutilisé : " + std::to_wstring(knownIndex->spans.size()) + L" entrées connues");
+        }
+
+        // Chemins des clés : image du hive sur toutes les pages du log (index connu,
+        // sinon parcours préalable des seuls en-têtes d'entrées)
+        std::vector<std::pair<size_t, DWORD>> entrySpans;
+        if (knownIndex) {
+            entrySpans = knownIndex->spans;
+        } else {
+            ScanEntries(buffer.data(), fileSize, 0, fileSize,
+                        [&entrySpans](size_t offset, const LOG_ENTRY_HEADER* entry) { entrySpans.emplace_back(offset, entry->size); },
+                        [this] { return stopProcessing; });
+        }
+        const KeyPathResolver keyPaths(buffer.data(), entrySpans, PrimaryHivePath(path));
+        std::vector<std::pair<size_t, DWORD>>().swap(entrySpans);
+        Log(L"Chemins de clés reconstitués : " + std::to_wstring(keyPaths.Size()) + L" clés");
+
+        // Découpage en partitions alignées sur les frontières d'entrées (sondes de resynchronisation)
+        SYSTEM_INFO si = {};
+        GetSystemInfo(&si);
+        const size_t partitionCount = std::max<size_t>(1, std::min<size_t>(
+            { static_cast<size_t>(si.dwNumberOfProcessors), MAX_SCAN_PARTITIONS, fileSize / MIN_PARTITION_SIZE }));
+
+        std::vector<ScanPartition> parts(partitionCount);
+        for (size_t i = 0; i < partitionCount; i++) {
+            ScanPartition& part = parts[i];
+            part.owner = this;
+            part.data = buffer.data();
+            part.dataSize = fileSize;
+            part.begin = fileSize * i / partitionCount / ENTRY_ALIGNMENT * ENTRY_ALIGNMENT;
+            part.end = (i + 1 == partitionCount) ? fileSize
+                                                 : fileSize * (i + 1) / partitionCount / ENTRY_ALIGNMENT * ENTRY_ALIGNMENT;
+            part.hiveName = &hiveName;
+            part.logFile = &logFile;
+            part.keyPaths = &keyPaths;
+            part.reuseSample = reuseSample;
+            part.resume = part.begin;
+            part.reused = 0;
+            part.index = knownIndex.get();
+            part.indexBegin = knownIndex ? knownIndex->spans.size() * i / partitionCount : 0;
+            part.indexEnd = knownIndex ? knownIndex->spans.size() * (i + 1) / partitionCount : 0;
+            part.ordinal = i;
+            part.cap = queryMaxMatches;
+            part.capped = false;
+        }
+        queryCutoff = partitionCount;
+
+        // Parse des dirty pages et transactions
+        // Format simplifié : recherche de patterns caractéristiques
+        std::vector<std::function<void()>> tasks;
+        for (auto& part : parts) {
+            ScanPartition* p = &part;
+            if (knownIndex) {
+                tasks.push_back([this, p] { DecodeIndexedRange(*p); });
+            } else {
+                tasks.push_back([this, p] { ScanPartitionRange(*p, p->begin); });
+            }
+        }
+        workspace.pool.Run(tasks);
+
+        // Raccord dans l'ordre des partitions ; avec une limite, chaque partition ne
+        // doit plus que les correspondances manquant aux précédentes et celles qui
+        // suivent les queryMaxMatches premières sont abandonnées
+        queryCutoff = partitionCount;
+        size_t continuation = 0, matches = 0;
+        for (auto& part : parts) {
+            if (queryMaxMatches && matches >= queryMaxMatches) {
+                part.results.clear();
+                continue;
+            }
+            if (queryMaxMatches) part.cap = queryMaxMatches - matches;
+            if (!knownIndex) StitchPartition(part, continuation);
+            if (part.capped && part.results.size() < part.cap && !stopProcessing) ResumePartition(part);
+            continuation = part.resume;
+            matches += part.results.size();
+        }
+        queryStop = queryMaxMatches && matches >= queryMaxMatches;
+
+        if (knownIndex) {
+            parts[0].skipped = knownIndex->skipped;
+        } else {
+
+            // Parcours complet uniquement : un arrêt anticipé laisse l'index incomplet
+            if (!identity.empty() && !queryStop && !stopProcessing) {
+                auto index = std::make_shared<LogIndex>();
+                for (const auto& part : parts) {
+                    index->spans.insert(index->spans.end(), part.spans.begin(), part.spans.end());
+                    index->skipped.insert(index->skipped.end(), part.skipped.begin(), part.skipped.end());
+                }
+                workspace.indexes.Store(identity, index);
+            }
+        }
+
+        ReportSkippedRanges(parts, buffer.data(), fileSize);
+        if (!queryStop) DecodeShimCache(parts, buffer.data(), path, hiveName, logFile);
+        RunPlugins(parts, buffer.data(), hiveName, logFile);
+
+        size_t txCounter = 0, reused = 0;
+        for (auto& part : parts) {
+            for (auto& result : part.results) {
+                if (queryMaxMatches && txCounter >= queryMaxMatches) break;
+                if (keepPages) {
+                    const LOG_ENTRY_HEADER* entry = reinterpret_cast<const LOG_ENTRY_HEADER*>(buffer.data() + result.first);
+                    result.second.pageId = workspace.pages.Append(buffer.data() + result.first, entry->size,
+                                                                  result.second.contentHash);
+                }
+                transactions.push_back(std::move(result.second));
+                txCounter++;
+            }
+            reused += part.reused;
+            StreamRecords(false);
+        }
+
+        if (keepPages) {
+            workspace.pages.Seal();
+            Log(L"Store de pages : " + std::to_wstring(workspace.pages.PageCount()) + L" pages, "
+                + std::to_wstring(workspace.pages.RawBytes() / 1024) + L" Ko bruts -> "
+                + std::to_wstring(workspace.pages.StoredBytes() / 1024) + L" Ko compressés");
+        }
+
+        if (reuseSample) {
+            Log(L"Promotion de l'échantillon : " + std::to_wstring(reused) + L" entrées réutilisées");
+        }
+        sampleCache.clear();
+        samplePath.clear();
+
+        if (queryStop) {
+            UpdateStatus(L"Requête : " + std::to_wstring(txCounter) + L" correspondances dans " + hiveName
+                         + L", arrêt anticipé");
+        } else if (!queryText.empty()) {
+            UpdateStatus(L"Requête : " + std::to_wstring(txCounter) + L" correspondances dans " + hiveName);
+        } else {
+            UpdateStatus(L"Parsing terminé : " + std::to_wstring(txCounter) + L" transactions trouvées");
+        }
+        return txCounter > 0;
+    }
+
+    // Parcours de référence de l'auto-contrôle : lecture simple d'un log non
+    // compressé, un seul fil, sans partitions, index, pool d'entrées décodées ni
+    // échantillon. Il partage avec le moteur la reconnaissance des entrées
+    // (IsEntryAt), leur décodage (DecodeEntry, ApplyKeyPath), le filtre
+    // (MatchesQuery) et ShimCache : l'auto-contrôle vérifie l'orchestration de
+    // ParseLogFile (découpage, raccord, reprises, index, limites, lecture et
+    // décompression), pas ces décodeurs.
+    bool ReferenceParse(const std::wstring& path, RecordVector& records) {
+        std::ifstream in(path, std::ios::binary);
+        const std::vector<BYTE> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (data.empty()) return false;
+        const std::wstring hiveName = HiveLabel(path, data.data(), data.size());
+        const std::wstring logFile = PathFindFileNameW(path.c_str());
+
+        std::vector<ScanPartition> parts(1);
+        ScanPartition& part = parts[0];
+        size_t offset = 0;
+        while (offset + sizeof(LOG_ENTRY_HEADER) < data.size()) {
+            if (!IsEntryAt(data.data(), data.size(), offset)) {
+                offset = (offset / ENTRY_ALIGNMENT + 1) * ENTRY_ALIGNMENT;
+                continue;
+            }
+            const LOG_ENTRY_HEADER* entry = reinterpret_cast<const LOG_ENTRY_HEADER*>(data.data() + offset);
+            part.spans.emplace_back(offset, entry->size);
+            offset += entry->size;
+        }
+
+        const KeyPathResolver keyPaths(data.data(), part.spans, PrimaryHivePath(path));
+        for (const auto& span : part.spans) {
+            const LOG_ENTRY_HEADER* entry = reinterpret_cast<const LOG_ENTRY_HEADER*>(data.data() + span.first);
+            TransactionEntry tx;
+            DecodeEntry(entry, hiveName, logFile, span.first, tx);
+            ApplyKeyPath(keyPaths, entry, tx);
+            if (MatchesQuery(tx)) part.results.emplace_back(span.first, std::move(tx));
+        }
+        DecodeShimCache(parts, data.data(), path, hiveName, logFile);
+
+        for (auto& result : part.results) records.push_back(std::move(result.second));
+        return true;
+    }
+
+    // Premier écart entre deux jeux d'enregistrements, vide s'ils sont identiques.
+    // L'heure de décodage des entrées de log n'est pas comparée, seule la séquence l'est.
+    static std::wstring CompareRecords(const RecordVector& expected, const RecordVector& actual) {
+        auto stamp = [](const std::wstring& timestamp) {
+            const size_t sequence = timestamp.find(LOG_SEQUENCE_TAG);
+            return sequence == std::wstring::npos ? timestamp : timestamp.substr(sequence);
+        };
+        using Text = std::wstring TransactionEntry::*;
+        static const std::pair<const wchar_t*, Text> texts[] = {
+            { L"HiveFile", &TransactionEntry::hiveFile }, { L"KeyPath", &TransactionEntry::keyPath },
+            { L"ValueName", &TransactionEntry::valueName }, { L"DataBefore", &TransactionEntry::dataBefore },
+            { L"DataAfter", &TransactionEntry::dataAfter }, { L"TxID", &TransactionEntry::txID },
+            { L"LogFile", &TransactionEntry::logFile }, { L"Artifact", &TransactionEntry::artifact },
+            { L"Details", &TransactionEntry::details },
+        };
+
+        for (size_t i = 0; i < expected.size() && i < actual.size(); i++) {
+            const TransactionEntry& a = expected[i];
+            const TransactionEntry& b = actual[i];
+            const wchar_t* field = nullptr;
+            if (stamp(a.timestamp) != stamp(b.timestamp)) field = L"Timestamp";
+            for (const auto& text : texts) {
+                if (!field && a.*text.second != b.*text.second) field = text.first;
+            }
+            if (!field && a.offset != b.offset) field = L"Offset";
+            if (!field && a.sequence != b.sequence) field = L"Sequence";
+            if (!field && a.fileOffset != b.fileOffset) field = L"FileOffset";
+            if (!field && a.contentHash != b.contentHash) field = L"ContentHash";
+            if (field) {
+                return L"enregistrement " + std::to_wstring(i) + L" (offset fichier " + std::to_wstring(a.fileOffset)
+                       + L" / " + std::to_wstring(b.fileOffset) + L"), champ " + field;
+            }
+        }
+        if (expected.size() != actual.size()) {
+            return std::to_wstring(expected.size()) + L" enregistrements attendus, " + std::to_wstring(actual.size())
+                   + L" produits";
+        }
+        return std::wstring();
+    }
+
+    // Fichier unique ou dossier de logs (*.LOG, *.LOG1, *.LOG2, éventuellement .gz/.zst)
+    std::vector<std::wstring> EnumerateLogFiles(const std::wstring& path) {
+        std::vector<std::wstring> files;
+        if (!PathIsDirectoryW(path.c_str())) {
+            files.push_back(path);
+            return files;
+        }
+
+        WIN32_FIND_DATAW fd = {};
+        HANDLE hFind = FindFirstFileW((path + L"\\*.LOG*").c_str(), &fd);
+        if (hFind != INVALID_HANDLE_VALUE) {
+            do {
+                const std::wstring name = CompressedInput::StripExtension(fd.cFileName); // SYSTEM.LOG1.gz
+                const wchar_t* ext = PathFindExtensionW(name.c_str());
+                if (!(fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) &&
+                    (_wcsicmp(ext, L".LOG") == 0 || _wcsicmp(ext, L".LOG1") == 0 || _wcsicmp(ext, L".LOG2") == 0)) {
+                    files.push_back(path + L"\\" + fd.cFileName);
+                }
+            } while (FindNextFileW(hFind, &fd));
+            FindClose(hFind);
+        }
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    // Machine d'origine d'un fichier : la racine du dossier de preuves, coupée
+    // avant Windows\System32\config, Users ou Documents and Settings (les hives
+    // d'une même collecte appartiennent au même hôte), sinon son dossier. Le
+    // système en cours d'exécution est identifié par le nom de l'ordinateur.
+    std::wstring HostIdentity(const std::wstring& file) const {
+        if (!rarityHost.empty()) return rarityHost;
+
+        wchar_t full[MAX_PATH] = {};
+        std::wstring path = GetFullPathNameW(file.c_str(), MAX_PATH, full, nullptr) ? full : file;
+        std::wstring lower = path;
+        std::transform(lower.begin(), lower.end(), lower.begin(),
+                       [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+
+        // Users et Documents and Settings ne délimitent que les hives d'utilisateur,
+        // pas une copie de preuves rangée dans un profil de l'analyste
+        size_t cut = lower.find_last_of(L"\\/");
+        const std::wstring name = cut == std::wstring::npos ? lower : lower.substr(cut + 1);
+        const bool userHive = name.compare(0, 10, L"ntuser.dat") == 0 || name.compare(0, 12, L"usrclass.dat") == 0;
+        static const struct { const wchar_t* text; bool userOnly; } markers[] = {
+            { L"\\windows\\system32\\config\\", false },
+            { L"\\users\\", true },
+            { L"\\documents and settings\\", true },
+        };
+        for (const auto& marker : markers) {
+            if (marker.userOnly && !userHive) continue;
+            const size_t at = lower.find(marker.text);
+            if (at != std::wstring::npos && (cut == std::wstring::npos || at < cut)) cut = at;
+        }
+        std::wstring root = cut == std::wstring::npos ? std::wstring() : path.substr(0, cut);
+
+        wchar_t windows[MAX_PATH] = {};
+        if (root.size() == 2 && GetSystemWindowsDirectoryW(windows, MAX_PATH) >= 2 &&
+            _wcsnicmp(root.c_str(), windows, 2) == 0) {
+            wchar_t computer[MAX_COMPUTERNAME_LENGTH + 1] = {};
+            DWORD length = MAX_COMPUTERNAME_LENGTH + 1;
+            if (GetComputerNameW(computer, &length)) return L"machine:" + std::wstring(computer, length);
+        }
+        return root.empty() ? path : root;
+    }
+
+    // Parse un fichier en attribuant ses enregistrements à son hôte
+    bool ParseHostFile(const std::wstring& file) {
+        if (fleetCounting) workspace.rarity.BeginHost(HostIdentity(file));
+        const bool ok = ParseLogFile(file);
+        PublishResults();
+        workspace.rarity.EndHost();
+        return ok;
+    }
+
+    bool ParseInput(const std::wstring& path) {
+        queryStop = false;
+
+        if (!PathIsDirectoryW(path.c_str())) {
+            return ParseHostFile(path);
+        }
+
+        std::vector<std::wstring> files = EnumerateLogFiles(path);
+        bool any = false;
+        for (const auto& file : files) {
+            if (stopProcessing) break;
+            Log(L"Lot : " + file);
+            any |= ParseHostFile(file);
+
+            if (queryStop) {
+                if (queryStopBatch) {
+                    Log(L"Requête satisfaite : arrêt du lot");
+                    break;
+                }
+                queryStop = false;
+            }
+        }
+
+        SnapshotPublisher::Reader snapshot(parseTarget->results);
+        UpdateStatus(L"Lot terminé : " + std::to_wstring(files.size()) + L" fichiers, "
+                     + std::to_wstring(snapshot->size()) + L" transactions retenues");
+        return any;
+    }
+
+    // Triage rapide : le fichier est découpé en SAMPLE_STRATA régions, dans chacune
+    // SAMPLE_WINDOWS_PER_STRATUM fenêtres sont tirées et décodées. Le total est estimé
+    // par stratification (densité moyenne x taille de la région) avec un IC à 95 %.
+    bool SampleLogFile(const std::wstring& path) {
+        FileHandle hFile(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                     nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+        if (!hFile.valid()) {
+            UpdateStatus(L"Erreur : Impossible d'ouvrir le fichier LOG");
+            return false;
+        }
+
+        LARGE_INTEGER size = {};
+        if (!GetFileSizeEx(hFile, &size) || size.QuadPart == 0) {
+            UpdateStatus(L"Erreur : Fichier LOG vide ou invalide");
+            return false;
+        }
+
+        // Les fenêtres sont lues à des positions arbitraires : impossible dans un flux compressé
+        BYTE baseBlock[HBIN_BASE_OFFSET + HBIN_HEADER_SIZE] = {};
+        DWORD baseRead = 0;
+        if (!ReadFile(hFile, baseBlock, sizeof(baseBlock), &baseRead, nullptr)) baseRead = 0;
+        if (CompressedInput::Detect(baseBlock, baseRead) != CompressedInput::Format::None) {
+            UpdateStatus(L"Échantillonnage impossible sur une entrée compressée : utilisez le parsing complet");
+            return false;
+        }
+        // Un hive primaire n'est pas une suite d'entrées : les fenêtres n'y trouveraient rien
+        if (HiveWalker::IsPrimary(baseBlock, baseRead)) {
+            UpdateStatus(L"Échantillonnage impossible sur un hive primaire : utilisez le parsing complet");
+            return false;
+        }
+        const ULONGLONG fileSize = static_cast<ULONGLONG>(size.QuadPart);
+        const std::wstring hiveName = HiveLabel(path, baseBlock, baseRead);
+        const std::wstring logFile = PathFindFileNameW(path.c_str());
+
+        sampleCache.clear();
+        samplePath = path;
+
+        // Tirage reproductible : même fichier, même échantillon
+        std::mt19937_64 rng(fileSize);
+        std::vector<BYTE> window;
+        std::unordered_map<std::wstring, size_t> pathCounts;
+
+        const ULONGLONG strata = std::min<ULONGLONG>(SAMPLE_STRATA, (fileSize + SAMPLE_WINDOW_SIZE - 1) / SAMPLE_WINDOW_SIZE);
+        const ULONGLONG stratumSize = (fileSize + strata - 1) / strata;
+        double estimate = 0.0, variance = 0.0;
+        ULONGLONG sampledBytes = 0;
+
+        for (ULONGLONG h = 0; h < strata && !stopProcessing; h++) {
+            const ULONGLONG stratumStart = h * stratumSize;
+            if (stratumStart >= fileSize) break;
+            const ULONGLONG stratumLen = std::min(stratumSize, fileSize - stratumStart);
+
+            // Région trop petite : elle est lue en entier (contribution exacte)
+            const bool exhaustive = stratumLen <= static_cast<ULONGLONG>(SAMPLE_WINDOW_SIZE) * SAMPLE_WINDOWS_PER_STRATUM;
+            const int windows = exhaustive ? 1 : SAMPLE_WINDOWS_PER_STRATUM;
+            double densities[SAMPLE_WINDOWS_PER_STRATUM] = {};
+
+            for (int w = 0; w < windows; w++) {
+                ULONGLONG windowStart = stratumStart;
+                ULONGLONG windowLen = stratumLen;
+                if (!exhaustive) {
+                    std::uniform_int_distribution<ULONGLONG> pick(0, stratumLen - SAMPLE_WINDOW_SIZE);
+                    windowStart = (stratumStart + pick(rng)) / SAMPLE_ALIGNMENT * SAMPLE_ALIGNMENT;
+                    windowLen = SAMPLE_WINDOW_SIZE;
+                }
+
+                // Lecture de la fenêtre + marge pour les entrées qui débordent
+                const DWORD readLen = static_cast<DWORD>(std::min<ULONGLONG>(windowLen + MAX_ENTRY_SIZE, fileSize - windowStart));
+                window.resize(readLen);
+                LARGE_INTEGER pos = {};
+                pos.QuadPart = static_cast<LONGLONG>(windowStart);
+                DWORD bytesRead = 0;
+                if (!SetFilePointerEx(hFile, pos, nullptr, FILE_BEGIN) ||
+                    !ReadFile(hFile, window.data(), readLen, &bytesRead, nullptr)) {
+                    UpdateStatus(L"Erreur : Lecture du fichier LOG échouée");
+                    return false;
+                }
+
+                size_t count = ScanEntries(window.data(), bytesRead, 0, static_cast<size_t>(windowLen),
+                    [&](size_t offset, const LOG_ENTRY_HEADER* entry) {
+                        const size_t fileOffset = static_cast<size_t>(windowStart + offset);
+                        if (sampleCache.count(fileOffset)) return; // Fenêtres chevauchantes
+                        TransactionEntry tx;
+                        DecodeEntry(entry, hiveName, logFile, fileOffset, tx);
+                        pathCounts[tx.keyPath]++;
+                        transactions.push_back(tx);
+                        sampleCache.emplace(fileOffset, std::move(tx));
+                    },
+                    [] { return false; });
+
+                densities[w] = static_cast<double>(count) / static_cast<double>(windowLen);
+                sampledBytes += windowLen;
+            }
+
+            double mean = 0.0;
+            for (int w = 0; w < windows; w++) mean += densities[w];
+            mean /= windows;
+            estimate += mean * static_cast<double>(stratumLen);
+
+            if (windows > 1) {
+                double s2 = 0.0;
+                for (int w = 0; w < windows; w++) s2 += (densities[w] - mean) * (densities[w] - mean);
+                s2 /= (windows - 1);
+                variance += static_cast<double>(stratumLen) * static_cast<double>(stratumLen) * s2 / windows;
+            }
+        }
+
+        if (stopProcessing) return false;
+
+        const double bound = SAMPLE_Z_95 * std::sqrt(variance);
+        const double coverage = 100.0 * static_cast<double>(std::min(sampledBytes, fileSize)) / static_cast<double>(fileSize);
+        const double scale = sampledBytes ? static_cast<double>(fileSize) / static_cast<double>(sampledBytes) : 1.0;
+
+        std::vector<std::pair<std::wstring, size_t>> topPaths(pathCounts.begin(), pathCounts.end());
+        std::sort(topPaths.begin(), topPaths.end(),
+                  [](const auto& a, const auto& b) { return a.second > b.second; });
+        if (topPaths.size() > SAMPLE_TOP_PATHS) topPaths.resize(SAMPLE_TOP_PATHS);
+
+        wchar_t header[256];
+        swprintf_s(header, L"Estimation : ~%.0f transactions (± %.0f, IC 95%%)\n"
+                           L"Échantillon : %zu entrées décodées sur %.1f%% du fichier\n\n",
+                   estimate, bound, sampleCache.size(), coverage);
+        std::wstringstream summary;
+        summary << header << L"Key paths les plus fréquents (estimation) :\n";
+        for (const auto& p : topPaths) {
+            summary << L"  ~" << static_cast<size_t>(p.second * scale + 0.5) << L"  " << p.first << L"\n";
+        }
+        summary << L"\n\"Parser Transactions\" promeut la session en parsing complet.";
+        sampleSummary = summary.str();
+
+        Log(sampleSummary);
+        wchar_t status[256];
+        swprintf_s(status, L"Échantillonnage terminé : ~%.0f transactions estimées (± %.0f)", estimate, bound);
+        UpdateStatus(status);
+        return true;
+    }
+
+    // Remet au sink les tranches complètes de SINK_BATCH_RECORDS accumulées depuis
+    // le dernier appel (et le reliquat si final), notées par le modèle de rareté
+    void StreamRecords(bool final) {
+        if (!recordSink) return;
+        while (streamed < transactions.size()) {
+            const size_t count = std::min(SINK_BATCH_RECORDS, transactions.size() - streamed);
+            if (count < SINK_BATCH_RECORDS && !final) break;
+            workspace.rarity.Observe(transactions.data() + streamed, count);
+            if (!stopProcessing && !recordSink(transactions.data() + streamed, count)) stopProcessing = true;
+            streamed += count;
+        }
+    }
+
+    // Publie le segment privé du parser et prévient la vue
+    void PublishResults() {
+        if (recordSink) {
+            StreamRecords(true);
+        } else {
+            workspace.rarity.Observe(transactions.data(), transactions.size());
+        }
+        streamed = 0;
+        if (transactions.empty()) return;
+        parseTarget->results.Append(transactions);
+        {
+            SnapshotPublisher::Reader snapshot(parseTarget->results);
+            parseTarget->activity.Update(*snapshot);
+        }
+        if (hwndMain) PostMessage(hwndMain, WM_USER + 3, 0, 0);
+    }
+
+    SnapshotPublisher& ActiveResults() {
+        return workspace.sessions.empty() ? noResults : workspace.sessions[workspace.active]->results;
+    }
+
+    // Affiche le dernier instantané de la session active dans la ListView virtuelle
+    // (LVS_OWNERDATA) : seul le nombre de lignes change, leur texte est servi à la
+    // demande par OnGetDispInfo. Une version de la même génération ne fait que
+    // prolonger la précédente : seules les nouvelles lignes filtrées sont ajoutées.
+    void PopulateListView() {
+        SnapshotPublisher& results = ActiveResults();
+        SnapshotPublisher::Reader snapshot(results);
+
+        LARGE_INTEGER freq, start, end;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&start);
+        const bool filtering = resultFilter.Evaluate(&results, *snapshot, filterExpression, workspace.pool, filtered,
+                                                     filterScanned);
+        QueryPerformanceCounter(&end);
+        filterMs = (end.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart;
+
+        size_t first = 0;
+        const bool extend = &results == displayedResults && snapshot->generation == displayed.generation &&
+                            displayed.size() <= snapshot->size() && filtering == displayedFiltered;
+        if (extend) {
+            first = displayed.size();
+        } else {
+            displayedRows.clear();
+            ListView_SetItemState(hwndList, -1, 0, LVIS_SELECTED | LVIS_FOCUSED);
+        }
+        if (filtering) filtered.ForEachFrom(first, [this](size_t i) { displayedRows.push_back(i); });
+
+        displayedResults = &results;
+        displayed = *snapshot;
+        displayedFiltered = filtering;
+        const size_t rows = filtering ? displayedRows.size() : displayed.size();
+        ListView_SetItemCountEx(hwndList, static_cast<int>(rows), extend ? LVSICF_NOSCROLL | LVSICF_NOINVALIDATEALL : 0);
+    }
+
+    // Rang de l'enregistrement affiché sur une ligne, -1 hors liste
+    LONG_PTR RowRecord(int row) const {
+        if (row < 0) return -1;
+        const size_t rows = displayedFiltered ? displayedRows.size() : displayed.size();
+        if (static_cast<size_t>(row) >= rows) return -1;
+        return static_cast<LONG_PTR>(displayedFiltered ? displayedRows[row] : static_cast<size_t>(row));
+    }
+
+    // Ligne d'un enregistrement, -1 si le filtre ne l'affiche pas
+    int RecordRow(size_t record) const {
+        if (!displayedFiltered) return record < displayed.size() ? static_cast<int>(record) : -1;
+        auto it = std::lower_bound(displayedRows.begin(), displayedRows.end(), record);
+        return it != displayedRows.end() && *it == record ? static_cast<int>(it - displayedRows.begin()) : -1;
+    }
+
+    // Texte d'une cellule de la ListView virtuelle, pris dans l'instantané affiché
+    void OnGetDispInfo(NMLVDISPINFOW& info) {
+        if (!(info.item.mask & LVIF_TEXT)) return;
+        const LONG_PTR record = RowRecord(info.item.iItem);
+        if (record < 0) return;
+        const TransactionEntry& tx = displayed[static_cast<size_t>(record)];
+
+        const std::wstring* text = &displayedText;
+        displayedText.clear();
+        switch (info.item.iSubItem) {
+            case 0: text = &tx.timestamp; break;
+            case 1: text = &tx.hiveFile; break;
+            case 2: text = &tx.keyPath; break;
+            case 3: text = &tx.valueName; break;
+            case 4: text = &tx.dataBefore; break;
+            case 5: text = &tx.dataAfter; break;
+            case 6: text = &tx.txID; break;
+            case 7:
+                if (!tx.artifact.empty()) displayedText = tx.artifact + L" : " + tx.details;
+                break;
+            case 8:
+                if (tx.fleetHosts) displayedText = std::to_wstring(tx.prevalence) + L"/" + std::to_wstring(tx.fleetHosts);
+                break;
+            default: {
+                const size_t c = static_cast<size_t>(info.item.iSubItem - 9);
+                if (c < tx.derived.size()) text = &tx.derived[c];
+                break;
+            }
+        }
+        // Chaînes de l'instantané (ou displayedText) : valides jusqu'à la notification suivante
+        info.item.pszText = const_cast<LPWSTR>(text->c_str());
+    }
+
+    // Rang de l'enregistrement de la ligne sélectionnée, -1 sans sélection
+    LONG_PTR SelectedRecord() const {
+        return RowRecord(ListView_GetNextItem(hwndList, -1, LVNI_SELECTED));
+    }
+
+    // Filtre retapé : les termes déjà évalués sont réutilisés (ResultFilter)
+    void OnFilterChanged() {
+        wchar_t filterBuf[256] = {};
+        GetWindowTextW(GetDlgItem(hwndMain, IDC_EDIT_FILTER), filterBuf, 256);
+        filterExpression = filterBuf;
+
+        displayedResults = nullptr; // Liste reconstruite
+        PopulateListView();
+        if (displayedFiltered) {
+            wchar_t text[160];
+            swprintf_s(text, L"Filtre : %zu / %zu enregistrements (%zu examinés, %.1f ms, bitmap %zu Ko)",
+                       filtered.Count(), displayed.size(), filterScanned, filterMs, filtered.Bytes() / 1024);
+            SetWindowTextW(hwndStatus, text);
+        }
+    }
+
+    void RefreshSessionList() {
+        HWND hCombo = GetDlgItem(hwndMain, IDC_COMBO_SESSION);
+        SendMessageW(hCombo, CB_RESETCONTENT, 0, 0);
+        for (const auto& session : workspace.sessions) {
+            SendMessageW(hCombo, CB_ADDSTRING, 0, reinterpret_cast<LPARAM>(session->label.c_str()));
+        }
+        if (!workspace.sessions.empty()) SendMessageW(hCombo, CB_SETCURSEL, workspace.active, 0);
+    }
+
+    void OnSessionChanged() {
+        LRESULT index = SendMessageW(GetDlgItem(hwndMain, IDC_COMBO_SESSION), CB_GETCURSEL, 0, 0);
+        if (index < 0 || static_cast<size_t>(index) >= workspace.sessions.size()) return;
+        workspace.active = static_cast<size_t>(index);
+        PopulateListView();
+
+        SnapshotPublisher::Reader snapshot(ActiveResults());
+        UpdateStatus(L"Session " + workspace.sessions[workspace.active]->label + L" : "
+                     + std::to_wstring(snapshot->size()) + L" transactions");
+    }
+
+    // Coordinateur : distribue un job par fichier LOG aux workers connectés.
+    // Un worker silencieux plus de DIST_HEARTBEAT_TIMEOUT_MS ou déconnecté voit son
+    // job remis en file (résultats partiels écartés), jusqu'à DIST_MAX_ATTEMPTS fois.
+    bool RunCoordinator(const std::wstring& path) {
+        struct Job {
+            std::wstring path;
+            int attempts = 0;
+            enum class State { Pending, Running, Done, Failed } state = State::Pending;
+            std::vector<TransactionEntry> results;
+        };
+        struct Worker {
+            SocketHandle sock;
+            std::vector<BYTE> inbox;
+            int job = -1;
+            bool ready = false;
+            DWORD pid = 0;
+            ULONGLONG lastSeen = 0;
+        };
+
+        std::vector<Job> jobs;
+        for (const auto& file : EnumerateLogFiles(path)) {
+            Job job;
+            job.path = file;
+            jobs.push_back(std::move(job));
+        }
+        if (jobs.empty()) {
+            UpdateStatus(L"Erreur : Aucun fichier LOG à distribuer");
+            return false;
+        }
+
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(DIST_DEFAULT_PORT);
+        if (InetPtonW(AF_INET, listenAddress.c_str(), &addr.sin_addr) != 1) {
+            UpdateStatus(L"Erreur : Adresse d'écoute invalide : " + listenAddress);
+            return false;
+        }
+
+        SocketHandle listener(socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+        BOOL exclusive = TRUE;
+        setsockopt(listener, SOL_SOCKET, SO_EXCLUSIVEADDRUSE, reinterpret_cast<const char*>(&exclusive), sizeof(exclusive));
+        if (!listener.valid() || bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR ||
+            listen(listener, SOMAXCONN) == SOCKET_ERROR) {
+            UpdateStatus(L"Erreur : Impossible d'écouter sur le port " + std::to_wstring(DIST_DEFAULT_PORT));
+            return false;
+        }
+
+        // Workers locaux (un par cœur, plafonné) ; d'autres machines peuvent se joindre
+        // avec --worker <hôte> <port> si le coordinateur écoute sur une adresse externe.
+        SYSTEM_INFO sysInfo = {};
+        GetSystemInfo(&sysInfo);
+        const size_t localWorkers = std::min<size_t>(
+            { static_cast<size_t>(sysInfo.dwNumberOfProcessors), static_cast<size_t>(DIST_MAX_LOCAL_WORKERS), jobs.size() });
+        std::vector<HANDLE> processes;
+        wchar_t exePath[MAX_PATH];
+        GetModuleFileNameW(nullptr, exePath, MAX_PATH);
+        for (size_t i = 0; i < localWorkers; i++) {
+            std::wstring cmdLine = L"\"" + std::wstring(exePath) + L"\" --worker 127.0.0.1 " + std::to_wstring(DIST_DEFAULT_PORT);
+            STARTUPINFOW startup = {};
+            startup.cb = sizeof(startup);
+            PROCESS_INFORMATION pi = {};
+            if (CreateProcessW(exePath, &cmdLine[0], nullptr, nullptr, FALSE, CREATE_NO_WINDOW,
+                               nullptr, nullptr, &startup, &pi)) {
+                CloseHandle(pi.hThread);
+                processes.push_back(pi.hProcess);
+            }
+        }
+        Log(L"Coordinateur : " + std::to_wstring(jobs.size()) + L" jobs, "
+            + std::to_wstring(processes.size()) + L" workers locaux lancés");
+
+        std::vector<Worker> workers;
+        size_t finished = 0, retried = 0;
+        ULONGLONG lastActivity = GetTickCount64();
+
+        auto requeue = [&](Worker& w, const wchar_t* reason) {
+            if (w.job < 0) return;
+            Job& job = jobs[w.job];
+            job.results.clear();
+            if (job.attempts >= DIST_MAX_ATTEMPTS) {
+                job.state = Job::State::Failed;
+                finished++;
+                Log(L"Job abandonné (" + std::wstring(reason) + L") : " + job.path);
+            } else {
+                job.state = Job::State::Pending;
+                retried++;
+                Log(L"Job remis en file (" + std::wstring(reason) + L") : " + job.path);
+            }
+            w.job = -1;
+        };
+
+        while (finished < jobs.size() && !stopProcessing) {
+            fd_set readSet;
+            FD_ZERO(&readSet);
+            FD_SET(listener, &readSet);
+            for (auto& w : workers) FD_SET(w.sock, &readSet);
+
+            timeval tv = { 0, 250000 };
+            if (select(0, &readSet, nullptr, nullptr, &tv) == SOCKET_ERROR) break;
+            const ULONGLONG now = GetTickCount64();
+
+            if (FD_ISSET(listener, &readSet) && workers.size() + 1 < FD_SETSIZE) {
+                SOCKET client = accept(listener, nullptr, nullptr);
+                if (client != INVALID_SOCKET) {
+                    Worker w;
+                    w.sock = SocketHandle(client);
+                    w.lastSeen = now;
+                    workers.push_back(std::move(w));
+                }
+            }
+
+            for (auto& w : workers) {
+                if (!FD_ISSET(w.sock, &readSet)) continue;
+
+                char chunk[64 * 1024];
+                int n = recv(w.sock, chunk, sizeof(chunk), 0);
+                if (n <= 0) {
+                    requeue(w, L"worker déconnecté");
+                    w.sock.reset();
+                    continue;
+                }
+                w.inbox.insert(w.inbox.end(), chunk, chunk + n);
+                w.lastSeen = now;
+
+                DistProtocol::Frame type;
+                std::vector<BYTE> payload;
+                bool malformed = false;
+                while (DistProtocol::PopFrame(w.inbox, type, payload, malformed)) {
+                    DistProtocol::Reader reader(payload);
+                    switch (type) {
+                        case DistProtocol::Frame::Hello:
+                            w.pid = reader.U32();
+                            w.ready = true;
+                            break;
+                        case DistProtocol::Frame::Results: {
+                            DWORD id = reader.U32();
+                            DWORD count = reader.U32();
+                            if (static_cast<int>(id) != w.job) break;
+                            for (DWORD i = 0; i < count && reader.valid(); i++) {
+                                TransactionEntry tx;
+                                if (reader.Entry(tx)) jobs[id].results.push_back(std::move(tx));
+                            }
+                            break;
+                        }
+                        case DistProtocol::Frame::Done: {
+                            DWORD id = reader.U32();
+                            if (static_cast<int>(id) != w.job) break;
+                            jobs[id].state = Job::State::Done;
+                            finished++;
+                            w.job = -1;
+                            lastActivity = now;
+                            UpdateStatus(L"Parsing distribué : " + std::to_wstring(finished) + L"/"
+                                         + std::to_wstring(jobs.size()) + L" jobs terminés");
+                            break;
+                        }
+                        default:
+                            break; // Heartbeat : lastSeen déjà rafraîchi
+                    }
+                }
+                if (malformed) {
+                    requeue(w, L"trame invalide");
+                    w.sock.reset();
+                }
+            }
+
+            // Workers muets : considérés comme morts
+            for (auto& w : workers) {
+                if (w.sock.valid() && w.job >= 0 && now - w.lastSeen > DIST_HEARTBEAT_TIMEOUT_MS) {
+                    requeue(w, L"heartbeat expiré");
+                    w.sock.reset();
+                }
+            }
+            workers.erase(std::remove_if(workers.begin(), workers.end(),
+                                         [](const Worker& w) { return !w.sock.valid(); }), workers.end());
+
+            // Attribution des jobs en attente aux workers libres
+            for (auto& w : workers) {
+                if (!w.ready || w.job >= 0) continue;
+                auto pending = std::find_if(jobs.begin(), jobs.end(),
+                                            [](const Job& j) { return j.state == Job::State::Pending; });
+                if (pending == jobs.end()) break;
+
+                DistProtocol::Writer msg;
+                msg.U32(static_cast<DWORD>(pending - jobs.begin()));
+                msg.Str(pending->path);
+                if (DistProtocol::SendFrame(w.sock, DistProtocol::Frame::Job, msg)) {
+                    pending->state = Job::State::Running;
+                    pending->attempts++;
+                    w.job = static_cast<int>(pending - jobs.begin());
+                    w.lastSeen = now;
+                }
+            }
+
+            bool busy = std::any_of(workers.begin(), workers.end(), [](const Worker& w) { return w.job >= 0; });
+            if (busy) {
+                lastActivity = now;
+            } else if (now - lastActivity > DIST_IDLE_TIMEOUT_MS) {
+                Log(L"Coordinateur : aucun worker disponible, abandon");
+                break;
+            }
+        }
+
+        for (auto& w : workers) {
+            DistProtocol::SendFrame(w.sock, DistProtocol::Frame::Shutdown, DistProtocol::Writer());
+        }
+        workers.clear();
+        for (HANDLE hProcess : processes) {
+            if (WaitForSingleObject(hProcess, 2000) == WAIT_TIMEOUT) TerminateProcess(hProcess, 1);
+            CloseHandle(hProcess);
+        }
+
+        size_t done = 0, failed = 0, published = 0;
+        for (auto& job : jobs) {
+            if (job.state == Job::State::Done) {
+                done++;
+                for (auto& tx : job.results) transactions.push_back(std::move(tx));
+                published += transactions.size();
+                if (fleetCounting) workspace.rarity.BeginHost(HostIdentity(job.path));
+                PublishResults();
+                workspace.rarity.EndHost();
+            } else {
+                failed++;
+            }
+        }
+
+        UpdateStatus(L"Parsing distribué terminé : " + std::to_wstring(done) + L" jobs, "
+                     + std::to_wstring(published) + L" transactions, "
+                     + std::to_wstring(retried) + L" relances, " + std::to_wstring(failed) + L" échecs");
+        return published != 0;
+    }
+
+    struct HeartbeatContext {
+        SOCKET sock;
+        CRITICAL_SECTION* sendLock;
+        HANDLE hStop;
+        DWORD jobId;
+    };
+
+    static DWORD WINAPI HeartbeatThreadProc(LPVOID param) {
+        auto* ctx = static_cast<HeartbeatContext*>(param);
+        while (WaitForSingleObject(ctx->hStop, DIST_HEARTBEAT_INTERVAL_MS) == WAIT_TIMEOUT) {
+            DistProtocol::Writer msg;
+            msg.U32(ctx->jobId);
+            EnterCriticalSection(ctx->sendLock);
+            bool ok = DistProtocol::SendFrame(ctx->sock, DistProtocol::Frame::Heartbeat, msg);
+            LeaveCriticalSection(ctx->sendLock);
+            if (!ok) break;
+        }
+        return 0;
+    }
+
+    bool ConnectToCoordinator(const std::wstring& host, const std::wstring& port, SocketHandle& sock) {
+        ADDRINFOW hints = {};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_protocol = IPPROTO_TCP;
+
+        // Le coordinateur peut ne pas encore écouter : quelques tentatives espacées
+        for (int attempt = 0; attempt < 20; attempt++) {
+            PADDRINFOW result = nullptr;
+            if (GetAddrInfoW(host.c_str(), port.c_str(), &hints, &result) == 0) {
+                for (PADDRINFOW ai = result; ai; ai = ai->ai_next) {
+                    SocketHandle candidate(socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol));
+                    if (candidate.valid() && connect(candidate, ai->ai_addr, static_cast<int>(ai->ai_addrlen)) == 0) {
+                        sock = std::move(candidate);
+                        break;
+                    }
+                }
+                FreeAddrInfoW(result);
+            }
+            if (sock.valid()) return true;
+            Sleep(500);
+        }
+        return false;
+    }
+
+public:
+    // Mode worker : traite les jobs du coordinateur jusqu'à Shutdown ou déconnexion
+    int RunWorker(const std::wstring& host, const std::wstring& port) {
+        SocketHandle sock;
+        if (!ConnectToCoordinator(host, port, sock)) {
+            Log(L"Worker : coordinateur injoignable " + host + L":" + port);
+            return 1;
+        }
+        BOOL noDelay = TRUE;
+        setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+        Log(L"Worker connecté à " + host + L":" + port);
+
+        DistProtocol::Writer hello;
+        hello.U32(GetCurrentProcessId());
+        if (!DistProtocol::SendFrame(sock, DistProtocol::Frame::Hello, hello)) return 1;
+
+        CRITICAL_SECTION sendLock;
+        InitializeCriticalSection(&sendLock);
+
+        DistProtocol::Frame type;
+        std::vector<BYTE> payload;
+        bool connected = true;
+        while (connected && DistProtocol::RecvFrame(sock, type, payload)) {
+            if (type == DistProtocol::Frame::Shutdown) break;
+            if (type != DistProtocol::Frame::Job) continue;
+
+            DistProtocol::Reader reader(payload);
+            const DWORD jobId = reader.U32();
+            const std::wstring path = reader.Str();
+            if (!reader.valid()) break;
+
+            HeartbeatContext hb = { sock, &sendLock, CreateEventW(nullptr, TRUE, FALSE, nullptr), jobId };
+            HANDLE hHeartbeat = hb.hStop ? CreateThread(nullptr, 0, HeartbeatThreadProc, &hb, 0, nullptr) : nullptr;
+
+            transactions.clear();
+            queryText.clear();
+            queryMaxMatches = 0;
+            queryStop = false;
+            ParseLogFile(path);
+
+            // Diffusion des résultats par lots
+            for (size_t i = 0; i < transactions.size() && connected; i += DIST_RESULT_BATCH) {
+                const size_t count = std::min(DIST_RESULT_BATCH, transactions.size() - i);
+                DistProtocol::Writer batch;
+                batch.U32(jobId);
+                batch.U32(static_cast<DWORD>(count));
+                for (size_t k = 0; k < count; k++) batch.Entry(transactions[i + k]);
+                EnterCriticalSection(&sendLock);
+                connected = DistProtocol::SendFrame(sock, DistProtocol::Frame::Results, batch);
+                LeaveCriticalSection(&sendLock);
+            }
+
+            if (hHeartbeat) {
+                SetEvent(hb.hStop);
+                WaitForSingleObject(hHeartbeat, INFINITE);
+                CloseHandle(hHeartbeat);
+            }
+            if (hb.hStop) CloseHandle(hb.hStop);
+
+            DistProtocol::Writer done;
+            done.U32(jobId);
+            done.U32(static_cast<DWORD>(transactions.size()));
+            EnterCriticalSection(&sendLock);
+            connected = connected && DistProtocol::SendFrame(sock, DistProtocol::Frame::Done, done);
+            LeaveCriticalSection(&sendLock);
+            transactions.clear();
+        }
+
+        DeleteCriticalSection(&sendLock);
+        Log(L"Worker arrêté");
+        return 0;
+    }
+
+    // Auto-contrôle différentiel : chaque log synthétique (un sur deux altéré au
+    // hasard) est parsé par le moteur dans plusieurs configurations puis comparé
+    // au parcours de référence. Renvoie le nombre d'écarts ; les logs fautifs
+    // sont conservés pour reproduction.
+    size_t RunSelfCheck(size_t iterations, ULONGLONG seed) {
+        // limit : requête limitée à cette fraction des correspondances attendues (0 = illimitée) ;
+        // gzip : log parsé depuis une copie gzip (membres BGZF si bgzf)
+        struct Pass {
+            const wchar_t* name; bool freshIndex; bool directIO; bool sample; const wchar_t* query; double limit;
+            bool gzip; bool bgzf;
+        };
+        static const Pass passes[] = {
+            { L"partitions", true, false, false, L"", 0, false, false },
+            { L"index et entrées décodées réutilisés", false, false, false, L"", 0, false, false },
+            { L"E/S directes", true, true, false, L"", 0, false, false },
+            { L"échantillon promu", true, false, true, L"", 0, false, false },
+            { L"requête", true, false, false, L"services", 0, false, false },
+            { L"requête limitée", true, false, false, L"", 0.4, false, false },
+            { L"requête limitée, index réutilisé", false, false, false, L"", 0.7, false, false },
+            { L"requête filtrée et limitée", true, false, false, L"services", 0.5, false, false },
+            { L"gzip", true, false, false, L"", 0, true, false },
+            { L"gzip BGZF", true, false, false, L"", 0, true, true },
+            { L"gzip BGZF, requête limitée", true, false, false, L"", 0.6, true, true },
+        };
+
+        wchar_t tempDir[MAX_PATH] = {};
+        GetTempPathW(MAX_PATH, tempDir);
+        Log(L"Auto-contrôle : " + std::to_wstring(iterations) + L" logs, graine " + std::to_wstring(seed));
+
+        std::mt19937_64 rng(seed);
+        size_t mismatches = 0, records = 0, bytes = 0;
+        keepPages = false;
+        for (size_t i = 0; i < iterations && !stopProcessing; i++) {
+            const std::vector<BYTE> data = SyntheticLog::Generate(rng, i % 2 == 1);
+            wchar_t path[MAX_PATH] = {};
+            if (!GetTempFileNameW(tempDir, L"rtl", 0, path) || !SyntheticLog::Save(path, data)) {
+                Log(L"Auto-contrôle : impossible d'écrire le log synthétique dans " + std::wstring(tempDir));
+                return mismatches + 1;
+            }
+            bytes += data.size();
+
+            queryText.clear();
+            RecordVector reference;
+            ReferenceParse(path, reference);
+            records += reference.size();
+
+            size_t logMismatches = 0;
+            for (const Pass& pass : passes) {
+                // Entrée compressée : mêmes enregistrements, rattachés au fichier .gz
+                std::wstring input = path;
+                if (pass.gzip) {
+                    input += pass.bgzf ? L".bgzf.gz" : L".gz";
+                    if (!SyntheticLog::Save(input, SyntheticLog::Gzip(data, pass.bgzf))) {
+                        Log(L"Auto-contrôle : impossible d'écrire la copie compressée " + input);
+                        return mismatches + 1;
+                    }
+                }
+                if (pass.freshIndex) workspace.indexes.Erase(LogIndexCache::Identity(input));
+                useDirectIO = pass.directIO;
+                queryText = pass.query;
+                RecordVector expected;
+                const std::wstring inputHive = pass.gzip ? HiveLabel(input, data.data(), data.size()) : L"";
+                for (const auto& tx : reference) {
+                    if (!MatchesQuery(tx)) continue;
+                    expected.push_back(tx);
+                    if (pass.gzip) {
+                        expected.back().logFile = PathFindFileNameW(input.c_str());
+                        expected.back().hiveFile = inputHive;
+                    }
+                }
+
+                // Les N premières correspondances du parcours séquentiel, N tombant
+                // dans une partition quelconque selon la fraction
+                queryMaxMatches = pass.limit > 0
+                    ? std::max<size_t>(1, static_cast<size_t>(static_cast<double>(expected.size()) * pass.limit)) : 0;
+                if (queryMaxMatches && expected.size() > queryMaxMatches) {
+                    expected.erase(expected.begin() + queryMaxMatches, expected.end());
+                }
+                queryStop = false;
+                transactions.clear();
+                if (pass.sample) {
+                    SampleLogFile(path);
+                    transactions.clear();
+                }
+                ParseLogFile(input);
+                if (pass.gzip) {
+                    workspace.indexes.Erase(LogIndexCache::Identity(input));
+                    DeleteFileW(input.c_str());
+                }
+                const std::wstring difference = CompareRecords(expected, transactions);
+                if (!difference.empty()) {
+                    if (mismatches < SELFCHECK_REPORT_MISMATCHES) {
+                        Log(L"Auto-contrôle : écart (" + std::wstring(pass.name) + L") sur le log " + std::to_wstring(i)
+                            + L" : " + difference);
+                    }
+                    mismatches++;
+                    logMismatches++;
+                }
+            }
+            transactions.clear();
+
+            if (logMismatches) {
+                Log(L"Auto-contrôle : log conservé " + std::wstring(path));
+            } else {
+                DeleteFileW(path);
+            }
+        }
+        useDirectIO = false;
+        queryText.clear();
+        queryMaxMatches = 0;
+
+        UpdateStatus(L"Auto-contrôle : " + std::to_wstring(mismatches) + L" écarts sur " + std::to_wstring(iterations)
+                     + L" logs (" + std::to_wstring(records) + L" enregistrements, " + std::to_wstring(bytes / 1024)
+                     + L" Ko, graine " + std::to_wstring(seed) + L")");
+        return mismatches;
+    }
+
+    // Banc d'essai sur logs corrompus : pour chaque scénario, TORTURE_FILES logs
+    // totalisant sizeMb Mo sont générés puis parsés par le moteur. Mesures : débit
+    // global et du log le plus lent (blocage), entrées récupérées parmi celles
+    // écrites, faux positifs, plus longue plage franchie par resynchronisation.
+    // Rapport dans le log et, si reportPath est donné, en CSV. Renvoie 0 si tous
+    // les scénarios ont été mesurés.
+    int RunTortureBenchmark(size_t sizeMb, ULONGLONG seed, const std::wstring& reportPath) {
+        struct Scenario { const wchar_t* name; SyntheticLog::Corruption corruption; };
+        static const Scenario scenarios[] = {
+            { L"Sain", { 0, 0, 0, 0, 0, false } },
+            { L"Bits inversés 1 %", { 0.01, 0, 0, 0, 0, false } },
+            { L"Bits inversés 10 %", { 0.10, 0, 0, 0, 0, false } },
+            { L"Secteurs à zéro 1 %", { 0, 0.01, 0, 0, 0, false } },
+            { L"Secteurs à zéro 10 %", { 0, 0.10, 0, 0, 0, false } },
+            { L"Signatures répétées 1 %", { 0, 0, 0.01, 0, 0, false } },
+            { L"Signatures répétées 10 %", { 0, 0, 0.10, 0, 0, false } },
+            { L"Entrées tronquées 1 %", { 0, 0, 0, 0.01, 0, false } },
+            { L"Entrées tronquées 10 %", { 0, 0, 0, 0.10, 0, false } },
+            { L"Tailles aberrantes 1 %", { 0, 0, 0, 0, 0.01, false } },
+            { L"Tailles aberrantes 10 %", { 0, 0, 0, 0, 0.10, false } },
+            { L"Combiné 1 % + fin tronquée", { 0.01, 0.01, 0.01, 0.01, 0.01, true } },
+            { L"Combiné 10 % + fin tronquée", { 0.10, 0.10, 0.10, 0.10, 0.10, true } },
+        };
+
+        wchar_t tempDir[MAX_PATH] = {};
+        GetTempPathW(MAX_PATH, tempDir);
+        LARGE_INTEGER freq = {};
+        QueryPerformanceFrequency(&freq);
+
+        std::wofstream report;
+        if (!reportPath.empty()) {
+            report.open(reportPath, std::ios::binary);
+            if (!report.is_open()) {
+                Log(L"Banc d'essai : impossible de créer le rapport " + reportPath);
+                return 1;
+            }
+            report.imbue(std::locale(std::locale(), new std::codecvt_utf8<wchar_t>));
+            report << L'\xFEFF' << L"Scenario,Bytes,ElapsedMs,MBps,WorstFileMBps,Written,Recovered,FalsePositives,LongestSkip\n";
+        }
+
+        Log(L"Banc d'essai logs corrompus : " + std::to_wstring(sizeMb) + L" Mo par scénario, graine "
+            + std::to_wstring(seed));
+        std::mt19937_64 rng(seed);
+        useDirectIO = false;
+        keepPages = false;
+        queryText.clear();
+        queryMaxMatches = 0;
+
+        for (const Scenario& scenario : scenarios) {
+            size_t bytes = 0, written = 0, recovered = 0, falsePositives = 0, longestSkip = 0;
+            double elapsedMs = 0.0, worstMbps = 0.0;
+            for (size_t f = 0; f < TORTURE_FILES && !stopProcessing; f++) {
+                std::vector<size_t> entries, damaged;
+                const std::vector<BYTE> data = SyntheticLog::Build(rng, sizeMb * 1024 * 1024 / TORTURE_FILES,
+                                                                   scenario.corruption, entries, damaged);
+                wchar_t path[MAX_PATH] = {};
+                if (!GetTempFileNameW(tempDir, L"rtl", 0, path) || !SyntheticLog::Save(path, data)) {
+                    Log(L"Banc d'essai : impossible d'écrire le log synthétique dans " + std::wstring(tempDir));
+                    return 1;
+                }
+
+                queryStop = false;
+                transactions.clear();
+                LARGE_INTEGER start = {}, end = {};
+                QueryPerformanceCounter(&start);
+                ParseLogFile(path);
+                QueryPerformanceCounter(&end);
+                const double fileMs = (end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(freq.QuadPart);
+
+                for (const auto& tx : transactions) {
+                    if (std::binary_search(entries.begin(), entries.end(), static_cast<size_t>(tx.fileOffset))) {
+                        recovered++;
+                    } else if (tx.artifact != L"ShimCache" &&
+                               !std::binary_search(damaged.begin(), damaged.end(), static_cast<size_t>(tx.fileOffset))) {
+                        falsePositives++;
+                    }
+                }
+                if (auto index = workspace.indexes.Find(LogIndexCache::Identity(path))) {
+                    for (const ByteRange& range : index->skipped) longestSkip = std::max(longestSkip, range.second - range.first);
+                    workspace.indexes.Erase(LogIndexCache::Identity(path));
+                }
+                transactions.clear();
+                DeleteFileW(path);
+
+                const double fileMbps = fileMs > 0.0 ? data.size() / 1048576.0 / (fileMs / 1000.0) : 0.0;
+                if (f == 0 || fileMbps < worstMbps) worstMbps = fileMbps;
+                bytes += data.size();
+                written += entries.size();
+                elapsedMs += fileMs;
+            }
+
+            const double mbps = elapsedMs > 0.0 ? bytes / 1048576.0 / (elapsedMs / 1000.0) : 0.0;
+            wchar_t line[512];
+            swprintf_s(line, L"  %-30s %8.1f Mo/s (pire log %8.1f)  récupérées %zu/%zu (%.1f %%)  faux positifs %zu  "
+                             L"plus longue plage ignorée %zu octets",
+                       scenario.name, mbps, worstMbps, recovered, written,
+                       written ? 100.0 * recovered / written : 100.0, falsePositives, longestSkip);
+            Log(line);
+            if (report.is_open()) {
+                report << CsvQuote(scenario.name) << L"," << bytes << L"," << elapsedMs << L"," << mbps << L","
+                       << worstMbps << L"," << written << L"," << recovered << L"," << falsePositives << L","
+                       << longestSkip << L"\n";
+            }
+        }
+
+        UpdateStatus(L"Banc d'essai terminé : " + std::to_wstring(_countof(scenarios)) + L" scénarios");
+        return stopProcessing ? 1 : 0;
+    }
+
+    void SetListenAddress(const std::wstring& address) {
+        listenAddress = address;
+    }
+
+    // Mode bibliothèque (RTLP_LIBRARY) : appels synchrones sans fenêtre. Chaque
+    // parsing ou chargement alimente une nouvelle session de l'espace de travail.
+    struct ParseRequest {
+        std::wstring query;
+        size_t maxMatches;
+        bool stopBatch;
+        bool directIO;
+        bool keepPages;
+        std::wstring host;      // Identité de la machine pour la rareté, vide = déduite des chemins
+        std::function<bool(const TransactionEntry*, size_t)> sink;
+
+        ParseRequest() : maxMatches(0), stopBatch(false), directIO(false), keepPages(false) {}
+    };
+
+    bool ParseToSession(const std::wstring& path, const ParseRequest& request = ParseRequest()) {
+        currentLogPath = path;
+        TargetSession(true);
+        queryText = request.query;
+        std::transform(queryText.begin(), queryText.end(), queryText.begin(),
+                       [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+        queryMaxMatches = request.maxMatches;
+        queryStopBatch = request.stopBatch;
+        queryStop = false;
+        useDirectIO = request.directIO;
+        keepPages = request.keepPages;
+        recordSink = request.sink;
+        rarityHost = request.host;
+        stopProcessing = false;
+        workMode = WorkMode::Parse;
+
+        bool ok = RunWithMetrics();
+        recordSink = nullptr;
+        streamed = 0;
+        rarityHost.clear();
+        if (stopProcessing) {
+            UpdateStatus(L"Parsing annulé");
+            ok = false;
+        }
+        return ok;
+    }
+
+    // Appelable depuis un autre thread que celui du parsing
+    void Cancel() {
+        stopProcessing = true;
+    }
+
+    // Ajoute au modèle local une flotte enregistrée par une autre exécution
+    bool MergeRarity(const std::wstring& path) {
+        RarityModel other;
+        std::wstring error;
+        if (!other.Load(path, error)) {
+            UpdateStatus(error);
+            Log(error);
+            return false;
+        }
+        size_t overlap = 0;
+        workspace.rarity.Merge(other, overlap);
+        if (overlap) {
+            Log(L"Rareté : " + std::to_wstring(overlap) + L" hives présents dans les deux modèles, comptés deux fois");
+        }
+        if (!SaveRarity()) return false;
+        UpdateStatus(L"Modèle de rareté fusionné : " + path + L" - " + workspace.rarity.Summary());
+        Log(L"Fusion du modèle de rareté " + path + L" : " + workspace.rarity.Summary());
+        return true;
+    }
+
+    // Valeurs de la session active proches de l'enregistrement index (Jaccard estimé)
+    bool FindSimilar(size_t index, double threshold, std::vector<SimilarityIndex::Match>& matches) {
+        SnapshotPublisher& results = ActiveResults();
+        SnapshotPublisher::Reader snapshot(results);
+        matches.clear();
+        if (index >= snapshot->size()) {
+            UpdateStatus(L"Enregistrement inexistant : " + std::to_wstring(index));
+            return false;
+        }
+        if (!(*snapshot)[index].signature.valid) {
+            UpdateStatus(L"Pas de signature pour cet enregistrement (données trop courtes)");
+            return false;
+        }
+
+        LARGE_INTEGER freq, start, end;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&start);
+        similarity.Update(&results, *snapshot);
+        similarity.Find(*snapshot, index, threshold, matches);
+        QueryPerformanceCounter(&end);
+
+        wchar_t text[160];
+        swprintf_s(text, L"%zu valeurs similaires (J >= %.2f) parmi %zu signatures - %.1f ms", matches.size(), threshold,
+                   similarity.Signatures(), (end.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart);
+        UpdateStatus(text);
+        return true;
+    }
+
+    // Histogramme d'activité de la session active (hive vide : tous les hives)
+    bool ActivityHistogram(const std::wstring& hive, bool perMinute, std::vector<std::pair<int64_t, DWORD>>& bins) {
+        bins.clear();
+        if (workspace.sessions.empty()) return false;
+        ParseSession& session = *workspace.sessions[workspace.active];
+        SnapshotPublisher::Reader snapshot(session.results);
+        session.activity.Update(*snapshot);
+        return session.activity.Histogram(hive, perMinute, bins);
+    }
+
+    std::vector<ActivityHistograms::Burst> ActivityBursts() {
+        if (workspace.sessions.empty()) return {};
+        ParseSession& session = *workspace.sessions[workspace.active];
+        SnapshotPublisher::Reader snapshot(session.results);
+        session.activity.Update(*snapshot);
+        return session.activity.Bursts();
+    }
+
+    // Filtre interactif évalué sur la session active (expression vide : aucun enregistrement retenu)
+    bool FilterRecords(const std::wstring& expression, RecordBitmap& records) {
+        SnapshotPublisher& results = ActiveResults();
+        SnapshotPublisher::Reader snapshot(results);
+        size_t scanned = 0;
+        LARGE_INTEGER freq, start, end;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&start);
+        const bool filtering = resultFilter.Evaluate(&results, *snapshot, expression, workspace.pool, records, scanned);
+        QueryPerformanceCounter(&end);
+
+        wchar_t text[160];
+        swprintf_s(text, L"Filtre : %zu / %zu enregistrements (%zu examinés, %.1f ms)", records.Count(), snapshot->size(),
+                   scanned, (end.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart);
+        lastStatus = text;
+        return filtering;
+    }
+
+    bool LoadSession(const std::wstring& path) {
+        RecordVector records;
+        std::wstring error;
+        if (!SessionFile::Load(path, records, error)) {
+            UpdateStatus(error);
+            return false;
+        }
+        currentLogPath = path;
+        TargetSession(true);
+        workspace.rarity.Score(records.data(), records.size());
+        parseTarget->results.Replace(records);
+        UpdateStatus(L"Session chargée : " + path);
+        return true;
+    }
+
+    bool SaveSession(const std::wstring& path) {
+        SnapshotPublisher::Reader snapshot(ActiveResults());
+        std::wstring error;
+        if (!SessionFile::Save(path, *snapshot, error)) {
+            UpdateStatus(error);
+            return false;
+        }
+        UpdateStatus(L"Session enregistrée : " + path + L" (" + std::to_wstring(snapshot->size()) + L" enregistrements)");
+        return true;
+    }
+
+    bool ExportParquet(const std::wstring& path) {
+        const ULONGLONG start = GetTickCount64();
+        std::shared_ptr<const ResultColumns> table = ActiveColumns();
+        std::wstring error;
+        if (!ParquetWriter::Write(path, *table, workspace.pool, error)) {
+            UpdateStatus(error);
+            Log(error);
+            return false;
+        }
+        UpdateStatus(L"Export Parquet réussi : " + path + L" (" + std::to_wstring(table->Rows()) + L" enregistrements, "
+                     + std::to_wstring(GetTickCount64() - start) + L" ms)");
+        Log(L"Export Parquet : " + path);
+        return true;
+    }
+
+    size_t ActiveCount() {
+        SnapshotPublisher::Reader snapshot(ActiveResults());
+        return snapshot->size();
+    }
+
+    // Copie de l'instantané courant : les segments sont partagés, pas recopiés
+    ResultSnapshot ActiveSnapshot() {
+        SnapshotPublisher::Reader snapshot(ActiveResults());
+        return *snapshot;
+    }
+
+    size_t SessionCount() const { return workspace.sessions.size(); }
+    ULONGLONG BytesParsed() const { return bytesParsed; }
+    double LastElapsedMs() const { return lastElapsedMs; }
+    SIZE_T LastPeakRss() const { return lastPeakRss; }
+    size_t LastStringBytes() const { return lastStringBytes; }
+    const std::wstring& LastMetrics() const { return lastMetrics; }
+
+    std::shared_ptr<const ResultColumns> ActiveColumns() {
+        SnapshotPublisher& results = ActiveResults();
+        SnapshotPublisher::Reader snapshot(results);
+        if (!columns || columnsSource != &results || columnsVersion != snapshot->version) {
+            columns = ResultColumns::Build(*snapshot, workspace.plugins.DerivedColumns(), workspace.pool);
+            columnsSource = &results;
+            columnsVersion = snapshot->version;
+        }
+        return columns;
+    }
+
+    const std::wstring& LastStatus() const { return lastStatus; }
+    void ReportError(const std::wstring& text) { UpdateStatus(text); }
+
+private:
+    bool SaveRarity() {
+        if (!workspace.rarity.Dirty()) return true;
+        std::wstring error;
+        if (!workspace.rarity.Save(rarityPath, error)) {
+            Log(error);
+            return false;
+        }
+        return true;
+    }
+
+    // Rafales de modifications détectées dans les histogrammes de la session
+    void ReportBursts(const ActivityHistograms& activity) {
+        if (const ULONGLONG undated = activity.Undated()) {
+            Log(L"Activité : " + std::to_wstring(undated) + L" enregistrements sans heure d'événement, hors histogrammes");
+        }
+        const std::vector<ActivityHistograms::Burst> bursts = activity.Bursts();
+        if (bursts.empty()) return;
+        Log(L"Rafales d'activité : " + std::to_wstring(bursts.size()));
+        auto format = [this](int64_t seconds) {
+            ULARGE_INTEGER ticks;
+            ticks.QuadPart = static_cast<ULONGLONG>(seconds) * 10000000ULL + 116444736000000000ULL;
+            FILETIME ft = { ticks.LowPart, ticks.HighPart };
+            return FileTimeToString(ft);
+        };
+        for (size_t i = 0; i < bursts.size() && i < BURST_REPORTED; i++) {
+            const auto& burst = bursts[i];
+            wchar_t rates[96];
+            swprintf_s(rates, L" : %llu enregistrements, pic %u/s, base %.1f/s", burst.records, burst.peak, burst.baseline);
+            Log(L"  " + burst.hive + L" du " + format(burst.begin) + L" au " + format(burst.end) + rates);
+        }
+    }
+
+    void BeginMetrics() {
+        for (int i = 0; i < MEM_SUBSYSTEM_COUNT; i++) MemCounters()[i].Reset();
+        bytesParsed = 0;
+        rssSampler.Start();
+    }
+
+    // Bilan mémoire : octets et allocations par enregistrement, par sous-système.
+    // Les chaînes ne passent pas par un allocateur compté : elles sont mesurées
+    // en parcourant les enregistrements (capacité au-delà du buffer SSO).
+    void ReportMetrics(double elapsedMs) {
+        const SIZE_T peakRss = rssSampler.Stop();
+        lastElapsedMs = elapsedMs;
+        lastPeakRss = peakRss;
+
+        SnapshotPublisher::Reader snapshot(parseTarget->results);
+        const size_t ssoCapacity = std::wstring().capacity();
+        size_t stringBytes = 0, stringAllocs = 0;
+        snapshot->ForEach([&](const TransactionEntry& tx) {
+            for (const std::wstring* field : { &tx.timestamp, &tx.hiveFile, &tx.keyPath, &tx.valueName,
+                                               &tx.dataBefore, &tx.dataAfter, &tx.txID, &tx.logFile,
+                                               &tx.artifact, &tx.details }) {
+                if (field->capacity() > ssoCapacity) {
+                    stringBytes += (field->capacity() + 1) * sizeof(wchar_t);
+                    stringAllocs++;
+                }
+            }
+            for (const auto& value : tx.derived) {
+                if (value.capacity() > ssoCapacity) {
+                    stringBytes += (value.capacity() + 1) * sizeof(wchar_t);
+                    stringAllocs++;
+                }
+            }
+        });
+
+        const double records = static_cast<double>(std::max<size_t>(snapshot->size(), 1));
+        std::wstringstream ss;
+        ss << std::fixed << std::setprecision(1);
+        ss << L"=== Métriques ===\n";
+        ss << L"Enregistrements : " << snapshot->size() << L", durée : " << elapsedMs << L" ms, débit : "
+           << (elapsedMs > 0 ? bytesParsed / 1048576.0 / (elapsedMs / 1000.0) : 0.0) << L" Mo/s\n";
+        ss << L"Pic RSS : " << peakRss / 1048576.0 << L" Mo\n";
+
+        double totalBytes = 0, totalAllocs = 0;
+        for (int i = 0; i < MEM_SUBSYSTEM_COUNT; i++) {
+            double live, peak, allocs;
+            if (i == MEM_STRINGS) {
+                live = peak = static_cast<double>(stringBytes);
+                allocs = static_cast<double>(stringAllocs);
+            } else {
+                const MemCounter& c = MemCounters()[i];
+                live = static_cast<double>(c.bytes.load());
+                peak = static_cast<double>(c.peakBytes.load());
+                allocs = static_cast<double>(c.allocations.load());
+            }
+            totalBytes += live;
+            totalAllocs += allocs;
+            ss << MemSubsystemName(i) << L" : " << live / 1024.0 << L" Ko (pic " << peak / 1024.0 << L" Ko), "
+               << static_cast<ULONGLONG>(allocs) << L" allocations, "
+               << live / records << L" o/enr, " << allocs / records << L" alloc/enr\n";
         }
+        ss << L"Total : " << totalBytes / records << L" octets/enregistrement, "
+           << totalAllocs / records << L" allocations/enregistrement\n";
+        ss << L"Espace de travail : " << workspace.sessions.size() << L" sessions, "
+           << workspace.indexes.Size() << L" index, " << workspace.decoded.Size() << L" entrées décodées ("
+           << workspace.decoded.Hits() << L" réutilisations), " << workspace.pages.PageCount() << L" pages, "
+           << workspace.pool.ThreadCount() << L" threads";
+
+        lastStringBytes = stringBytes;
+        lastMetrics = ss.str();
+        Log(lastMetrics);
     }
 
     static DWORD WINAPI ParseThreadProc(LPVOID param) {
         auto* pThis = static_cast<RegistryTransactionLogParser*>(param);
+        bool ok = pThis->RunWithMetrics();
 
-        pThis->UpdateStatus(L"Parsing du fichier LOG en cours...");
-
-        if (pThis->ParseLogFile(pThis->currentLogPath)) {
+        if (ok) {
             PostMessage(pThis->hwndMain, WM_USER + 1, 0, 0); // Signal parsing terminé
+            if (pThis->workMode == WorkMode::Sample) {
+                PostMessage(pThis->hwndMain, WM_USER + 2, 0, 0); // Résumé de l'échantillon
+            }
         } else {
             pThis->UpdateStatus(L"Échec du parsing");
+            PostMessage(pThis->hwndMain, WM_USER + 1, 0, 0); // Réactive les boutons
         }
-
         return 0;
     }
 
+    bool RunWithMetrics() {
+        LARGE_INTEGER freq = {}, start = {}, end = {};
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&start);
+        BeginMetrics();
+
+        // Seul un parsing complet et sans filtre compte ses hôtes dans la flotte,
+        // chaque fichier sous l'identité de sa machine (ParseHostFile)
+        fleetCounting = workMode != WorkMode::Sample && queryText.empty() && !queryMaxMatches;
+        workspace.rarity.BeginRun();
+        bool ok = RunWorkMode();
+        PublishResults();
+        fleetCounting = false;
+        SaveRarity();
+        if (workMode != WorkMode::Sample) ReportBursts(parseTarget->activity);
+        QueryPerformanceCounter(&end);
+        ReportMetrics((end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(freq.QuadPart));
+        return ok;
+    }
+
+    bool RunWorkMode() {
+        switch (workMode) {
+            case WorkMode::Distributed:
+                UpdateStatus(L"Parsing distribué en cours...");
+                return RunCoordinator(currentLogPath);
+
+            case WorkMode::Sample:
+                UpdateStatus(L"Échantillonnage du fichier LOG en cours...");
+                return SampleLogFile(currentLogPath);
+
+            default:
+                UpdateStatus(L"Parsing du fichier LOG en cours...");
+                return ParseInput(currentLogPath);
+        }
+    }
+
     void OnLoadLog() {
         wchar_t path[MAX_PATH] = {};
         GetWindowTextW(hwndEditPath, path, MAX_PATH);
@@ -309,10 +8113,15 @@ private:
         }
 
         currentLogPath = path;
+        sampleCache.clear();
+        samplePath.clear();
         Log(L"Chargement du fichier LOG : " + currentLogPath);
         UpdateStatus(L"Fichier chargé : " + currentLogPath);
 
         EnableWindow(GetDlgItem(hwndMain, IDC_BTN_PARSE), TRUE);
+        EnableWindow(GetDlgItem(hwndMain, IDC_BTN_SAMPLE), TRUE);
+        EnableWindow(GetDlgItem(hwndMain, IDC_BTN_DISTRIBUTE), TRUE);
+        EnableWindow(GetDlgItem(hwndMain, IDC_BTN_ADDSESSION), TRUE);
     }
 
     void OnBrowse() {
@@ -333,21 +8142,137 @@ private:
         }
     }
 
-    void OnParse() {
+    // Le parsing alimente la session active (créée au besoin) ; les autres sessions
+    // et les caches de l'espace de travail sont conservés.
+    void TargetSession(bool newSession) {
+        if (newSession || workspace.sessions.empty()) {
+            workspace.sessions.push_back(std::unique_ptr<ParseSession>(new ParseSession()));
+            workspace.active = workspace.sessions.size() - 1;
+        }
+        parseTarget = workspace.sessions[workspace.active].get();
+        parseTarget->path = currentLogPath;
+        parseTarget->label = PathFindFileNameW(currentLogPath.c_str());
+
         transactions.clear();
-        ListView_DeleteAllItems(hwndList);
+        streamed = 0;
+        parseTarget->results.Reset();
+    }
+
+    void StartWorker(WorkMode mode, bool newSession = false) {
+        TargetSession(newSession);
+        RefreshSessionList();
+        PopulateListView();
+
+        useDirectIO = IsDlgButtonChecked(hwndMain, IDC_CHK_DIRECTIO) == BST_CHECKED;
+        keepPages = IsDlgButtonChecked(hwndMain, IDC_CHK_KEEPPAGES) == BST_CHECKED;
+        workMode = mode;
+
+        wchar_t queryBuf[256] = {};
+        GetWindowTextW(GetDlgItem(hwndMain, IDC_EDIT_QUERY), queryBuf, 256);
+        queryText = queryBuf;
+        std::transform(queryText.begin(), queryText.end(), queryText.begin(),
+                       [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+
+        wchar_t maxBuf[16] = {};
+        GetWindowTextW(GetDlgItem(hwndMain, IDC_EDIT_MAXMATCH), maxBuf, 16);
+        queryMaxMatches = wcstoul(maxBuf, nullptr, 10);
+        queryStopBatch = IsDlgButtonChecked(hwndMain, IDC_CHK_STOPBATCH) == BST_CHECKED;
+        queryStop = false;
 
         stopProcessing = false;
         hWorkerThread = CreateThread(nullptr, 0, ParseThreadProc, this, 0, nullptr);
 
         if (hWorkerThread) {
+            EnableWindow(GetDlgItem(hwndMain, IDC_BTN_ADDSESSION), FALSE);
             EnableWindow(GetDlgItem(hwndMain, IDC_BTN_PARSE), FALSE);
+            EnableWindow(GetDlgItem(hwndMain, IDC_BTN_SAMPLE), FALSE);
+            EnableWindow(GetDlgItem(hwndMain, IDC_BTN_DISTRIBUTE), FALSE);
             EnableWindow(GetDlgItem(hwndMain, IDC_BTN_LOAD), FALSE);
         }
     }
 
+    void OnParse() {
+        StartWorker(WorkMode::Parse);
+    }
+
+    void OnSample() {
+        StartWorker(WorkMode::Sample);
+    }
+
+    void OnAddSession() {
+        StartWorker(WorkMode::Parse, true);
+    }
+
+    void OnDistribute() {
+        StartWorker(WorkMode::Distributed);
+    }
+
+    // Double-clic : page complète de l'entrée sélectionnée
+    void OnShowPage() {
+        const LONG_PTR index = SelectedRecord();
+        SnapshotPublisher::Reader snapshot(ActiveResults());
+        if (index < 0 || static_cast<size_t>(index) >= snapshot->size()) return;
+
+        const TransactionEntry& tx = (*snapshot)[index];
+        std::vector<BYTE> page;
+        if (tx.pageId == PAGE_NONE || !workspace.pages.Get(tx.pageId, page)) {
+            MessageBoxW(hwndMain, L"Page complète non conservée (cochez \"Conserver les pages\" avant le parsing)",
+                        L"Page", MB_ICONINFORMATION);
+            return;
+        }
+
+        std::wstringstream ss;
+        ss << tx.logFile << L" @ " << tx.fileOffset << L" - " << page.size() << L" octets\n\n";
+        const size_t shown = std::min<size_t>(page.size(), 512);
+        for (size_t i = 0; i < shown; i += 16) {
+            wchar_t line[16];
+            swprintf_s(line, L"%08zX  ", i);
+            ss << line << BytesToHex(page.data() + i, std::min<size_t>(16, shown - i)) << L"\n";
+        }
+        if (shown < page.size()) ss << L"...";
+        MessageBoxW(hwndMain, ss.str().c_str(), L"Page complète", MB_ICONINFORMATION);
+    }
+
+    void OnSimilar() {
+        const LONG_PTR index = SelectedRecord();
+        if (index < 0) {
+            UpdateStatus(L"Sélectionnez un enregistrement");
+            return;
+        }
+        std::vector<SimilarityIndex::Match> matches;
+        if (!FindSimilar(static_cast<size_t>(index), SIMILARITY_DEFAULT_THRESHOLD, matches) || matches.empty()) return;
+
+        SnapshotPublisher::Reader snapshot(ActiveResults());
+        std::wstringstream ss;
+        ss << lastStatus << L"\n\n";
+        const size_t shown = std::min(matches.size(), SIMILARITY_SHOWN_MATCHES);
+        for (size_t i = 0; i < shown; i++) {
+            const TransactionEntry& tx = (*snapshot)[matches[i].index];
+            wchar_t line[32];
+            swprintf_s(line, L"%3.0f %%  #%zu  ", matches[i].similarity * 100.0, matches[i].index);
+            ss << line << tx.hiveFile << L"\\" << tx.keyPath << L"  (" << tx.logFile << L" @ " << tx.fileOffset << L")\n";
+        }
+        if (shown < matches.size()) ss << L"...";
+        MessageBoxW(hwndMain, ss.str().c_str(), L"Valeurs similaires", MB_ICONINFORMATION);
+
+        // Sélection de la plus proche dans la liste, si le filtre l'affiche
+        const int row = RecordRow(matches[0].index);
+        if (row < 0) return;
+        ListView_SetItemState(hwndList, -1, 0, LVIS_SELECTED);
+        ListView_SetItemState(hwndList, row, LVIS_SELECTED | LVIS_FOCUSED, LVIS_SELECTED | LVIS_FOCUSED);
+        ListView_EnsureVisible(hwndList, row, FALSE);
+    }
+
+    // Les instantanés publiés sont immuables : la comparaison travaille sur une
+    // copie et publie le résultat comme nouvelle génération.
     void OnCompare() {
-        if (transactions.empty()) {
+        RecordVector compared;
+        {
+            SnapshotPublisher::Reader snapshot(ActiveResults());
+            compared.reserve(snapshot->size());
+            snapshot->ForEach([&](const TransactionEntry& tx) { compared.push_back(tx); });
+        }
+        if (compared.empty()) {
             MessageBoxW(hwndMain, L"Aucune transaction à comparer. Parsez d'abord un fichier LOG.",
                        L"Information", MB_ICONINFORMATION);
             return;
@@ -357,7 +8282,7 @@ private:
 
         // Simulation de comparaison (nécessiterait API Registry pour vrai)
         int modified = 0;
-        for (auto& tx : transactions) {
+        for (auto& tx : compared) {
             // Ici on pourrait ouvrir le registry actuel et comparer
             // Pour cette démo, on marque aléatoirement certaines entrées
             if ((rand() % 3) == 0) {
@@ -367,51 +8292,84 @@ private:
             }
         }
 
+        ActiveResults().Replace(compared);
         PopulateListView();
         UpdateStatus(L"Comparaison terminée : " + std::to_wstring(modified) + L" modifications détectées");
         Log(L"Comparaison avec hive actuel : " + std::to_wstring(modified) + L" modifications");
     }
 
     void OnExport() {
-        if (transactions.empty()) {
+        SnapshotPublisher::Reader snapshot(ActiveResults());
+        if (snapshot->empty()) {
             MessageBoxW(hwndMain, L"Aucune donnée à exporter", L"Information", MB_ICONINFORMATION);
             return;
         }
 
+        // Format proposé : celui du dernier export. Nom sans extension : celle du
+        // filtre choisi (lpstrDefExt assorti) est ajoutée par la boîte de dialogue
         OPENFILENAMEW ofn = {};
-        wchar_t fileName[MAX_PATH] = L"registry_transactions.csv";
+        wchar_t fileName[MAX_PATH] = L"registry_transactions";
 
         ofn.lStructSize = sizeof(OPENFILENAMEW);
         ofn.hwndOwner = hwndMain;
-        ofn.lpstrFilter = L"CSV Files (*.csv)\0*.csv\0All Files (*.*)\0*.*\0";
+        ofn.lpstrFilter = L"CSV Files (*.csv)\0*.csv\0Parquet Files (*.parquet)\0*.parquet\0All Files (*.*)\0*.*\0";
+        ofn.nFilterIndex = exportFilterIndex;
         ofn.lpstrFile = fileName;
         ofn.nMaxFile = MAX_PATH;
         ofn.lpstrTitle = L"Exporter les transactions";
         ofn.Flags = OFN_OVERWRITEPROMPT;
-        ofn.lpstrDefExt = L"csv";
+        ofn.lpstrDefExt = exportFilterIndex == 2 ? L"parquet" : L"csv";
 
         if (GetSaveFileNameW(&ofn)) {
+            if (ofn.nFilterIndex == 1 || ofn.nFilterIndex == 2) exportFilterIndex = ofn.nFilterIndex;
+            if (ofn.nFilterIndex == 2 || PathMatchSpecW(fileName, L"*.parquet")) {
+                if (ExportParquet(fileName)) {
+                    MessageBoxW(hwndMain, L"Export Parquet réussi !", L"Succès", MB_ICONINFORMATION);
+                } else {
+                    MessageBoxW(hwndMain, lastStatus.c_str(), L"Erreur", MB_ICONERROR);
+                }
+                return;
+            }
+
             std::wofstream csv(fileName, std::ios::binary);
             if (!csv.is_open()) {
                 MessageBoxW(hwndMain, L"Impossible de créer le fichier CSV", L"Erreur", MB_ICONERROR);
                 return;
             }
 
-            // BOM UTF-8
-            unsigned char bom[] = { 0xEF, 0xBB, 0xBF };
-            csv.write(reinterpret_cast<wchar_t*>(bom), sizeof(bom) / sizeof(wchar_t));
+            // BOM UTF-8 (U+FEFF encodé par codecvt_utf8)
+            csv.imbue(std::locale(std::locale(), new std::codecvt_utf8<wchar_t>));
+            csv << L'\xFEFF';
 
-            csv << L"Timestamp,HiveFile,KeyPath,ValueName,DataBefore,DataAfter,TxID\n";
+            csv << L"Timestamp,HiveFile,KeyPath,ValueName,DataBefore,DataAfter,TxID,LogFile,FileOffset,Sequence,ContentHash,Artifact,Details,"
+                   L"Prevalence,FleetHosts";
+            const auto& derived = workspace.plugins.DerivedColumns();
+            for (const auto& column : derived) csv << L"," << CsvQuote(column);
+            csv << L"\n";
 
-            for (const auto& tx : transactions) {
-                csv << L"\"" << tx.timestamp << L"\",\""
-                    << tx.hiveFile << L"\",\""
-                    << tx.keyPath << L"\",\""
-                    << tx.valueName << L"\",\""
-                    << tx.dataBefore << L"\",\""
-                    << tx.dataAfter << L"\",\""
-                    << tx.txID << L"\"\n";
-            }
+            snapshot->ForEach([&csv, &derived](const TransactionEntry& tx) {
+                wchar_t hash[24];
+                swprintf_s(hash, L"%016llX", tx.contentHash);
+                csv << CsvQuote(tx.timestamp) << L","
+                    << CsvQuote(tx.hiveFile) << L","
+                    << CsvQuote(tx.keyPath) << L","
+                    << CsvQuote(tx.valueName) << L","
+                    << CsvQuote(tx.dataBefore) << L","
+                    << CsvQuote(tx.dataAfter) << L","
+                    << CsvQuote(tx.txID) << L","
+                    << CsvQuote(tx.logFile) << L","
+                    << tx.fileOffset << L","
+                    << tx.sequence << L","
+                    << hash << L","
+                    << CsvQuote(tx.artifact) << L","
+                    << CsvQuote(tx.details) << L","
+                    << tx.prevalence << L","
+                    << tx.fleetHosts;
+                for (size_t c = 0; c < derived.size(); c++) {
+                    csv << L"," << CsvQuote(c < tx.derived.size() ? tx.derived[c] : L"");
+                }
+                csv << L"\n";
+            });
 
             csv.close();
             UpdateStatus(L"Export réussi : " + std::wstring(fileName));
@@ -420,6 +8378,68 @@ private:
         }
     }
 
+    bool PickCsv(const wchar_t* title, wchar_t* fileName) {
+        OPENFILENAMEW ofn = {};
+        ofn.lStructSize = sizeof(OPENFILENAMEW);
+        ofn.hwndOwner = hwndMain;
+        ofn.lpstrFilter = L"CSV Files (*.csv)\0*.csv\0All Files (*.*)\0*.*\0";
+        ofn.lpstrFile = fileName;
+        ofn.nMaxFile = MAX_PATH;
+        ofn.lpstrTitle = title;
+        ofn.Flags = OFN_FILEMUSTEXIST | OFN_PATHMUSTEXIST;
+        return GetOpenFileNameW(&ofn) != FALSE;
+    }
+
+    void OnDiff() {
+        wchar_t beforePath[MAX_PATH] = L"", afterPath[MAX_PATH] = L"";
+        if (!PickCsv(L"Export de référence (avant)", beforePath)) return;
+        if (!PickCsv(L"Export à comparer (après)", afterPath)) return;
+
+        UpdateStatus(L"Diff des exports en cours...");
+        ULONGLONG start = GetTickCount64();
+
+        std::vector<ResultSetDiff::Record> before, after;
+        std::wstring error;
+        if (!ResultSetDiff::Load(beforePath, before, error) || !ResultSetDiff::Load(afterPath, after, error)) {
+            UpdateStatus(L"Erreur : " + error);
+            MessageBoxW(hwndMain, error.c_str(), L"Erreur", MB_ICONERROR);
+            return;
+        }
+
+        ResultSetDiff::Report report = ResultSetDiff::Compare(before, after);
+        ULONGLONG elapsed = GetTickCount64() - start;
+
+        wchar_t summary[512];
+        swprintf_s(summary, L"Avant : %zu enregistrements\nAprès : %zu enregistrements\n\n"
+                            L"Ajoutés : %zu\nSupprimés : %zu\nModifiés : %zu\nInchangés : %zu\n\n"
+                            L"Durée : %llu ms\n\nEnregistrer le rapport de différences ?",
+                   before.size(), after.size(), report.added, report.removed, report.modified,
+                   report.unchanged, elapsed);
+        UpdateStatus(L"Diff terminé : +" + std::to_wstring(report.added) + L" / -" + std::to_wstring(report.removed)
+                     + L" / ~" + std::to_wstring(report.modified));
+
+        if (MessageBoxW(hwndMain, summary, L"Diff des exports", MB_ICONINFORMATION | MB_YESNO) != IDYES) return;
+
+        OPENFILENAMEW ofn = {};
+        wchar_t reportPath[MAX_PATH] = L"registry_diff.csv";
+        ofn.lStructSize = sizeof(OPENFILENAMEW);
+        ofn.hwndOwner = hwndMain;
+        ofn.lpstrFilter = L"CSV Files (*.csv)\0*.csv\0All Files (*.*)\0*.*\0";
+        ofn.lpstrFile = reportPath;
+        ofn.nMaxFile = MAX_PATH;
+        ofn.lpstrTitle = L"Enregistrer le rapport de différences";
+        ofn.Flags = OFN_OVERWRITEPROMPT;
+        ofn.lpstrDefExt = L"csv";
+
+        if (GetSaveFileNameW(&ofn)) {
+            if (ResultSetDiff::WriteReport(reportPath, report)) {
+                Log(L"Rapport de diff : " + std::wstring(reportPath));
+            } else {
+                MessageBoxW(hwndMain, L"Impossible de créer le rapport", L"Erreur", MB_ICONERROR);
+            }
+        }
+    }
+
     void CreateControls(HWND hwnd) {
         // Label et Edit pour chemin
         CreateWindowW(L"STATIC", L"Fichier LOG :", WS_CHILD | WS_VISIBLE,
@@ -427,11 +8447,24 @@ private:
 
         hwndEditPath = CreateWindowExW(WS_EX_CLIENTEDGE, L"EDIT", L"",
                                        WS_CHILD | WS_VISIBLE | ES_AUTOHSCROLL,
-                                       110, MARGIN, 850, 22, hwnd, (HMENU)IDC_EDIT_PATH, nullptr, nullptr);
+                                       110, MARGIN, 560, 22, hwnd, (HMENU)IDC_EDIT_PATH, nullptr, nullptr);
 
         // Bouton Browse
         CreateWindowW(L"BUTTON", L"Parcourir...", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
-                     970, MARGIN, 120, 25, hwnd, (HMENU)IDC_BTN_BROWSE, nullptr, nullptr);
+                     680, MARGIN, 120, 25, hwnd, (HMENU)IDC_BTN_BROWSE, nullptr, nullptr);
+
+        CreateWindowW(L"BUTTON", L"Diff d'exports...", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
+                     810, MARGIN, 150, 25, hwnd, (HMENU)IDC_BTN_DIFF, nullptr, nullptr);
+
+        // Sessions de l'espace de travail
+        CreateWindowW(L"STATIC", L"Session :", WS_CHILD | WS_VISIBLE,
+                     975, MARGIN + 3, 60, 20, hwnd, nullptr, nullptr, nullptr);
+
+        CreateWindowW(L"COMBOBOX", L"", WS_CHILD | WS_VISIBLE | WS_VSCROLL | CBS_DROPDOWNLIST,
+                     1040, MARGIN, 200, 200, hwnd, (HMENU)IDC_COMBO_SESSION, nullptr, nullptr);
+
+        CreateWindowW(L"BUTTON", L"Ajouter au cas", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
+                     1250, MARGIN, 120, 25, hwnd, (HMENU)IDC_BTN_ADDSESSION, nullptr, nullptr);
 
         // Boutons principaux
         int btnY = MARGIN + 35;
@@ -450,12 +8483,58 @@ private:
                      MARGIN + (BUTTON_WIDTH + 10) * 3, btnY, BUTTON_WIDTH, BUTTON_HEIGHT, hwnd,
                      (HMENU)IDC_BTN_EXPORT, nullptr, nullptr);
 
+        CreateWindowW(L"BUTTON", L"Échantillonner", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
+                     MARGIN + (BUTTON_WIDTH + 10) * 4, btnY, BUTTON_WIDTH, BUTTON_HEIGHT, hwnd,
+                     (HMENU)IDC_BTN_SAMPLE, nullptr, nullptr);
+
+        CreateWindowW(L"BUTTON", L"E/S directes (sans cache)", WS_CHILD | WS_VISIBLE | BS_AUTOCHECKBOX,
+                     MARGIN + (BUTTON_WIDTH + 10) * 5, btnY + 5, 200, 20, hwnd,
+                     (HMENU)IDC_CHK_DIRECTIO, nullptr, nullptr);
+
+        CreateWindowW(L"BUTTON", L"Parsing distribué", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
+                     MARGIN + (BUTTON_WIDTH + 10) * 5 + 210, btnY, 150, BUTTON_HEIGHT, hwnd,
+                     (HMENU)IDC_BTN_DISTRIBUTE, nullptr, nullptr);
+
+        // Requête à arrêt anticipé
+        int queryY = btnY + BUTTON_HEIGHT + 10;
+        CreateWindowW(L"STATIC", L"Requête :", WS_CHILD | WS_VISIBLE,
+                     MARGIN, queryY + 3, 100, 20, hwnd, nullptr, nullptr, nullptr);
+
+        CreateWindowExW(WS_EX_CLIENTEDGE, L"EDIT", L"", WS_CHILD | WS_VISIBLE | ES_AUTOHSCROLL,
+                        110, queryY, 400, 22, hwnd, (HMENU)IDC_EDIT_QUERY, nullptr, nullptr);
+
+        CreateWindowW(L"STATIC", L"Max :", WS_CHILD | WS_VISIBLE,
+                     520, queryY + 3, 40, 20, hwnd, nullptr, nullptr, nullptr);
+
+        CreateWindowExW(WS_EX_CLIENTEDGE, L"EDIT", L"", WS_CHILD | WS_VISIBLE | ES_NUMBER,
+                        565, queryY, 60, 22, hwnd, (HMENU)IDC_EDIT_MAXMATCH, nullptr, nullptr);
+
+        CreateWindowW(L"BUTTON", L"Arrêter tout le lot", WS_CHILD | WS_VISIBLE | BS_AUTOCHECKBOX,
+                     640, queryY + 1, 200, 20, hwnd, (HMENU)IDC_CHK_STOPBATCH, nullptr, nullptr);
+
+        CreateWindowW(L"BUTTON", L"Conserver les pages (compressées)", WS_CHILD | WS_VISIBLE | BS_AUTOCHECKBOX,
+                     850, queryY + 1, 260, 20, hwnd, (HMENU)IDC_CHK_KEEPPAGES, nullptr, nullptr);
+
+        CreateWindowW(L"BUTTON", L"Valeurs similaires", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
+                     1120, queryY - 2, 150, 25, hwnd, (HMENU)IDC_BTN_SIMILAR, nullptr, nullptr);
+
+        // Filtre interactif des résultats affichés
+        int filterY = queryY + 30;
+        CreateWindowW(L"STATIC", L"Filtre :", WS_CHILD | WS_VISIBLE,
+                     MARGIN, filterY + 3, 100, 20, hwnd, nullptr, nullptr, nullptr);
+
+        CreateWindowExW(WS_EX_CLIENTEDGE, L"EDIT", L"", WS_CHILD | WS_VISIBLE | ES_AUTOHSCROLL,
+                        110, filterY, 515, 22, hwnd, (HMENU)IDC_EDIT_FILTER, nullptr, nullptr);
+
+        CreateWindowW(L"STATIC", L"termes combinés par & (et), | (ou), ! (sauf)", WS_CHILD | WS_VISIBLE,
+                     640, filterY + 3, 400, 20, hwnd, nullptr, nullptr, nullptr);
+
         // ListView
         hwndList = CreateWindowExW(WS_EX_CLIENTEDGE, WC_LISTVIEWW, L"",
-                                  WS_CHILD | WS_VISIBLE | LVS_REPORT | LVS_SINGLESEL,
-                                  MARGIN, btnY + BUTTON_HEIGHT + 10,
+                                  WS_CHILD | WS_VISIBLE | LVS_REPORT | LVS_SINGLESEL | LVS_OWNERDATA,
+                                  MARGIN, filterY + 30,
                                   WINDOW_WIDTH - MARGIN * 2 - 20,
-                                  WINDOW_HEIGHT - btnY - BUTTON_HEIGHT - 80,
+                                  WINDOW_HEIGHT - filterY - 110,
                                   hwnd, (HMENU)IDC_LISTVIEW, nullptr, nullptr);
 
         ListView_SetExtendedListViewStyle(hwndList, LVS_EX_FULLROWSELECT | LVS_EX_GRIDLINES | LVS_EX_DOUBLEBUFFER);
@@ -485,6 +8564,19 @@ private:
         lvc.cx = 100; lvc.pszText = const_cast<LPWSTR>(L"TxID");
         ListView_InsertColumn(hwndList, 6, &lvc);
 
+        lvc.cx = 300; lvc.pszText = const_cast<LPWSTR>(L"Artefact");
+        ListView_InsertColumn(hwndList, 7, &lvc);
+
+        lvc.cx = 90; lvc.pszText = const_cast<LPWSTR>(L"Rareté (hôtes)");
+        ListView_InsertColumn(hwndList, 8, &lvc);
+
+        // Colonnes dérivées des greffons
+        const auto& derived = workspace.plugins.DerivedColumns();
+        for (size_t c = 0; c < derived.size(); c++) {
+            lvc.cx = 150; lvc.pszText = const_cast<LPWSTR>(derived[c].c_str());
+            ListView_InsertColumn(hwndList, static_cast<int>(9 + c), &lvc);
+        }
+
         // Status bar
         hwndStatus = CreateWindowExW(0, L"STATIC", L"Prêt - Chargez un fichier .LOG/.LOG1/.LOG2",
                                      WS_CHILD | WS_VISIBLE | SS_SUNKEN | SS_LEFT,
@@ -492,7 +8584,10 @@ private:
                                      hwnd, (HMENU)IDC_STATUS, nullptr, nullptr);
 
         // État initial
+        EnableWindow(GetDlgItem(hwndMain, IDC_BTN_ADDSESSION), FALSE);
         EnableWindow(GetDlgItem(hwndMain, IDC_BTN_PARSE), FALSE);
+        EnableWindow(GetDlgItem(hwndMain, IDC_BTN_SAMPLE), FALSE);
+        EnableWindow(GetDlgItem(hwndMain, IDC_BTN_DISTRIBUTE), FALSE);
     }
 
     static LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
@@ -518,14 +8613,28 @@ private:
                         case IDC_BTN_BROWSE: pThis->OnBrowse(); break;
                         case IDC_BTN_LOAD: pThis->OnLoadLog(); break;
                         case IDC_BTN_PARSE: pThis->OnParse(); break;
+                        case IDC_BTN_SAMPLE: pThis->OnSample(); break;
                         case IDC_BTN_COMPARE: pThis->OnCompare(); break;
                         case IDC_BTN_EXPORT: pThis->OnExport(); break;
+                        case IDC_BTN_DIFF: pThis->OnDiff(); break;
+                        case IDC_BTN_DISTRIBUTE: pThis->OnDistribute(); break;
+                        case IDC_BTN_ADDSESSION: pThis->OnAddSession(); break;
+                        case IDC_BTN_SIMILAR: pThis->OnSimilar(); break;
+                        case IDC_EDIT_FILTER:
+                            if (HIWORD(wParam) == EN_CHANGE) pThis->OnFilterChanged();
+                            break;
+                        case IDC_COMBO_SESSION:
+                            if (HIWORD(wParam) == CBN_SELCHANGE) pThis->OnSessionChanged();
+                            break;
                     }
                     return 0;
 
                 case WM_USER + 1: // Parsing terminé
                     pThis->PopulateListView();
+                    EnableWindow(GetDlgItem(hwnd, IDC_BTN_ADDSESSION), TRUE);
                     EnableWindow(GetDlgItem(hwnd, IDC_BTN_PARSE), TRUE);
+                    EnableWindow(GetDlgItem(hwnd, IDC_BTN_SAMPLE), TRUE);
+                    EnableWindow(GetDlgItem(hwnd, IDC_BTN_DISTRIBUTE), TRUE);
                     EnableWindow(GetDlgItem(hwnd, IDC_BTN_LOAD), TRUE);
                     if (pThis->hWorkerThread) {
                         CloseHandle(pThis->hWorkerThread);
@@ -533,6 +8642,24 @@ private:
                     }
                     return 0;
 
+                case WM_NOTIFY: {
+                    const NMHDR* hdr = reinterpret_cast<const NMHDR*>(lParam);
+                    if (hdr->idFrom == IDC_LISTVIEW && hdr->code == LVN_GETDISPINFOW) {
+                        pThis->OnGetDispInfo(*reinterpret_cast<NMLVDISPINFOW*>(lParam));
+                    } else if (hdr->idFrom == IDC_LISTVIEW && hdr->code == NM_DBLCLK) {
+                        pThis->OnShowPage();
+                    }
+                    return 0;
+                }
+
+                case WM_USER + 3: // Nouvel instantané publié
+                    pThis->PopulateListView();
+                    return 0;
+
+                case WM_USER + 2: // Échantillonnage terminé
+                    MessageBoxW(hwnd, pThis->sampleSummary.c_str(), L"Triage rapide", MB_ICONINFORMATION);
+                    return 0;
+
                 case WM_DESTROY:
                     pThis->stopProcessing = true;
                     if (pThis->hWorkerThread) {
@@ -549,16 +8676,30 @@ private:
 
 public:
     RegistryTransactionLogParser() : hwndMain(nullptr), hwndList(nullptr), hwndStatus(nullptr),
-                                     hwndEditPath(nullptr), hWorkerThread(nullptr), stopProcessing(false) {
+                                     hwndEditPath(nullptr), parseTarget(nullptr), displayedResults(nullptr),
+                                     displayedFiltered(false), filterScanned(0), filterMs(0.0),
+                                     exportFilterIndex(1), hWorkerThread(nullptr), stopProcessing(false),
+                                     useDirectIO(false), keepPages(false), workMode(WorkMode::Parse), listenAddress(L"127.0.0.1"),
+                                     bytesParsed(0), lastElapsedMs(0), lastPeakRss(0), lastStringBytes(0),
+                                     fleetCounting(false), columnsSource(nullptr), columnsVersion(0), queryMaxMatches(0),
+                                     queryStopBatch(false), queryCutoff(0), queryStop(false) {
         // Ouverture du fichier log
-        wchar_t logPath[MAX_PATH];
-        GetModuleFileNameW(nullptr, logPath, MAX_PATH);
-        PathRemoveFileSpecW(logPath);
-        PathAppendW(logPath, L"RegistryTransactionLogParser.log");
-
-        logFile.open(logPath, std::ios::app);
+        const std::wstring moduleDir = ModuleDirectory();
+        logFile.open(moduleDir + L"\\RegistryTransactionLogParser.log", std::ios::app);
         logFile.imbue(std::locale(std::locale(), new std::codecvt_utf8<wchar_t>));
         Log(L"=== RegistryTransactionLogParser démarré ===");
+
+        // Greffons de décodage : <dossier du module>\plugins\*.dll
+        std::vector<std::wstring> pluginMessages;
+        workspace.plugins.Load(moduleDir + L"\\plugins", pluginMessages);
+        for (const auto& message : pluginMessages) Log(message);
+
+        // Modèle de rareté de la flotte, complété à chaque parsing
+        rarityPath = moduleDir + L"\\rarity.rtlr";
+        if (PathFileExistsW(rarityPath.c_str())) {
+            std::wstring error;
+            Log(workspace.rarity.Load(rarityPath, error) ? workspace.rarity.Summary() : error);
+        }
     }
 
     ~RegistryTransactionLogParser() {
@@ -609,12 +8750,504 @@ public:
     }
 };
 
+#ifdef RTLP_LIBRARY
+
+// Export Arrow d'une vue en colonnes : un tableau struct dont chaque enfant
+// référence directement les buffers de ResultColumns. Chaque tableau détient sa
+// propre référence partagée : un enfant déplacé par le consommateur survit au
+// release du parent.
+class ArrowExport {
+    struct SchemaData {
+        std::string name;
+        std::vector<ArrowSchema> children;
+        std::vector<ArrowSchema*> childPointers;
+    };
+    struct ArrayData {
+        std::shared_ptr<const ResultColumns> columns;
+        std::vector<const void*> buffers;
+        std::vector<ArrowArray> children;
+        std::vector<ArrowArray*> childPointers;
+    };
+
+    static const char* Format(ResultColumns::Type type) {
+        switch (type) {
+        case ResultColumns::Type::Utf8: return "U";     // large_utf8
+        case ResultColumns::Type::UInt32: return "I";
+        default: return "L";
+        }
+    }
+
+    static void ReleaseSchema(ArrowSchema* schema) {
+        SchemaData* data = static_cast<SchemaData*>(schema->private_data);
+        for (int64_t i = 0; i < schema->n_children; i++) {
+            if (schema->children[i]->release) schema->children[i]->release(schema->children[i]);
+        }
+        delete data;
+        schema->release = nullptr;
+    }
+
+    static void ReleaseArray(ArrowArray* array) {
+        ArrayData* data = static_cast<ArrayData*>(array->private_data);
+        for (int64_t i = 0; i < array->n_children; i++) {
+            if (array->children[i]->release) array->children[i]->release(array->children[i]);
+        }
+        delete data;
+        array->release = nullptr;
+    }
+
+public:
+    static void Export(std::shared_ptr<const ResultColumns> columns, ArrowSchema* schema, ArrowArray* array) {
+        const auto& cols = columns->Columns();
+        const int64_t rows = static_cast<int64_t>(columns->Rows());
+
+        SchemaData* schemaData = new SchemaData();
+        schemaData->children.resize(cols.size());
+        *schema = {};
+        schema->format = "+s";
+        schema->name = "";
+        schema->n_children = static_cast<int64_t>(cols.size());
+        schema->release = ReleaseSchema;
+        schema->private_data = schemaData;
+
+        ArrayData* arrayData = new ArrayData();
+        arrayData->columns = columns;
+        arrayData->children.resize(cols.size());
+        arrayData->buffers.assign(1, nullptr);      // Pas de bitmap de validité
+        *array = {};
+        array->length = rows;
+        array->n_buffers = 1;
+        array->buffers = arrayData->buffers.data();
+        array->n_children = static_cast<int64_t>(cols.size());
+        array->release = ReleaseArray;
+        array->private_data = arrayData;
+
+        for (size_t c = 0; c < cols.size(); c++) {
+            SchemaData* childSchema = new SchemaData();
+            ResultColumns::AppendUtf8(cols[c].name, childSchema->name);
+            ArrowSchema& s = schemaData->children[c];
+            s = {};
+            s.format = Format(cols[c].type);
+            s.name = childSchema->name.c_str();
+            s.release = ReleaseSchema;
+            s.private_data = childSchema;
+            schemaData->childPointers.push_back(&s);
+
+            ArrayData* childArray = new ArrayData();
+            childArray->columns = columns;
+            if (cols[c].type == ResultColumns::Type::Utf8) {
+                childArray->buffers = { nullptr, cols[c].offsets.data(), cols[c].text.data() };
+            } else {
+                childArray->buffers = { nullptr, cols[c].Values() };
+            }
+            ArrowArray& a = arrayData->children[c];
+            a = {};
+            a.length = rows;
+            a.n_buffers = static_cast<int64_t>(childArray->buffers.size());
+            a.buffers = childArray->buffers.data();
+            a.release = ReleaseArray;
+            a.private_data = childArray;
+            arrayData->childPointers.push_back(&a);
+        }
+        schema->children = schemaData->childPointers.data();
+        array->children = arrayData->childPointers.data();
+    }
+};
+
+struct rtlp_engine {
+    RegistryTransactionLogParser parser;
+    std::vector<ActivityHistograms::Burst> bursts;  // Chaînes de rtlp_bursts, valides jusqu'au prochain appel
+};
+
+struct rtlp_table {
+    std::shared_ptr<const ResultColumns> columns;
+};
+
+struct rtlp_cursor {
+    ResultSnapshot snapshot;
+    size_t position;
+};
+
+namespace {
+
+RTLP_STRING ToRtlpString(const std::wstring& value) {
+    return { value.c_str(), static_cast<uint32_t>(value.size()) };
+}
+
+void ToRtlpRecord(const TransactionEntry& tx, RTLP_RECORD& record) {
+    record.timestamp = ToRtlpString(tx.timestamp);
+    record.hiveFile = ToRtlpString(tx.hiveFile);
+    record.keyPath = ToRtlpString(tx.keyPath);
+    record.valueName = ToRtlpString(tx.valueName);
+    record.dataBefore = ToRtlpString(tx.dataBefore);
+    record.dataAfter = ToRtlpString(tx.dataAfter);
+    record.txID = ToRtlpString(tx.txID);
+    record.logFile = ToRtlpString(tx.logFile);
+    record.artifact = ToRtlpString(tx.artifact);
+    record.details = ToRtlpString(tx.details);
+    record.offset = tx.offset;
+    record.sequence = tx.sequence;
+    record.fileOffset = tx.fileOffset;
+    record.contentHash = tx.contentHash;
+    record.prevalence = tx.prevalence;
+    record.fleetHosts = tx.fleetHosts;
+}
+
+// Appelée depuis le bloc catch d'un point d'entrée : aucune exception ne traverse
+// l'ABI C, sa nature est rapportée dans rtlp_last_status quand l'engine existe
+void ReportException(rtlp_engine* engine) {
+    const wchar_t* text = L"Erreur : exception interne";
+    try {
+        throw;
+    } catch (const std::bad_alloc&) {
+        text = L"Erreur : mémoire insuffisante";
+    } catch (...) {
+    }
+    if (!engine) return;
+    try {
+        engine->parser.ReportError(text);
+    } catch (...) {
+    }
+}
+
+}
+
+RTLP_API uint32_t RTLP_CALL rtlp_api_version(void) {
+    return RTLP_API_VERSION;
+}
+
+RTLP_API rtlp_engine* RTLP_CALL rtlp_engine_create(void) {
+    try {
+        return new rtlp_engine();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+RTLP_API void RTLP_CALL rtlp_engine_destroy(rtlp_engine* engine) {
+    delete engine;
+}
+
+RTLP_API const wchar_t* RTLP_CALL rtlp_last_status(rtlp_engine* engine) {
+    return engine ? engine->parser.LastStatus().c_str() : L"";
+}
+
+RTLP_API void RTLP_CALL rtlp_cancel(rtlp_engine* engine) {
+    if (engine) engine->parser.Cancel();
+}
+
+RTLP_API int64_t RTLP_CALL rtlp_parse(rtlp_engine* engine, const wchar_t* path) {
+    return rtlp_parse_ex(engine, path, nullptr, nullptr);
+}
+
+// Champ d'une structure versionnée couvert par le structSize de l'appelant : les
+// appelants compilés contre un en-tête plus ancien passent une structure plus courte
+#define RTLP_FIELD_FITS(type, s, field) ((s)->structSize >= offsetof(type, field) + sizeof((s)->field))
+
+// Le sink reçoit les enregistrements par tranches de SINK_BATCH_RECORDS au fil du parsing
+RTLP_API int64_t RTLP_CALL rtlp_parse_ex(rtlp_engine* engine, const wchar_t* path, const RTLP_PARSE_OPTIONS* options,
+                                         const RTLP_SINK* sink) {
+    try {
+        if (!engine || !path || (options && options->structSize < sizeof(options->structSize))) return -1;
+
+        RegistryTransactionLogParser::ParseRequest request;
+        if (options) {
+            if (RTLP_FIELD_FITS(RTLP_PARSE_OPTIONS, options, flags)) {
+                request.stopBatch = (options->flags & RTLP_PARSE_STOP_BATCH) != 0;
+                request.directIO = (options->flags & RTLP_PARSE_DIRECT_IO) != 0;
+                request.keepPages = (options->flags & RTLP_PARSE_KEEP_PAGES) != 0;
+            }
+            if (RTLP_FIELD_FITS(RTLP_PARSE_OPTIONS, options, query) && options->query) request.query = options->query;
+            if (RTLP_FIELD_FITS(RTLP_PARSE_OPTIONS, options, maxMatches)) {
+                request.maxMatches = static_cast<size_t>(options->maxMatches);
+            }
+            if (RTLP_FIELD_FITS(RTLP_PARSE_OPTIONS, options, host) && options->host) request.host = options->host;
+        }
+        if (sink && sink->onRecords) {
+            const RTLP_SINK target = *sink;
+            request.sink = [target](const TransactionEntry* records, size_t count) {
+                RTLP_RECORD batch[SINK_BATCH_RECORDS];
+                for (size_t i = 0; i < count; i++) ToRtlpRecord(records[i], batch[i]);
+                return target.onRecords(target.context, batch, static_cast<uint32_t>(count)) == 0;
+            };
+        }
+        return engine->parser.ParseToSession(path, request) ? static_cast<int64_t>(engine->parser.ActiveCount()) : -1;
+    } catch (...) {
+        ReportException(engine);
+        return -1;
+    }
+}
+
+RTLP_API int64_t RTLP_CALL rtlp_session_load(rtlp_engine* engine, const wchar_t* path) {
+    try {
+        if (!engine || !path) return -1;
+        return engine->parser.LoadSession(path) ? static_cast<int64_t>(engine->parser.ActiveCount()) : -1;
+    } catch (...) {
+        ReportException(engine);
+        return -1;
+    }
+}
+
+RTLP_API int RTLP_CALL rtlp_session_save(rtlp_engine* engine, const wchar_t* path) {
+    try {
+        return engine && path && engine->parser.SaveSession(path) ? 0 : -1;
+    } catch (...) {
+        ReportException(engine);
+        return -1;
+    }
+}
+
+RTLP_API int64_t RTLP_CALL rtlp_find_similar(rtlp_engine* engine, uint64_t record, double threshold,
+                                             RTLP_SIMILAR* matches, uint32_t capacity) {
+    try {
+        std::vector<SimilarityIndex::Match> found;
+        if (!engine || !engine->parser.FindSimilar(static_cast<size_t>(record), threshold, found)) return -1;
+        for (size_t i = 0; i < found.size() && i < capacity && matches; i++) {
+            matches[i].record = found[i].index;
+            matches[i].similarity = found[i].similarity;
+        }
+        return static_cast<int64_t>(found.size());
+    } catch (...) {
+        ReportException(engine);
+        return -1;
+    }
+}
+
+RTLP_API int64_t RTLP_CALL rtlp_activity(rtlp_engine* engine, const wchar_t* hive, uint32_t resolution,
+                                         RTLP_ACTIVITY_BIN* bins, uint32_t capacity) {
+    try {
+        std::vector<std::pair<int64_t, DWORD>> histogram;
+        if (!engine || (resolution != 1 && resolution != ACTIVITY_MINUTE) ||
+            !engine->parser.ActivityHistogram(hive ? hive : L"", resolution == ACTIVITY_MINUTE, histogram)) {
+            return -1;
+        }
+        for (size_t i = 0; i < histogram.size() && i < capacity && bins; i++) {
+            bins[i].start = histogram[i].first;
+            bins[i].records = histogram[i].second;
+        }
+        return static_cast<int64_t>(histogram.size());
+    } catch (...) {
+        ReportException(engine);
+        return -1;
+    }
+}
+
+RTLP_API int64_t RTLP_CALL rtlp_bursts(rtlp_engine* engine, RTLP_BURST* bursts, uint32_t capacity) {
+    try {
+        if (!engine) return -1;
+        engine->bursts = engine->parser.ActivityBursts();
+        for (size_t i = 0; i < engine->bursts.size() && i < capacity && bursts; i++) {
+            const auto& burst = engine->bursts[i];
+            bursts[i].hive = ToRtlpString(burst.hive);
+            bursts[i].begin = burst.begin;
+            bursts[i].end = burst.end;
+            bursts[i].records = burst.records;
+            bursts[i].peak = burst.peak;
+            bursts[i].baseline = burst.baseline;
+        }
+        return static_cast<int64_t>(engine->bursts.size());
+    } catch (...) {
+        ReportException(engine);
+        return -1;
+    }
+}
+
+RTLP_API int64_t RTLP_CALL rtlp_filter(rtlp_engine* engine, const wchar_t* expression, uint64_t* records,
+                                       uint64_t capacity) {
+    try {
+        if (!engine || !expression) return -1;
+        RecordBitmap matches;
+        engine->parser.FilterRecords(expression, matches);
+        uint64_t written = 0;
+        matches.ForEachFrom(0, [&](size_t index) {
+            if (records && written < capacity) records[written++] = index;
+        });
+        return static_cast<int64_t>(matches.Count());
+    } catch (...) {
+        ReportException(engine);
+        return -1;
+    }
+}
+
+RTLP_API int RTLP_CALL rtlp_rarity_merge(rtlp_engine* engine, const wchar_t* path) {
+    try {
+        return engine && path && engine->parser.MergeRarity(path) ? 0 : -1;
+    } catch (...) {
+        ReportException(engine);
+        return -1;
+    }
+}
+
+RTLP_API int RTLP_CALL rtlp_export_parquet(rtlp_engine* engine, const wchar_t* path) {
+    try {
+        return engine && path && engine->parser.ExportParquet(path) ? 0 : -1;
+    } catch (...) {
+        ReportException(engine);
+        return -1;
+    }
+}
+
+RTLP_API int RTLP_CALL rtlp_metrics(rtlp_engine* engine, RTLP_METRICS* metrics) {
+    try {
+        if (!engine || !metrics || metrics->structSize < sizeof(metrics->structSize)) return -1;
+
+        // Seuls les champs couverts par structSize sont écrits
+        const RegistryTransactionLogParser& parser = engine->parser;
+        if (RTLP_FIELD_FITS(RTLP_METRICS, metrics, sessions)) metrics->sessions = static_cast<uint32_t>(parser.SessionCount());
+        if (RTLP_FIELD_FITS(RTLP_METRICS, metrics, records)) metrics->records = engine->parser.ActiveCount();
+        if (RTLP_FIELD_FITS(RTLP_METRICS, metrics, bytesParsed)) metrics->bytesParsed = parser.BytesParsed();
+        if (RTLP_FIELD_FITS(RTLP_METRICS, metrics, elapsedMs)) metrics->elapsedMs = parser.LastElapsedMs();
+        if (RTLP_FIELD_FITS(RTLP_METRICS, metrics, peakRss)) metrics->peakRss = parser.LastPeakRss();
+        static_assert(RTLP_MEM_SUBSYSTEMS == MEM_SUBSYSTEM_COUNT, "Sous-systèmes mémoire de l'API");
+        for (int i = 0; i < MEM_SUBSYSTEM_COUNT; i++) {
+            const MemCounter& counter = MemCounters()[i];
+            if (RTLP_FIELD_FITS(RTLP_METRICS, metrics, memoryBytes)) {
+                metrics->memoryBytes[i] = i == MEM_STRINGS ? parser.LastStringBytes()
+                                                           : static_cast<uint64_t>(counter.bytes.load());
+            }
+            if (RTLP_FIELD_FITS(RTLP_METRICS, metrics, memoryPeakBytes)) {
+                metrics->memoryPeakBytes[i] = i == MEM_STRINGS ? parser.LastStringBytes()
+                                                               : static_cast<uint64_t>(counter.peakBytes.load());
+            }
+        }
+        return 0;
+    } catch (...) {
+        ReportException(engine);
+        return -1;
+    }
+}
+
+RTLP_API const wchar_t* RTLP_CALL rtlp_metrics_text(rtlp_engine* engine) {
+    return engine ? engine->parser.LastMetrics().c_str() : L"";
+}
+
+RTLP_API rtlp_cursor* RTLP_CALL rtlp_cursor_open(rtlp_engine* engine) {
+    try {
+        if (!engine) return nullptr;
+        return new (std::nothrow) rtlp_cursor{ engine->parser.ActiveSnapshot(), 0 };
+    } catch (...) {
+        ReportException(engine);
+        return nullptr;
+    }
+}
+
+RTLP_API uint64_t RTLP_CALL rtlp_cursor_count(const rtlp_cursor* cursor) {
+    return cursor ? cursor->snapshot.size() : 0;
+}
+
+RTLP_API int RTLP_CALL rtlp_cursor_seek(rtlp_cursor* cursor, uint64_t index) {
+    if (!cursor || index > cursor->snapshot.size()) return -1;
+    cursor->position = static_cast<size_t>(index);
+    return 0;
+}
+
+RTLP_API uint32_t RTLP_CALL rtlp_cursor_next(rtlp_cursor* cursor, RTLP_RECORD* records, uint32_t capacity) {
+    try {
+        if (!cursor || !records) return 0;
+        uint32_t written = 0;
+        while (written < capacity && cursor->position < cursor->snapshot.size()) {
+            ToRtlpRecord(cursor->snapshot[cursor->position++], records[written++]);
+        }
+        return written;
+    } catch (...) {
+        return 0;
+    }
+}
+
+RTLP_API void RTLP_CALL rtlp_cursor_close(rtlp_cursor* cursor) {
+    delete cursor;
+}
+
+// Vue en colonnes de la session active ; indépendante de l'engine une fois acquise
+RTLP_API rtlp_table* RTLP_CALL rtlp_table_acquire(rtlp_engine* engine) {
+    try {
+        if (!engine) return nullptr;
+        rtlp_table* table = new (std::nothrow) rtlp_table();
+        if (table) table->columns = engine->parser.ActiveColumns();
+        return table;
+    } catch (...) {
+        ReportException(engine);
+        return nullptr;
+    }
+}
+
+RTLP_API void RTLP_CALL rtlp_table_release(rtlp_table* table) {
+    delete table;
+}
+
+RTLP_API uint64_t RTLP_CALL rtlp_table_rows(const rtlp_table* table) {
+    return table ? table->columns->Rows() : 0;
+}
+
+RTLP_API uint32_t RTLP_CALL rtlp_table_column_count(const rtlp_table* table) {
+    return table ? static_cast<uint32_t>(table->columns->Columns().size()) : 0;
+}
+
+RTLP_API int RTLP_CALL rtlp_table_column(const rtlp_table* table, uint32_t index, const wchar_t** name, uint32_t* type,
+                                         const void** values, const int64_t** offsets) {
+    if (!table || index >= table->columns->Columns().size()) return -1;
+    const ResultColumns::Column& column = table->columns->Columns()[index];
+    if (name) *name = column.name.c_str();
+    if (type) *type = static_cast<uint32_t>(column.type);
+    if (values) *values = column.Values();
+    if (offsets) *offsets = column.type == ResultColumns::Type::Utf8 ? column.offsets.data() : nullptr;
+    return 0;
+}
+
+RTLP_API int RTLP_CALL rtlp_table_export_arrow(const rtlp_table* table, ArrowSchema* schema, ArrowArray* array) {
+    try {
+        if (!table || !schema || !array) return -1;
+        ArrowExport::Export(table->columns, schema, array);
+        return 0;
+    } catch (...) {
+        return -1;
+    }
+}
+
+#else
 int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, LPWSTR, int nCmdShow) {
-    INITCOMMONCONTROLSEX icc = {};
-    icc.dwSize = sizeof(icc);
-    icc.dwICC = ICC_LISTVIEW_CLASSES;
-    InitCommonControlsEx(&icc);
+    WSADATA wsa = {};
+    WSAStartup(MAKEWORD(2, 2), &wsa);
 
+    // Ligne de commande : --worker <hôte> <port> | --listen <adresse> | --selfcheck [logs] [graine]
+    //                    | --torture [Mo] [graine] [rapport.csv] | --merge-rarity <modèle>...
+    int argc = 0;
+    LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+    std::vector<std::wstring> args;
+    if (argv) {
+        args.assign(argv, argv + argc);
+        LocalFree(argv);
+    }
+
+    int exitCode = 0;
     RegistryTransactionLogParser app;
-    return app.Run(hInstance, nCmdShow);
+    if (args.size() >= 4 && args[1] == L"--worker") {
+        exitCode = app.RunWorker(args[2], args[3]);
+    } else if (args.size() >= 2 && args[1] == L"--selfcheck") {
+        const size_t iterations = args.size() >= 3 ? wcstoul(args[2].c_str(), nullptr, 10) : SELFCHECK_DEFAULT_ITERATIONS;
+        const ULONGLONG seed = args.size() >= 4 ? wcstoull(args[3].c_str(), nullptr, 10) : GetTickCount64();
+        exitCode = app.RunSelfCheck(iterations, seed) ? 1 : 0;
+    } else if (args.size() >= 3 && args[1] == L"--merge-rarity") {
+        for (size_t i = 2; i < args.size(); i++) {
+            if (!app.MergeRarity(args[i])) exitCode = 1;
+        }
+    } else if (args.size() >= 2 && args[1] == L"--torture") {
+        const size_t sizeMb = args.size() >= 3 ? wcstoul(args[2].c_str(), nullptr, 10) : TORTURE_DEFAULT_SIZE_MB;
+        const ULONGLONG seed = args.size() >= 4 ? wcstoull(args[3].c_str(), nullptr, 10) : GetTickCount64();
+        exitCode = app.RunTortureBenchmark(std::max<size_t>(sizeMb, 1), seed, args.size() >= 5 ? args[4] : L"");
+    } else {
+        if (args.size() >= 3 && args[1] == L"--listen") {
+            app.SetListenAddress(args[2]);
+        }
+
+        INITCOMMONCONTROLSEX icc = {};
+        icc.dwSize = sizeof(icc);
+        icc.dwICC = ICC_LISTVIEW_CLASSES;
+        InitCommonControlsEx(&icc);
+
+        exitCode = app.Run(hInstance, nCmdShow);
+    }
+
+    WSACleanup();
+    return exitCode;
 }
+#endif
@@ -0,0 +1,243 @@
+/*
+ * RegistryTransactionLogParser - API C de la bibliothèque
+ *
+ * RegistryTransactionLogParser.dll est construite depuis le même source que
+ * l'exécutable, avec RTLP_LIBRARY (voir go.bat). Un engine regroupe un espace
+ * de travail (pool de threads, caches, greffons) ; chaque parsing ou chargement
+ * de session y ouvre une nouvelle session active.
+ *
+ * Mémoire :
+ * - Les tableaux d'enregistrements sont fournis par l'appelant (curseur) ; les
+ *   chaînes qu'ils désignent appartiennent à la session et restent valides
+ *   jusqu'à la fermeture du curseur, ou pendant l'appel d'un sink.
+ * - Une table (vue en colonnes) et un curseur sont indépendants de l'engine une
+ *   fois acquis et doivent être libérés par leur fonction *_release / *_close.
+ *
+ * Concurrence : un engine n'exécute qu'un appel à la fois, à l'exception de
+ * rtlp_cancel qui peut être appelé depuis n'importe quel thread.
+ *
+ * Auteur : WinToolsSuite
+ * License : MIT
+ */
+
+#ifndef REGISTRY_TRANSACTION_LOG_PARSER_API_H
+#define REGISTRY_TRANSACTION_LOG_PARSER_API_H
+
+#include <stdint.h>
+#include <wchar.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RTLP_API_VERSION 2
+
+#ifndef RTLP_CALL
+#define RTLP_CALL __cdecl
+#endif
+
+#ifdef RTLP_LIBRARY
+#define RTLP_API __declspec(dllexport)
+#else
+#define RTLP_API __declspec(dllimport)
+#endif
+
+/* Interface C d'Arrow (C Data Interface), reproduite telle que spécifiée */
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+#endif
+
+typedef struct rtlp_engine rtlp_engine;
+typedef struct rtlp_table rtlp_table;
+typedef struct rtlp_cursor rtlp_cursor;
+
+/* Chaîne UTF-16 non terminée appartenant à la session */
+typedef struct RTLP_STRING {
+    const wchar_t* data;
+    uint32_t length;
+} RTLP_STRING;
+
+typedef struct RTLP_RECORD {
+    RTLP_STRING timestamp;
+    RTLP_STRING hiveFile;
+    RTLP_STRING keyPath;
+    RTLP_STRING valueName;
+    RTLP_STRING dataBefore;
+    RTLP_STRING dataAfter;
+    RTLP_STRING txID;
+    RTLP_STRING logFile;
+    RTLP_STRING artifact;
+    RTLP_STRING details;
+    uint32_t offset;            /* Offset dans le hive */
+    uint32_t sequence;
+    uint64_t fileOffset;        /* Position de l'entrée dans le LOG */
+    uint64_t contentHash;
+    uint32_t prevalence;        /* Hôtes de la flotte portant le même n-uplet clé/valeur/données */
+    uint32_t fleetHosts;        /* Hôtes comptés dans le modèle de rareté (0 = non noté) */
+} RTLP_RECORD;
+
+/* Options de parsing (structSize renseigné par l'appelant ; une structure plus
+   courte, d'un en-tête antérieur, est acceptée et les champs absents valent 0) */
+#define RTLP_PARSE_DIRECT_IO   0x00000001u   /* Lecture FILE_FLAG_NO_BUFFERING */
+#define RTLP_PARSE_KEEP_PAGES  0x00000002u   /* Pages complètes dans le store compressé */
+#define RTLP_PARSE_STOP_BATCH  0x00000004u   /* maxMatches atteint : arrêt du lot entier */
+
+typedef struct RTLP_PARSE_OPTIONS {
+    uint32_t structSize;
+    uint32_t flags;
+    const wchar_t* query;       /* Filtre (sous-chaîne, insensible à la casse), NULL = tout */
+    uint64_t maxMatches;        /* 0 = illimité */
+    const wchar_t* host;        /* Machine d'origine pour la rareté, NULL = déduite du dossier de preuves */
+} RTLP_PARSE_OPTIONS;
+
+/* Sink : reçoit les enregistrements par tranches d'au plus 256 au fil du parsing,
+   sans attendre la fin de chaque fichier. Une valeur de retour non nulle annule
+   le parsing. */
+typedef struct RTLP_SINK {
+    void* context;
+    int (RTLP_CALL* onRecords)(void* context, const RTLP_RECORD* records, uint32_t count);
+} RTLP_SINK;
+
+#define RTLP_MEM_SUBSYSTEMS 5   /* Buffers E/S, enregistrements, chaînes, index, pages */
+
+typedef struct RTLP_METRICS {
+    uint32_t structSize;
+    uint32_t sessions;
+    uint64_t records;           /* Session active */
+    uint64_t bytesParsed;       /* Dernier parsing */
+    double elapsedMs;
+    uint64_t peakRss;
+    uint64_t memoryBytes[RTLP_MEM_SUBSYSTEMS];
+    uint64_t memoryPeakBytes[RTLP_MEM_SUBSYSTEMS];
+} RTLP_METRICS;
+
+RTLP_API uint32_t RTLP_CALL rtlp_api_version(void);
+
+/* Engine. Aucune exception ne sort de l'API : une erreur interne (mémoire
+   insuffisante comprise) est rendue comme un échec, décrit par rtlp_last_status. */
+RTLP_API rtlp_engine* RTLP_CALL rtlp_engine_create(void);
+RTLP_API void RTLP_CALL rtlp_engine_destroy(rtlp_engine* engine);
+RTLP_API const wchar_t* RTLP_CALL rtlp_last_status(rtlp_engine* engine);   /* Valide jusqu'au prochain appel */
+RTLP_API void RTLP_CALL rtlp_cancel(rtlp_engine* engine);
+
+/* Parsing d'un LOG ou d'un dossier : nombre d'enregistrements de la nouvelle
+   session, -1 en cas d'échec ou d'annulation (voir rtlp_last_status). Un hive
+   primaire (SYSTEM, SOFTWARE...) est énuméré en entier : un enregistrement
+   "<Key>" par clé et un par valeur, horodatés par la dernière écriture de la clé. */
+RTLP_API int64_t RTLP_CALL rtlp_parse(rtlp_engine* engine, const wchar_t* path);
+RTLP_API int64_t RTLP_CALL rtlp_parse_ex(rtlp_engine* engine, const wchar_t* path, const RTLP_PARSE_OPTIONS* options,
+                                         const RTLP_SINK* sink);
+
+/* Sessions enregistrées */
+RTLP_API int64_t RTLP_CALL rtlp_session_load(rtlp_engine* engine, const wchar_t* path);
+RTLP_API int RTLP_CALL rtlp_session_save(rtlp_engine* engine, const wchar_t* path);
+
+/* Valeurs similaires : enregistrements de la session active dont le Jaccard estimé
+   (signatures MinHash des données) avec record atteint threshold, du plus proche au
+   plus éloigné. Renvoie le nombre total de correspondances (au plus capacity écrites
+   dans matches), -1 si record n'existe pas ou n'a pas de signature. */
+typedef struct RTLP_SIMILAR {
+    uint64_t record;            /* Rang dans la session (rtlp_cursor_seek) */
+    double similarity;
+} RTLP_SIMILAR;
+
+RTLP_API int64_t RTLP_CALL rtlp_find_similar(rtlp_engine* engine, uint64_t record, double threshold,
+                                             RTLP_SIMILAR* matches, uint32_t capacity);
+
+/* Activité de la session active : histogramme d'un hive (NULL = tous) à la seconde
+   (resolution 1) ou à la minute (60), intervalles non vides par début croissant.
+   Seules les heures d'événement (dernière écriture de clé, ShimCache) sont
+   comptées : les entrées de log, horodatées au décodage, n'y figurent pas. Renvoie le nombre d'intervalles (au plus capacity écrits), -1 si le hive ou la
+   résolution est inconnu. */
+typedef struct RTLP_ACTIVITY_BIN {
+    int64_t start;              /* Secondes depuis 1970 (UTC) */
+    uint32_t records;
+} RTLP_ACTIVITY_BIN;
+
+RTLP_API int64_t RTLP_CALL rtlp_activity(rtlp_engine* engine, const wchar_t* hive, uint32_t resolution,
+                                         RTLP_ACTIVITY_BIN* bins, uint32_t capacity);
+
+/* Rafales de modifications de la session active (périodes anormalement denses) ;
+   hive est valide jusqu'au prochain appel de rtlp_bursts */
+typedef struct RTLP_BURST {
+    RTLP_STRING hive;
+    int64_t begin;              /* Secondes depuis 1970 (UTC), bornes incluses */
+    int64_t end;
+    uint64_t records;
+    uint32_t peak;              /* Enregistrements de la seconde la plus dense */
+    double baseline;            /* Activité habituelle (enregistrements par seconde) */
+} RTLP_BURST;
+
+RTLP_API int64_t RTLP_CALL rtlp_bursts(rtlp_engine* engine, RTLP_BURST* bursts, uint32_t capacity);
+
+/* Filtre de la session active : termes (sous-chaînes insensibles à la casse) combinés
+   par & (et), | (ou) et ! (sauf). Les bitmaps des termes sont gardés par l'engine :
+   un filtre affiné caractère par caractère n'examine que les enregistrements déjà
+   retenus. Renvoie le nombre d'enregistrements retenus ; leurs rangs croissants sont
+   écrits dans records (au plus capacity). */
+RTLP_API int64_t RTLP_CALL rtlp_filter(rtlp_engine* engine, const wchar_t* expression, uint64_t* records,
+                                       uint64_t capacity);
+
+/* Fusion d'un modèle de rareté (rarity.rtlr d'une autre exécution) dans celui de l'engine */
+RTLP_API int RTLP_CALL rtlp_rarity_merge(rtlp_engine* engine, const wchar_t* path);
+
+/* Export Parquet de la session active : 0 si réussi */
+RTLP_API int RTLP_CALL rtlp_export_parquet(rtlp_engine* engine, const wchar_t* path);
+
+/* Métriques du dernier parsing, limitées aux champs couverts par structSize ;
+   texte détaillé valide jusqu'au prochain appel */
+RTLP_API int RTLP_CALL rtlp_metrics(rtlp_engine* engine, RTLP_METRICS* metrics);
+RTLP_API const wchar_t* RTLP_CALL rtlp_metrics_text(rtlp_engine* engine);
+
+/* Parcours de la session active : records est fourni par l'appelant ; renvoie le
+   nombre d'enregistrements écrits (0 en fin de parcours) */
+RTLP_API rtlp_cursor* RTLP_CALL rtlp_cursor_open(rtlp_engine* engine);
+RTLP_API uint64_t RTLP_CALL rtlp_cursor_count(const rtlp_cursor* cursor);
+RTLP_API int RTLP_CALL rtlp_cursor_seek(rtlp_cursor* cursor, uint64_t index);
+RTLP_API uint32_t RTLP_CALL rtlp_cursor_next(rtlp_cursor* cursor, RTLP_RECORD* records, uint32_t capacity);
+RTLP_API void RTLP_CALL rtlp_cursor_close(rtlp_cursor* cursor);
+
+/* Vue en colonnes de la session active (type : 1 = UTF-8, 2 = uint32, 3 = uint64 ;
+   pour UTF-8, offsets contient lignes + 1 positions dans values) */
+RTLP_API rtlp_table* RTLP_CALL rtlp_table_acquire(rtlp_engine* engine);
+RTLP_API void RTLP_CALL rtlp_table_release(rtlp_table* table);
+RTLP_API uint64_t RTLP_CALL rtlp_table_rows(const rtlp_table* table);
+RTLP_API uint32_t RTLP_CALL rtlp_table_column_count(const rtlp_table* table);
+RTLP_API int RTLP_CALL rtlp_table_column(const rtlp_table* table, uint32_t index, const wchar_t** name, uint32_t* type,
+                                         const void** values, const int64_t** offsets);
+RTLP_API int RTLP_CALL rtlp_table_export_arrow(const rtlp_table* table, struct ArrowSchema* schema,
+                                               struct ArrowArray* array);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REGISTRY_TRANSACTION_LOG_PARSER_API_H */
@@ -0,0 +1,98 @@
+/*
+ * RegistryTransactionLogParser - ABI des greffons de décodage
+ *
+ * Un greffon est une DLL placée dans le dossier "plugins" de l'exécutable et
+ * exportant RtlpPluginInit. Il reçoit les enregistrements par lots, en colonnes
+ * (un tableau par champ, sans recopie des chaînes) avec la page de log de chaque
+ * ligne, et peut renseigner ses propres colonnes dérivées. Les lots sont traités
+ * sur le pool de threads du parseur.
+ *
+ * Règles de compatibilité :
+ * - RTLP_PLUGIN_ABI_VERSION change à chaque rupture ; l'hôte refuse un greffon
+ *   d'une autre version.
+ * - Les structures ne font que grandir : les nouveaux champs sont ajoutés en fin
+ *   et structSize indique la taille connue de l'émetteur.
+ * - Interface C uniquement (pas d'exception ni d'objet C++ à la frontière).
+ *
+ * Auteur : WinToolsSuite
+ * License : MIT
+ */
+
+#ifndef REGISTRY_TRANSACTION_LOG_PARSER_PLUGIN_H
+#define REGISTRY_TRANSACTION_LOG_PARSER_PLUGIN_H
+
+#include <stdint.h>
+#include <wchar.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RTLP_PLUGIN_ABI_VERSION 1
+#ifndef RTLP_CALL
+#define RTLP_CALL __cdecl
+#endif
+#define RTLP_PLUGIN_INIT_EXPORT "RtlpPluginInit"
+
+/* processBatch peut être appelé simultanément depuis plusieurs threads */
+#define RTLP_PLUGIN_THREAD_SAFE 0x00000001u
+
+/* Colonne de chaînes UTF-16 : data[i] pointe sur length[i] caractères (non terminés) */
+typedef struct RTLP_STRING_COLUMN {
+    const wchar_t* const* data;
+    const uint32_t* length;
+} RTLP_STRING_COLUMN;
+
+/* Page de hive portée par l'entrée de log de la ligne */
+typedef struct RTLP_PAGE_SPAN {
+    const uint8_t* data;
+    uint32_t size;
+    uint32_t hiveOffset;        /* Offset relatif au début des hbins */
+} RTLP_PAGE_SPAN;
+
+/* Lot d'enregistrements. Tous les pointeurs ne sont valides que pendant l'appel. */
+typedef struct RTLP_BATCH {
+    uint32_t structSize;
+    uint32_t rows;
+    const wchar_t* hive;        /* Identique pour tout le lot */
+    const wchar_t* logFile;
+
+    RTLP_STRING_COLUMN keyPath;
+    RTLP_STRING_COLUMN valueName;
+    RTLP_STRING_COLUMN dataAfter;
+    RTLP_STRING_COLUMN artifact;
+    RTLP_STRING_COLUMN details;
+    const uint64_t* fileOffset;
+    const uint32_t* sequence;
+    const uint64_t* contentHash;
+    const RTLP_PAGE_SPAN* pages;
+
+    /* Renseigne la colonne dérivée column (rang dans derivedColumns) de la ligne row ;
+       le texte est recopié par l'hôte. */
+    void* sink;
+    void (RTLP_CALL* setDerived)(void* sink, uint32_t column, uint32_t row, const wchar_t* text, uint32_t length);
+} RTLP_BATCH;
+
+/* Description remplie par le greffon dans RtlpPluginInit */
+typedef struct RTLP_PLUGIN_INFO {
+    uint32_t structSize;        /* Renseigné par l'hôte */
+    uint32_t abiVersion;        /* RTLP_PLUGIN_ABI_VERSION du greffon */
+    const wchar_t* name;
+    uint32_t flags;             /* RTLP_PLUGIN_THREAD_SAFE */
+    uint32_t derivedColumnCount;
+    const wchar_t* const* derivedColumns;   /* Noms, valides jusqu'à shutdown */
+    void* state;
+
+    /* 0 si le lot est traité, autre valeur en cas d'échec (compté par l'hôte) */
+    int (RTLP_CALL* processBatch)(void* state, const RTLP_BATCH* batch);
+    void (RTLP_CALL* shutdown)(void* state);
+} RTLP_PLUGIN_INFO;
+
+/* Point d'entrée exporté : 0 si le greffon accepte la version de l'hôte */
+typedef int (RTLP_CALL* RTLP_PLUGIN_INIT)(uint32_t hostAbiVersion, RTLP_PLUGIN_INFO* info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REGISTRY_TRANSACTION_LOG_PARSER_PLUGIN_H */
@@ -10,15 +10,26 @@ cl.exe /nologo /W4 /EHsc /O2 /DUNICODE /D_UNICODE ^
     /Fe:RegistryTransactionLogParser.exe ^
     RegistryTransactionLogParser.cpp ^
     /link ^
-    comctl32.lib shlwapi.lib advapi32.lib user32.lib gdi32.lib shell32.lib
+    comctl32.lib shlwapi.lib advapi32.lib user32.lib gdi32.lib shell32.lib ws2_32.lib psapi.lib
+
+REM Library build (C API, Python bindings): same source with RTLP_LIBRARY
+if %ERRORLEVEL% EQU 0 (
+    cl.exe /nologo /W4 /EHsc /O2 /LD /DUNICODE /D_UNICODE /DRTLP_LIBRARY ^
+        /Fe:RegistryTransactionLogParser.dll /Fo:RegistryTransactionLogParserLib.obj ^
+        RegistryTransactionLogParser.cpp ^
+        /link ^
+        comctl32.lib shlwapi.lib advapi32.lib user32.lib gdi32.lib shell32.lib ws2_32.lib psapi.lib
+)
 
 if %ERRORLEVEL% EQU 0 (
     echo.
     echo ========================================
     echo Build successful!
     echo Executable: RegistryTransactionLogParser.exe
+    echo Library: RegistryTransactionLogParser.dll
     echo ========================================
     if exist RegistryTransactionLogParser.obj del RegistryTransactionLogParser.obj
+    if exist RegistryTransactionLogParserLib.obj del RegistryTransactionLogParserLib.obj
 ) else (
     echo.
     echo ========================================
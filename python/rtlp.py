@@ -0,0 +1,259 @@
+"""Liaisons Python de RegistryTransactionLogParser (mode bibliothèque).
+
+La DLL est construite depuis le même source avec RTLP_LIBRARY (voir go.bat).
+Les colonnes d'une session sont exposées sans copie :
+
+- Table.to_arrow() : pyarrow.RecordBatch importé par l'interface C d'Arrow ;
+- Table.to_pandas() : DataFrame à colonnes Arrow (pandas >= 2.0) ;
+- Table.column(nom) : memoryview (protocole buffer) sur une colonne entière,
+  utilisable par numpy.frombuffer ; (offsets, octets UTF-8) pour une colonne texte.
+
+Exemple :
+    with rtlp.Engine() as engine:
+        engine.parse(r"C:\\Windows\\System32\\config\\SYSTEM.LOG1")
+        df = engine.table().to_pandas()
+"""
+
+import ctypes
+import os
+
+UTF8, UINT32, UINT64 = 1, 2, 3
+_ITEM = {UINT32: (ctypes.c_uint32, "I"), UINT64: (ctypes.c_uint64, "Q")}
+
+
+class RtlpError(RuntimeError):
+    pass
+
+
+class _ArrowSchema(ctypes.Structure):
+    pass
+
+
+_ArrowSchema._fields_ = [
+    ("format", ctypes.c_char_p),
+    ("name", ctypes.c_char_p),
+    ("metadata", ctypes.c_char_p),
+    ("flags", ctypes.c_int64),
+    ("n_children", ctypes.c_int64),
+    ("children", ctypes.POINTER(ctypes.POINTER(_ArrowSchema))),
+    ("dictionary", ctypes.POINTER(_ArrowSchema)),
+    ("release", ctypes.c_void_p),
+    ("private_data", ctypes.c_void_p),
+]
+
+
+class _ArrowArray(ctypes.Structure):
+    pass
+
+
+_ArrowArray._fields_ = [
+    ("length", ctypes.c_int64),
+    ("null_count", ctypes.c_int64),
+    ("offset", ctypes.c_int64),
+    ("n_buffers", ctypes.c_int64),
+    ("n_children", ctypes.c_int64),
+    ("buffers", ctypes.POINTER(ctypes.c_void_p)),
+    ("children", ctypes.POINTER(ctypes.POINTER(_ArrowArray))),
+    ("dictionary", ctypes.POINTER(_ArrowArray)),
+    ("release", ctypes.c_void_p),
+    ("private_data", ctypes.c_void_p),
+]
+
+
+class _Similar(ctypes.Structure):
+    _fields_ = [("record", ctypes.c_uint64), ("similarity", ctypes.c_double)]
+
+
+class _ActivityBin(ctypes.Structure):
+    _fields_ = [("start", ctypes.c_int64), ("records", ctypes.c_uint32)]
+
+
+class _String(ctypes.Structure):
+    _fields_ = [("data", ctypes.POINTER(ctypes.c_wchar)), ("length", ctypes.c_uint32)]
+
+
+class _Burst(ctypes.Structure):
+    _fields_ = [("hive", _String), ("begin", ctypes.c_int64), ("end", ctypes.c_int64), ("records", ctypes.c_uint64),
+                ("peak", ctypes.c_uint32), ("baseline", ctypes.c_double)]
+
+
+def _load(path=None):
+    if path is None:
+        path = os.environ.get("RTLP_LIBRARY_PATH") or os.path.join(
+            os.path.dirname(os.path.abspath(__file__)), os.pardir, "RegistryTransactionLogParser.dll")
+    lib = ctypes.CDLL(os.path.abspath(path))
+
+    def bind(name, restype, *argtypes):
+        fn = getattr(lib, name)
+        fn.restype = restype
+        fn.argtypes = argtypes
+
+    p = ctypes.c_void_p
+    bind("rtlp_engine_create", p)
+    bind("rtlp_engine_destroy", None, p)
+    bind("rtlp_parse", ctypes.c_int64, p, ctypes.c_wchar_p)
+    bind("rtlp_session_load", ctypes.c_int64, p, ctypes.c_wchar_p)
+    bind("rtlp_session_save", ctypes.c_int, p, ctypes.c_wchar_p)
+    bind("rtlp_export_parquet", ctypes.c_int, p, ctypes.c_wchar_p)
+    bind("rtlp_rarity_merge", ctypes.c_int, p, ctypes.c_wchar_p)
+    bind("rtlp_activity", ctypes.c_int64, p, ctypes.c_wchar_p, ctypes.c_uint32, ctypes.POINTER(_ActivityBin),
+         ctypes.c_uint32)
+    bind("rtlp_bursts", ctypes.c_int64, p, ctypes.POINTER(_Burst), ctypes.c_uint32)
+    bind("rtlp_filter", ctypes.c_int64, p, ctypes.c_wchar_p, ctypes.POINTER(ctypes.c_uint64), ctypes.c_uint64)
+    bind("rtlp_find_similar", ctypes.c_int64, p, ctypes.c_uint64, ctypes.c_double, ctypes.POINTER(_Similar),
+         ctypes.c_uint32)
+    bind("rtlp_last_status", ctypes.c_wchar_p, p)
+    bind("rtlp_table_acquire", p, p)
+    bind("rtlp_table_release", None, p)
+    bind("rtlp_table_rows", ctypes.c_uint64, p)
+    bind("rtlp_table_column_count", ctypes.c_uint32, p)
+    bind("rtlp_table_column", ctypes.c_int, p, ctypes.c_uint32, ctypes.POINTER(ctypes.c_wchar_p),
+         ctypes.POINTER(ctypes.c_uint32), ctypes.POINTER(p), ctypes.POINTER(ctypes.POINTER(ctypes.c_int64)))
+    bind("rtlp_table_export_arrow", ctypes.c_int, p, ctypes.POINTER(_ArrowSchema), ctypes.POINTER(_ArrowArray))
+    return lib
+
+
+class Table:
+    """Vue en colonnes figée d'une session ; reste valide après fermeture de l'engine."""
+
+    def __init__(self, lib, handle):
+        self._lib = lib
+        self._handle = handle
+        self.rows = lib.rtlp_table_rows(handle)
+        self._columns = {}
+        for index in range(lib.rtlp_table_column_count(handle)):
+            name = ctypes.c_wchar_p()
+            kind = ctypes.c_uint32()
+            values = ctypes.c_void_p()
+            offsets = ctypes.POINTER(ctypes.c_int64)()
+            lib.rtlp_table_column(handle, index, ctypes.byref(name), ctypes.byref(kind), ctypes.byref(values),
+                                  ctypes.byref(offsets))
+            self._columns[name.value] = (kind.value, values.value, offsets)
+
+    def __del__(self):
+        if getattr(self, "_handle", None):
+            self._lib.rtlp_table_release(self._handle)
+            self._handle = None
+
+    def __len__(self):
+        return self.rows
+
+    @property
+    def column_names(self):
+        return list(self._columns)
+
+    def _view(self, ctype, fmt, address, count):
+        if not count or not address:
+            return memoryview(b"").cast(fmt)
+        array = (ctype * count).from_address(address)
+        array._owner = self     # La table (et ses buffers) vit autant que la vue
+        return memoryview(array).cast("B").cast(fmt)
+
+    def column(self, name):
+        """memoryview d'une colonne entière, ou (offsets, octets UTF-8) d'une colonne texte."""
+        kind, values, offsets = self._columns[name]
+        if kind != UTF8:
+            ctype, fmt = _ITEM[kind]
+            return self._view(ctype, fmt, values, self.rows)
+        offsets_view = self._view(ctypes.c_int64, "q", ctypes.cast(offsets, ctypes.c_void_p).value, self.rows + 1)
+        return offsets_view, self._view(ctypes.c_uint8, "B", values, offsets_view[-1] if self.rows else 0)
+
+    def to_arrow(self):
+        import pyarrow
+
+        schema = _ArrowSchema()
+        array = _ArrowArray()
+        if self._lib.rtlp_table_export_arrow(self._handle, ctypes.byref(schema), ctypes.byref(array)) != 0:
+            raise RtlpError("export Arrow impossible")
+        # pyarrow prend possession des deux structures et appellera leur release
+        return pyarrow.RecordBatch._import_from_c(ctypes.addressof(array), ctypes.addressof(schema))
+
+    def to_pandas(self):
+        import pandas
+
+        return self.to_arrow().to_pandas(types_mapper=pandas.ArrowDtype)
+
+
+class Engine:
+    """Moteur de parsing ; chaque parse() ou load_session() ouvre une nouvelle session active."""
+
+    def __init__(self, library=None):
+        self._handle = None
+        self._lib = _load(library)
+        self._handle = self._lib.rtlp_engine_create()
+        if not self._handle:
+            raise RtlpError("création de l'engine impossible")
+
+    def close(self):
+        if getattr(self, "_handle", None):
+            self._lib.rtlp_engine_destroy(self._handle)
+            self._handle = None
+
+    __del__ = close
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    @property
+    def status(self):
+        return self._lib.rtlp_last_status(self._handle)
+
+    def _check(self, result):
+        if result < 0:
+            raise RtlpError(self.status)
+        return result
+
+    def parse(self, path):
+        """Parse un LOG, un dossier de LOG ou un hive primaire ; renvoie le nombre d'enregistrements."""
+        return self._check(self._lib.rtlp_parse(self._handle, os.fspath(path)))
+
+    def load_session(self, path):
+        return self._check(self._lib.rtlp_session_load(self._handle, os.fspath(path)))
+
+    def save_session(self, path):
+        self._check(self._lib.rtlp_session_save(self._handle, os.fspath(path)))
+
+    def export_parquet(self, path):
+        self._check(self._lib.rtlp_export_parquet(self._handle, os.fspath(path)))
+
+    def merge_rarity(self, path):
+        """Fusionne le modèle de rareté d'une autre exécution (rarity.rtlr)."""
+        self._check(self._lib.rtlp_rarity_merge(self._handle, os.fspath(path)))
+
+    def similar(self, record, threshold=0.5, limit=100):
+        """Valeurs proches de l'enregistrement record : liste de (rang, Jaccard estimé)."""
+        matches = (_Similar * limit)()
+        found = self._check(self._lib.rtlp_find_similar(self._handle, record, threshold, matches, limit))
+        return [(m.record, m.similarity) for m in matches[:min(found, limit)]]
+
+    def filter(self, expression):
+        """Rangs des enregistrements retenus par un filtre ("run & !microsoft | services") :
+        memoryview d'entiers 64 bits, utilisable par numpy.frombuffer."""
+        count = self._check(self._lib.rtlp_filter(self._handle, expression, None, 0))
+        records = (ctypes.c_uint64 * count)()
+        count = min(count, self._check(self._lib.rtlp_filter(self._handle, expression, records, count)))
+        return memoryview(records).cast("B").cast("Q")[:count]
+
+    def activity(self, hive=None, resolution=60):
+        """Histogramme d'activité : liste de (début en secondes UTC, enregistrements)."""
+        count = self._check(self._lib.rtlp_activity(self._handle, hive, resolution, None, 0))
+        bins = (_ActivityBin * count)()
+        count = min(count, self._check(self._lib.rtlp_activity(self._handle, hive, resolution, bins, count)))
+        return [(b.start, b.records) for b in bins[:count]]
+
+    def bursts(self):
+        """Rafales de modifications : dictionnaires hive, begin, end (secondes UTC), records, peak, baseline."""
+        count = self._check(self._lib.rtlp_bursts(self._handle, None, 0))
+        bursts = (_Burst * count)()
+        count = min(count, self._check(self._lib.rtlp_bursts(self._handle, bursts, count)))
+        return [{"hive": ctypes.wstring_at(b.hive.data, b.hive.length), "begin": b.begin, "end": b.end,
+                 "records": b.records, "peak": b.peak, "baseline": b.baseline} for b in bursts[:count]]
+
+    def table(self):
+        handle = self._lib.rtlp_table_acquire(self._handle)
+        if not handle:
+            raise RtlpError("vue en colonnes indisponible")
+        return Table(self._lib, handle)